@@ -18,10 +18,13 @@
  */
 
 #include <config.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_histogram.h>
 
 #include "find.c"
+#include "findarray.c"
 
 int
 gsl_histogram_increment (gsl_histogram * h, double x)
@@ -53,3 +56,63 @@ gsl_histogram_accumulate (gsl_histogram * h, double x, double weight)
 
   return GSL_SUCCESS;
 }
+
+int
+gsl_histogram_increment_array (gsl_histogram * h, const double x[],
+                               const size_t stride, const size_t n)
+{
+  const size_t nbins = h->n;
+  double *bin = h->bin;
+  find_table t;
+  int status = GSL_SUCCESS;
+  size_t k;
+
+  find_table_init (&t, nbins, h->range);
+
+  for (k = 0; k < n; k++)
+    {
+      const size_t i = find_table_bin (&t, x[k * stride]);
+
+      if (i < nbins)
+        {
+          bin[i] += 1.0;
+        }
+      else
+        {
+          status = GSL_EDOM;
+        }
+    }
+
+  return status;
+}
+
+int
+gsl_histogram_accumulate_array (gsl_histogram * h,
+                                const double x[], const size_t xstride,
+                                const double w[], const size_t wstride,
+                                const size_t n)
+{
+  const size_t nbins = h->n;
+  double *bin = h->bin;
+  find_table t;
+  int status = GSL_SUCCESS;
+  size_t k;
+
+  find_table_init (&t, nbins, h->range);
+
+  for (k = 0; k < n; k++)
+    {
+      const size_t i = find_table_bin (&t, x[k * xstride]);
+
+      if (i < nbins)
+        {
+          bin[i] += w[k * wstride];
+        }
+      else
+        {
+          status = GSL_EDOM;
+        }
+    }
+
+  return status;
+}
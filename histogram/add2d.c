@@ -19,11 +19,14 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_histogram.h>
 #include <gsl/gsl_histogram2d.h>
 
 #include "find2d.c"
+#include "findarray.c"
 
 int
 gsl_histogram2d_increment (gsl_histogram2d * h, double x, double y)
@@ -64,3 +67,72 @@ gsl_histogram2d_accumulate (gsl_histogram2d * h,
 
   return GSL_SUCCESS;
 }
+
+int
+gsl_histogram2d_increment_array (gsl_histogram2d * h,
+                                 const double x[], const size_t xstride,
+                                 const double y[], const size_t ystride,
+                                 const size_t n)
+{
+  const size_t nx = h->nx;
+  const size_t ny = h->ny;
+  double *bin = h->bin;
+  find_table tx, ty;
+  int status = GSL_SUCCESS;
+  size_t k;
+
+  find_table_init (&tx, nx, h->xrange);
+  find_table_init (&ty, ny, h->yrange);
+
+  for (k = 0; k < n; k++)
+    {
+      const size_t i = find_table_bin (&tx, x[k * xstride]);
+      const size_t j = find_table_bin (&ty, y[k * ystride]);
+
+      if (i < nx && j < ny)
+        {
+          bin[i * ny + j] += 1.0;
+        }
+      else
+        {
+          status = GSL_EDOM;
+        }
+    }
+
+  return status;
+}
+
+int
+gsl_histogram2d_accumulate_array (gsl_histogram2d * h,
+                                  const double x[], const size_t xstride,
+                                  const double y[], const size_t ystride,
+                                  const double w[], const size_t wstride,
+                                  const size_t n)
+{
+  const size_t nx = h->nx;
+  const size_t ny = h->ny;
+  double *bin = h->bin;
+  find_table tx, ty;
+  int status = GSL_SUCCESS;
+  size_t k;
+
+  find_table_init (&tx, nx, h->xrange);
+  find_table_init (&ty, ny, h->yrange);
+
+  for (k = 0; k < n; k++)
+    {
+      const size_t i = find_table_bin (&tx, x[k * xstride]);
+      const size_t j = find_table_bin (&ty, y[k * ystride]);
+
+      if (i < nx && j < ny)
+        {
+          bin[i * ny + j] += w[k * wstride];
+        }
+      else
+        {
+          status = GSL_EDOM;
+        }
+    }
+
+  return status;
+}
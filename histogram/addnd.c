@@ -0,0 +1,220 @@
+/* histogram/addnd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogramnd.h>
+
+#include "find.c"
+
+/* The hash table of a sparse histogram uses linear probing and is
+   doubled in size whenever it becomes half full, so that a lookup
+   examines about two slots on average. Empty slots have the key
+   nbins, which is not a valid bin index. */
+
+static size_t hash_index (size_t k);
+static size_t sparse_lookup (const gsl_histogramnd * h, const size_t k);
+static int sparse_grow (gsl_histogramnd * h);
+static int find_index (const gsl_histogramnd * h, const double x[],
+                       size_t * k);
+
+static size_t
+hash_index (size_t k)
+{
+  k ^= (k >> 16) >> 16;         /* fold the upper half of a 64-bit index */
+  k *= 2654435769UL;
+  k ^= k >> 16;
+  return k;
+}
+
+/* return the slot holding bin k, or the empty slot where it would be
+   inserted */
+
+static size_t
+sparse_lookup (const gsl_histogramnd * h, const size_t k)
+{
+  const size_t mask = h->tsize - 1;
+  size_t s = hash_index (k) & mask;
+
+  while (h->key[s] != k && h->key[s] != h->nbins)
+    {
+      s = (s + 1) & mask;
+    }
+
+  return s;
+}
+
+static int
+sparse_grow (gsl_histogramnd * h)
+{
+  const size_t tsize = h->tsize;
+  size_t *key = h->key;
+  double *val = h->val;
+  size_t i;
+
+  h->key = (size_t *) malloc (2 * tsize * sizeof (size_t));
+  h->val = (double *) malloc (2 * tsize * sizeof (double));
+
+  if (h->key == 0 || h->val == 0)
+    {
+      free (h->key);
+      free (h->val);
+      h->key = key;
+      h->val = val;
+      GSL_ERROR ("failed to grow histogram hash table", GSL_ENOMEM);
+    }
+
+  h->tsize = 2 * tsize;
+
+  for (i = 0; i < h->tsize; i++)
+    {
+      h->key[i] = h->nbins;
+      h->val[i] = 0;
+    }
+
+  for (i = 0; i < tsize; i++)
+    {
+      if (key[i] != h->nbins)
+        {
+          size_t s = sparse_lookup (h, key[i]);
+          h->key[s] = key[i];
+          h->val[s] = val[i];
+        }
+    }
+
+  free (key);
+  free (val);
+
+  return GSL_SUCCESS;
+}
+
+static int
+find_index (const gsl_histogramnd * h, const double x[], size_t * k)
+{
+  size_t d, i;
+
+  *k = 0;
+
+  for (d = 0; d < h->ndim; d++)
+    {
+      int status = find (h->n[d], h->range[d], x[d], &i);
+
+      if (status)
+        {
+          return status;
+        }
+
+      *k += i * h->stride[d];
+    }
+
+  return 0;
+}
+
+int
+gsl_histogramnd_increment (gsl_histogramnd * h, const double x[])
+{
+  int status = gsl_histogramnd_accumulate (h, x, 1.0);
+  return status;
+}
+
+int
+gsl_histogramnd_accumulate (gsl_histogramnd * h, const double x[],
+                            const double weight)
+{
+  size_t k, s;
+
+  if (find_index (h, x, &k))
+    {
+      return GSL_EDOM;
+    }
+
+  if (h->bin != 0)
+    {
+      h->bin[k] += weight;
+      return GSL_SUCCESS;
+    }
+
+  s = sparse_lookup (h, k);
+
+  if (h->key[s] != k)
+    {
+      if (2 * (h->nz + 1) > h->tsize)
+        {
+          int status = sparse_grow (h);
+
+          if (status)
+            {
+              return status;
+            }
+
+          s = sparse_lookup (h, k);
+        }
+
+      h->key[s] = k;
+      h->nz++;
+    }
+
+  h->val[s] += weight;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_histogramnd_find (const gsl_histogramnd * h, const double x[],
+                      size_t idx[])
+{
+  size_t d;
+
+  for (d = 0; d < h->ndim; d++)
+    {
+      int status = find (h->n[d], h->range[d], x[d], &idx[d]);
+
+      if (status)
+        {
+          GSL_ERROR ("x not found in range of h", GSL_EDOM);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+double
+gsl_histogramnd_get (const gsl_histogramnd * h, const size_t idx[])
+{
+  size_t d, k = 0, s;
+
+  for (d = 0; d < h->ndim; d++)
+    {
+      if (idx[d] >= h->n[d])
+        {
+          GSL_ERROR_VAL ("index lies outside valid range of 0 .. n - 1",
+                         GSL_EDOM, 0);
+        }
+
+      k += idx[d] * h->stride[d];
+    }
+
+  if (h->bin != 0)
+    {
+      return h->bin[k];
+    }
+
+  s = sparse_lookup (h, k);
+
+  return h->val[s];
+}
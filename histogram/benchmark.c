@@ -0,0 +1,206 @@
+/* histogram/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Rate at which histograms are filled from uniform random values, one
+   value at a time with gsl_histogram_increment and in bulk with
+   gsl_histogram_increment_array, for uniform and non-uniform
+   (logarithmic) ranges and for one and two dimensions.
+
+   Then the time to combine NS per-thread histograms, summing the
+   shards of a gsl_histogram_shards set against calling
+   gsl_histogram_add on NS separate histograms. */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_histogram.h>
+#include <gsl/gsl_histogram2d.h>
+
+#define N 10000000
+
+#define NS 8
+
+static double
+seconds (clock_t start, clock_t end)
+{
+  return (end - start) / (double) CLOCKS_PER_SEC;
+}
+
+static void
+set_log_ranges (double range[], const size_t n, const double xmin,
+                const double xmax)
+{
+  size_t i;
+
+  for (i = 0; i <= n; i++)
+    range[i] = xmin * pow (xmax / xmin, (double) i / (double) n);
+
+  range[0] = xmin;
+  range[n] = xmax;
+}
+
+static void
+time_1d (const double x[], const size_t nbins, const int uniform)
+{
+  gsl_histogram *h = gsl_histogram_calloc_uniform (nbins, 1.0, 2.0);
+  clock_t start;
+  double t1, t2;
+  size_t i;
+
+  if (!uniform)
+    set_log_ranges (h->range, nbins, 1.0, 2.0);
+
+  start = clock ();
+
+  for (i = 0; i < N; i++)
+    gsl_histogram_increment (h, x[i]);
+
+  t1 = seconds (start, clock ());
+
+  start = clock ();
+  gsl_histogram_increment_array (h, x, 1, N);
+  t2 = seconds (start, clock ());
+
+  printf ("1d %-11s %8lu %12.1f %12.1f\n", uniform ? "uniform" : "log",
+          (unsigned long) nbins, N / t1 / 1e6, N / t2 / 1e6);
+
+  gsl_histogram_free (h);
+}
+
+static void
+time_2d (const double x[], const double y[], const size_t nbins,
+         const int uniform)
+{
+  gsl_histogram2d *h = gsl_histogram2d_calloc_uniform (nbins, nbins,
+                                                       1.0, 2.0, 1.0, 2.0);
+  clock_t start;
+  double t1, t2;
+  size_t i;
+
+  if (!uniform)
+    {
+      set_log_ranges (h->xrange, nbins, 1.0, 2.0);
+      set_log_ranges (h->yrange, nbins, 1.0, 2.0);
+    }
+
+  start = clock ();
+
+  for (i = 0; i < N; i++)
+    gsl_histogram2d_increment (h, x[i], y[i]);
+
+  t1 = seconds (start, clock ());
+
+  start = clock ();
+  gsl_histogram2d_increment_array (h, x, 1, y, 1, N);
+  t2 = seconds (start, clock ());
+
+  printf ("2d %-11s %8lu %12.1f %12.1f\n", uniform ? "uniform" : "log",
+          (unsigned long) (nbins * nbins), N / t1 / 1e6, N / t2 / 1e6);
+
+  gsl_histogram2d_free (h);
+}
+
+static void
+time_reduce (const double x[], const size_t nbins)
+{
+  gsl_histogram *h = gsl_histogram_calloc_uniform (nbins, 1.0, 2.0);
+  gsl_histogram *g[NS];
+  gsl_histogram_shards *s = gsl_histogram_shards_alloc (h, NS);
+  const size_t nrep = N / nbins;
+  clock_t start;
+  double t1, t2;
+  size_t k, rep;
+
+  for (k = 0; k < NS; k++)
+    {
+      g[k] = gsl_histogram_clone (h);
+      gsl_histogram_increment_array (g[k], x + k * (N / NS), 1, N / NS);
+      gsl_histogram_increment_array (gsl_histogram_shards_get (s, k),
+                                     x + k * (N / NS), 1, N / NS);
+    }
+
+  start = clock ();
+
+  for (rep = 0; rep < nrep; rep++)
+    for (k = 0; k < NS; k++)
+      gsl_histogram_add (h, g[k]);
+
+  t1 = seconds (start, clock ());
+
+  start = clock ();
+
+  for (rep = 0; rep < nrep; rep++)
+    gsl_histogram_shards_reduce (h, s);
+
+  t2 = seconds (start, clock ());
+
+  printf ("reduce %8lu %12.3f %12.3f\n", (unsigned long) nbins,
+          t1 / nrep * 1e6, t2 / nrep * 1e6);
+
+  for (k = 0; k < NS; k++)
+    gsl_histogram_free (g[k]);
+
+  gsl_histogram_shards_free (s);
+  gsl_histogram_free (h);
+}
+
+int
+main (void)
+{
+  static const size_t nbins[] = { 10, 100, 1000, 100000 };
+  gsl_rng *r = gsl_rng_alloc (gsl_rng_default);
+  double *x = (double *) malloc (N * sizeof (double));
+  double *y = (double *) malloc (N * sizeof (double));
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    {
+      x[i] = 1.0 + gsl_rng_uniform (r);
+      y[i] = 1.0 + gsl_rng_uniform (r);
+    }
+
+  printf ("# %d values, rate in million values/sec\n", N);
+  printf ("#  %-11s %8s %12s %12s\n", "ranges", "bins", "increment",
+          "_array");
+
+  for (i = 0; i < 4; i++)
+    {
+      time_1d (x, nbins[i], 1);
+      time_1d (x, nbins[i], 0);
+    }
+
+  for (i = 0; i < 3; i++)
+    {
+      time_2d (x, y, nbins[i], 1);
+      time_2d (x, y, nbins[i], 0);
+    }
+
+  printf ("# combining %d histograms, time in microseconds\n", NS);
+  printf ("#      %8s %12s %12s\n", "bins", "_add", "_reduce");
+
+  for (i = 0; i < 4; i++)
+    time_reduce (x, nbins[i]);
+
+  free (x);
+  free (y);
+  gsl_rng_free (r);
+
+  return 0;
+}
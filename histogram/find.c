@@ -28,7 +28,7 @@ find (const size_t n, const double range[], const double x, size_t * i)
 {
   size_t i_linear, lower, upper, mid;
 
-  if (x < range[0])
+  if (!(x >= range[0]))         /* also excludes NaN */
     {
       return -1;
     }
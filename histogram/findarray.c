@@ -0,0 +1,121 @@
+/* histogram/findarray.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Bin lookup for arrays of values. The ranges are examined once per
+   array: if every range point lies within a quarter of a bin of the
+   uniform grid from range[0] to range[n], the bin is computed
+   arithmetically and corrected by at most one bin against the actual
+   ranges. Otherwise the bin is found by a binary search whose loop
+   has a fixed trip count and no data-dependent branches, so that it
+   compiles to conditional moves. Both give the same bin as find(). */
+
+typedef struct
+{
+  size_t n;
+  const double *range;
+  double xmin;
+  double xmax;
+  double scale;                 /* n / (xmax - xmin) */
+  int uniform;
+} find_table;
+
+static void find_table_init (find_table * t, const size_t n,
+                             const double range[]);
+
+static inline size_t find_table_bin (const find_table * t, const double x);
+
+static void
+find_table_init (find_table * t, const size_t n, const double range[])
+{
+  const double xmin = range[0];
+  const double xmax = range[n];
+  const double width = (xmax - xmin) / n;
+  size_t k;
+
+  t->n = n;
+  t->range = range;
+  t->xmin = xmin;
+  t->xmax = xmax;
+  t->scale = n / (xmax - xmin);
+  t->uniform = (width > 0.0 && width * n < GSL_POSINF);
+
+  for (k = 1; k < n && t->uniform; k++)
+    {
+      double f1 = ((double) (n - k) / (double) n);
+      double f2 = ((double) k / (double) n);
+      double dx = range[k] - (f1 * xmin + f2 * xmax);
+
+      if (!(fabs (dx) <= 0.25 * width))
+        {
+          t->uniform = 0;
+        }
+    }
+}
+
+/* return the index of the bin containing x, or n if x lies outside
+   the ranges */
+
+static inline size_t
+find_table_bin (const find_table * t, const double x)
+{
+  const double *range = t->range;
+  const double *base;
+  size_t len;
+
+  if (!(x >= t->xmin && x < t->xmax))
+    {
+      return t->n;
+    }
+
+  if (t->uniform)
+    {
+      size_t k = (size_t) ((x - t->xmin) * t->scale);
+
+      if (k >= t->n)
+        {
+          k = t->n - 1;
+        }
+
+      if (x < range[k])
+        {
+          k--;
+        }
+      else if (x >= range[k + 1])
+        {
+          k++;
+        }
+
+      if (x >= range[k] && x < range[k + 1])
+        {
+          return k;
+        }
+    }
+
+  /* find the last range point <= x among range[0..n-1] */
+
+  base = range;
+  len = t->n;
+
+  while (len > 1)
+    {
+      const size_t half = len / 2;
+      base = (base[half] <= x) ? base + half : base;
+      len -= half;
+    }
+
+  return base - range;
+}
@@ -47,6 +47,15 @@ typedef struct {
   double * sum ;
 } gsl_histogram_pdf ;
 
+typedef struct {
+  size_t n ;
+  size_t nshards ;
+  size_t stride ;
+  double * range ;
+  double * data ;
+  gsl_histogram * shard ;
+} gsl_histogram_shards ;
+
 gsl_histogram * gsl_histogram_alloc (size_t n);
 
 gsl_histogram * gsl_histogram_calloc (size_t n);
@@ -54,6 +63,12 @@ gsl_histogram * gsl_histogram_calloc_uniform (const size_t n, const double xmin,
 void gsl_histogram_free (gsl_histogram * h);
 int gsl_histogram_increment (gsl_histogram * h, double x);
 int gsl_histogram_accumulate (gsl_histogram * h, double x, double weight);
+int gsl_histogram_increment_array (gsl_histogram * h, const double x[],
+                                   const size_t stride, const size_t n);
+int gsl_histogram_accumulate_array (gsl_histogram * h,
+                                    const double x[], const size_t xstride,
+                                    const double w[], const size_t wstride,
+                                    const size_t n);
 int gsl_histogram_find (const gsl_histogram * h, 
                         const double x, size_t * i);
 
@@ -96,6 +111,13 @@ gsl_histogram_equal_bins_p(const gsl_histogram *h1, const gsl_histogram *h2);
 int 
 gsl_histogram_add(gsl_histogram *h1, const gsl_histogram *h2);
 
+gsl_histogram_shards *
+gsl_histogram_shards_alloc (const gsl_histogram * h, const size_t nshards);
+void gsl_histogram_shards_free (gsl_histogram_shards * s);
+void gsl_histogram_shards_reset (gsl_histogram_shards * s);
+gsl_histogram * gsl_histogram_shards_get (gsl_histogram_shards * s, const size_t k);
+int gsl_histogram_shards_reduce (gsl_histogram * h, const gsl_histogram_shards * s);
+
 int 
 gsl_histogram_sub(gsl_histogram *h1, const gsl_histogram *h2);
 
@@ -49,6 +49,16 @@ typedef struct {
   double * sum ;
 } gsl_histogram2d_pdf ;
 
+typedef struct {
+  size_t nx, ny ;
+  size_t nshards ;
+  size_t stride ;
+  double * xrange ;
+  double * yrange ;
+  double * data ;
+  gsl_histogram2d * shard ;
+} gsl_histogram2d_shards ;
+
 gsl_histogram2d * gsl_histogram2d_alloc (const size_t nx, const size_t ny);
 gsl_histogram2d * gsl_histogram2d_calloc (const size_t nx, const size_t ny);
 gsl_histogram2d * gsl_histogram2d_calloc_uniform (const size_t nx, const size_t ny,
@@ -60,6 +70,15 @@ void gsl_histogram2d_free (gsl_histogram2d * h);
 int gsl_histogram2d_increment (gsl_histogram2d * h, double x, double y);
 int gsl_histogram2d_accumulate (gsl_histogram2d * h, 
                                 double x, double y, double weight);
+int gsl_histogram2d_increment_array (gsl_histogram2d * h,
+                                     const double x[], const size_t xstride,
+                                     const double y[], const size_t ystride,
+                                     const size_t n);
+int gsl_histogram2d_accumulate_array (gsl_histogram2d * h,
+                                      const double x[], const size_t xstride,
+                                      const double y[], const size_t ystride,
+                                      const double w[], const size_t wstride,
+                                      const size_t n);
 int gsl_histogram2d_find (const gsl_histogram2d * h, 
                           const double x, const double y, size_t * i, size_t * j);
 
@@ -137,6 +156,15 @@ gsl_histogram2d_equal_bins_p(const gsl_histogram2d *h1,
 int
 gsl_histogram2d_add(gsl_histogram2d *h1, const gsl_histogram2d *h2);
 
+gsl_histogram2d_shards *
+gsl_histogram2d_shards_alloc (const gsl_histogram2d * h, const size_t nshards);
+void gsl_histogram2d_shards_free (gsl_histogram2d_shards * s);
+void gsl_histogram2d_shards_reset (gsl_histogram2d_shards * s);
+gsl_histogram2d * gsl_histogram2d_shards_get (gsl_histogram2d_shards * s,
+                                              const size_t k);
+int gsl_histogram2d_shards_reduce (gsl_histogram2d * h,
+                                   const gsl_histogram2d_shards * s);
+
 int
 gsl_histogram2d_sub(gsl_histogram2d *h1, const gsl_histogram2d *h2);
 
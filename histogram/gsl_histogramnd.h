@@ -0,0 +1,96 @@
+/* histogram/gsl_histogramnd.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_HISTOGRAMND_H__
+#define __GSL_HISTOGRAMND_H__
+
+#include <stdlib.h>
+#include <gsl/gsl_histogram.h>
+#include <gsl/gsl_histogram2d.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct {
+  size_t ndim ;
+  size_t * n ;          /* number of bins in each dimension */
+  size_t * stride ;     /* stride of each dimension in the bin index */
+  double ** range ;     /* n[d] + 1 range points of each dimension */
+  size_t nbins ;        /* total number of bins */
+  double * bin ;        /* dense storage, or NULL if sparse */
+  size_t nz ;           /* number of bins in the hash table */
+  size_t tsize ;        /* size of the hash table, a power of 2 */
+  size_t * key ;        /* bin index in each slot, nbins if empty */
+  double * val ;        /* bin value in each slot */
+} gsl_histogramnd ;
+
+typedef struct {
+  size_t ndim ;
+  size_t * n ;
+  size_t * stride ;
+  double ** range ;
+  size_t nbins ;        /* number of bins with positive weight */
+  size_t size ;         /* allocated length of index */
+  size_t * index ;      /* bin index of each of these bins */
+  double * sum ;        /* cumulative distribution, nbins + 1 values */
+} gsl_histogramnd_pdf ;
+
+gsl_histogramnd * gsl_histogramnd_calloc (const size_t ndim, const size_t n[]);
+gsl_histogramnd * gsl_histogramnd_calloc_sparse (const size_t ndim, const size_t n[]);
+void gsl_histogramnd_free (gsl_histogramnd * h);
+void gsl_histogramnd_reset (gsl_histogramnd * h);
+
+int gsl_histogramnd_set_ranges (gsl_histogramnd * h, const size_t d,
+                                const double range[], const size_t size);
+int gsl_histogramnd_set_ranges_uniform (gsl_histogramnd * h,
+                                        const double xmin[],
+                                        const double xmax[]);
+
+int gsl_histogramnd_increment (gsl_histogramnd * h, const double x[]);
+int gsl_histogramnd_accumulate (gsl_histogramnd * h, const double x[],
+                                const double weight);
+int gsl_histogramnd_find (const gsl_histogramnd * h, const double x[],
+                          size_t idx[]);
+double gsl_histogramnd_get (const gsl_histogramnd * h, const size_t idx[]);
+
+size_t gsl_histogramnd_nnz (const gsl_histogramnd * h);
+double gsl_histogramnd_sum (const gsl_histogramnd * h);
+
+int gsl_histogramnd_project (const gsl_histogramnd * h, const size_t d,
+                             gsl_histogram * p);
+int gsl_histogramnd_project2d (const gsl_histogramnd * h,
+                               const size_t d1, const size_t d2,
+                               gsl_histogram2d * p);
+
+gsl_histogramnd_pdf * gsl_histogramnd_pdf_alloc (const size_t ndim, const size_t n[]);
+int gsl_histogramnd_pdf_init (gsl_histogramnd_pdf * p, const gsl_histogramnd * h);
+void gsl_histogramnd_pdf_free (gsl_histogramnd_pdf * p);
+int gsl_histogramnd_pdf_sample (const gsl_histogramnd_pdf * p,
+                                const double r[], double x[]);
+
+__END_DECLS
+
+#endif /* __GSL_HISTOGRAMND_H__ */
@@ -0,0 +1,275 @@
+/* histogram/initnd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* N-dimensional histograms. The bins are numbered in row-major order,
+   with the last dimension varying fastest, and stored either densely
+   in an array of all nbins values, or sparsely in an open-addressing
+   hash table holding only the bins which have been updated. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogramnd.h>
+
+/* initial size of the hash table of a sparse histogram */
+#define SPARSE_TSIZE 16
+
+static gsl_histogramnd *histnd_alloc (const size_t ndim, const size_t n[]);
+static void make_uniform (double range[], size_t n, double xmin, double xmax);
+
+static gsl_histogramnd *
+histnd_alloc (const size_t ndim, const size_t n[])
+{
+  gsl_histogramnd *h;
+  size_t d, i, nbins = 1, nrange = 0;
+  double *r;
+
+  if (ndim == 0)
+    {
+      GSL_ERROR_NULL ("histogram dimension must be positive integer",
+                      GSL_EDOM);
+    }
+
+  for (d = 0; d < ndim; d++)
+    {
+      if (n[d] == 0)
+        {
+          GSL_ERROR_NULL ("histogram length n must be positive integer",
+                          GSL_EDOM);
+        }
+
+      if (n[d] > ((size_t) -1) / nbins)
+        {
+          GSL_ERROR_NULL ("total number of bins is too large", GSL_EINVAL);
+        }
+
+      nbins *= n[d];
+      nrange += n[d] + 1;
+    }
+
+  h = (gsl_histogramnd *) calloc (1, sizeof (gsl_histogramnd));
+
+  if (h == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for histogram struct",
+                      GSL_ENOMEM);
+    }
+
+  h->n = (size_t *) malloc (ndim * sizeof (size_t));
+  h->stride = (size_t *) malloc (ndim * sizeof (size_t));
+  h->range = (double **) calloc (ndim, sizeof (double *));
+
+  if (h->n == 0 || h->stride == 0 || h->range == 0)
+    {
+      gsl_histogramnd_free (h);
+      GSL_ERROR_NULL ("failed to allocate space for histogram dimensions",
+                      GSL_ENOMEM);
+    }
+
+  r = (double *) malloc (nrange * sizeof (double));
+
+  if (r == 0)
+    {
+      gsl_histogramnd_free (h);
+      GSL_ERROR_NULL ("failed to allocate space for histogram ranges",
+                      GSL_ENOMEM);
+    }
+
+  h->ndim = ndim;
+  h->nbins = nbins;
+
+  for (d = 0; d < ndim; d++)
+    {
+      h->n[d] = n[d];
+      h->range[d] = r;
+
+      for (i = 0; i <= n[d]; i++)
+        {
+          r[i] = i;
+        }
+
+      r += n[d] + 1;
+    }
+
+  h->stride[ndim - 1] = 1;
+
+  for (d = ndim - 1; d > 0; d--)
+    {
+      h->stride[d - 1] = h->stride[d] * n[d];
+    }
+
+  return h;
+}
+
+gsl_histogramnd *
+gsl_histogramnd_calloc (const size_t ndim, const size_t n[])
+{
+  gsl_histogramnd *h = histnd_alloc (ndim, n);
+
+  if (h == 0)
+    {
+      return h;
+    }
+
+  if (h->nbins <= ((size_t) -1) / sizeof (double))
+    {
+      h->bin = (double *) malloc (h->nbins * sizeof (double));
+    }
+
+  if (h->bin == 0)
+    {
+      gsl_histogramnd_free (h);
+      GSL_ERROR_NULL ("failed to allocate space for histogram bins",
+                      GSL_ENOMEM);
+    }
+
+  gsl_histogramnd_reset (h);
+
+  return h;
+}
+
+gsl_histogramnd *
+gsl_histogramnd_calloc_sparse (const size_t ndim, const size_t n[])
+{
+  gsl_histogramnd *h = histnd_alloc (ndim, n);
+
+  if (h == 0)
+    {
+      return h;
+    }
+
+  h->tsize = SPARSE_TSIZE;
+  h->key = (size_t *) malloc (h->tsize * sizeof (size_t));
+  h->val = (double *) malloc (h->tsize * sizeof (double));
+
+  if (h->key == 0 || h->val == 0)
+    {
+      gsl_histogramnd_free (h);
+      GSL_ERROR_NULL ("failed to allocate space for histogram hash table",
+                      GSL_ENOMEM);
+    }
+
+  gsl_histogramnd_reset (h);
+
+  return h;
+}
+
+void
+gsl_histogramnd_free (gsl_histogramnd * h)
+{
+  RETURN_IF_NULL (h);
+
+  if (h->range != 0)
+    {
+      free (h->range[0]);
+    }
+
+  free (h->n);
+  free (h->stride);
+  free (h->range);
+  free (h->bin);
+  free (h->key);
+  free (h->val);
+  free (h);
+}
+
+void
+gsl_histogramnd_reset (gsl_histogramnd * h)
+{
+  size_t i;
+
+  if (h->bin != 0)
+    {
+      for (i = 0; i < h->nbins; i++)
+        {
+          h->bin[i] = 0;
+        }
+    }
+  else
+    {
+      for (i = 0; i < h->tsize; i++)
+        {
+          h->key[i] = h->nbins;
+          h->val[i] = 0;
+        }
+
+      h->nz = 0;
+    }
+}
+
+static void
+make_uniform (double range[], size_t n, double xmin, double xmax)
+{
+  size_t i;
+
+  for (i = 0; i <= n; i++)
+    {
+      double f1 = ((double) (n-i) / (double) n);
+      double f2 = ((double) i / (double) n);
+      range[i] = f1 * xmin +  f2 * xmax;
+    }
+}
+
+int
+gsl_histogramnd_set_ranges (gsl_histogramnd * h, const size_t d,
+                            const double range[], const size_t size)
+{
+  size_t i;
+
+  if (d >= h->ndim)
+    {
+      GSL_ERROR ("dimension d must be less than ndim", GSL_EINVAL);
+    }
+
+  if (size != h->n[d] + 1)
+    {
+      GSL_ERROR ("size of range must match size of histogram", GSL_EINVAL);
+    }
+
+  for (i = 0; i < size; i++)
+    {
+      h->range[d][i] = range[i];
+    }
+
+  gsl_histogramnd_reset (h);
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_histogramnd_set_ranges_uniform (gsl_histogramnd * h, const double xmin[],
+                                    const double xmax[])
+{
+  size_t d;
+
+  for (d = 0; d < h->ndim; d++)
+    {
+      if (xmin[d] >= xmax[d])
+        {
+          GSL_ERROR ("xmin must be less than xmax", GSL_EINVAL);
+        }
+    }
+
+  for (d = 0; d < h->ndim; d++)
+    {
+      make_uniform (h->range[d], h->n[d], xmin[d], xmax[d]);
+    }
+
+  gsl_histogramnd_reset (h);
+
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/* histogram/pdfnd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* The cumulative distribution is stored only for the bins with
+   positive weight, so that its size is proportional to the number of
+   occupied bins of a sparse histogram, and the cumulative sums are
+   strictly increasing. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogramnd.h>
+
+#include "find.c"
+
+int
+gsl_histogramnd_pdf_sample (const gsl_histogramnd_pdf * p,
+                            const double r[], double x[])
+{
+  size_t d, j;
+  int status;
+  double r1 = r[0];
+
+/* Wrap the exclusive top of the bin down to the inclusive bottom of
+   the bin. Since this is a single point it should not affect the
+   distribution. */
+
+  if (r1 == 1.0)
+    {
+      r1 = 0.0;
+    }
+
+  status = find (p->nbins, p->sum, r1, &j);
+
+  if (status)
+    {
+      GSL_ERROR ("cannot find r[0] in cumulative pdf", GSL_EDOM);
+    }
+
+  for (d = 0; d < p->ndim; d++)
+    {
+      const size_t i = (p->index[j] / p->stride[d]) % p->n[d];
+      const double *range = p->range[d];
+      double delta;
+
+      if (d == 0)
+        {
+          delta = (r1 - p->sum[j]) / (p->sum[j + 1] - p->sum[j]);
+        }
+      else
+        {
+          delta = (r[d] == 1.0) ? 0.0 : r[d];
+        }
+
+      x[d] = range[i] + delta * (range[i + 1] - range[i]);
+    }
+
+  return GSL_SUCCESS;
+}
+
+gsl_histogramnd_pdf *
+gsl_histogramnd_pdf_alloc (const size_t ndim, const size_t n[])
+{
+  gsl_histogramnd_pdf *p;
+  size_t d, nrange = 0;
+  double *r;
+
+  if (ndim == 0)
+    {
+      GSL_ERROR_NULL ("histogram dimension must be positive integer",
+                      GSL_EDOM);
+    }
+
+  for (d = 0; d < ndim; d++)
+    {
+      if (n[d] == 0)
+        {
+          GSL_ERROR_NULL ("histogram length n must be positive integer",
+                          GSL_EDOM);
+        }
+
+      nrange += n[d] + 1;
+    }
+
+  p = (gsl_histogramnd_pdf *) calloc (1, sizeof (gsl_histogramnd_pdf));
+
+  if (p == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for histogram pdf struct",
+                      GSL_ENOMEM);
+    }
+
+  p->n = (size_t *) malloc (ndim * sizeof (size_t));
+  p->stride = (size_t *) malloc (ndim * sizeof (size_t));
+  p->range = (double **) calloc (ndim, sizeof (double *));
+
+  if (p->n == 0 || p->stride == 0 || p->range == 0)
+    {
+      gsl_histogramnd_pdf_free (p);
+      GSL_ERROR_NULL ("failed to allocate space for histogram pdf dimensions",
+                      GSL_ENOMEM);
+    }
+
+  r = (double *) malloc (nrange * sizeof (double));
+
+  if (r == 0)
+    {
+      gsl_histogramnd_pdf_free (p);
+      GSL_ERROR_NULL ("failed to allocate space for histogram pdf ranges",
+                      GSL_ENOMEM);
+    }
+
+  p->ndim = ndim;
+
+  for (d = 0; d < ndim; d++)
+    {
+      p->n[d] = n[d];
+      p->range[d] = r;
+      r += n[d] + 1;
+    }
+
+  return p;
+}
+
+int
+gsl_histogramnd_pdf_init (gsl_histogramnd_pdf * p, const gsl_histogramnd * h)
+{
+  const size_t m = (h->bin != 0) ? h->nbins : h->tsize;
+  size_t d, i, j, nbins = 0;
+  double v, sum = 0;
+
+  if (p->ndim != h->ndim)
+    {
+      GSL_ERROR ("histogram dimension must match pdf dimension", GSL_EDOM);
+    }
+
+  for (d = 0; d < p->ndim; d++)
+    {
+      if (p->n[d] != h->n[d])
+        {
+          GSL_ERROR ("histogram size must match pdf size", GSL_EDOM);
+        }
+    }
+
+  /* count the bins with positive weight */
+
+  for (j = 0; j < m; j++)
+    {
+      v = (h->bin != 0) ? h->bin[j] : h->val[j];
+
+      if (v < 0)
+        {
+          GSL_ERROR ("histogram bins must be non-negative to compute "
+                     "a probability distribution", GSL_EDOM);
+        }
+
+      if (v > 0)
+        {
+          nbins++;
+        }
+    }
+
+  if (nbins == 0)
+    {
+      GSL_ERROR ("histogram must have a positive bin to compute"
+                 " a probability distribution", GSL_EDOM);
+    }
+
+  if (nbins > p->size)
+    {
+      size_t *index = (size_t *) malloc (nbins * sizeof (size_t));
+      double *s = (double *) malloc ((nbins + 1) * sizeof (double));
+
+      if (index == 0 || s == 0)
+        {
+          free (index);
+          free (s);
+          GSL_ERROR ("failed to allocate space for histogram pdf sums",
+                     GSL_ENOMEM);
+        }
+
+      free (p->index);
+      free (p->sum);
+      p->index = index;
+      p->sum = s;
+      p->size = nbins;
+    }
+
+  for (d = 0; d < p->ndim; d++)
+    {
+      p->stride[d] = h->stride[d];
+
+      for (i = 0; i <= p->n[d]; i++)
+        {
+          p->range[d][i] = h->range[d][i];
+        }
+    }
+
+  p->nbins = nbins;
+  p->sum[0] = 0;
+  i = 0;
+
+  for (j = 0; j < m; j++)
+    {
+      v = (h->bin != 0) ? h->bin[j] : h->val[j];
+
+      if (v > 0)
+        {
+          p->index[i] = (h->bin != 0) ? j : h->key[j];
+          sum += v;
+          p->sum[++i] = sum;
+        }
+    }
+
+  for (i = 1; i < nbins; i++)
+    {
+      p->sum[i] /= sum;
+    }
+
+  p->sum[nbins] = 1.0;
+
+  return GSL_SUCCESS;
+}
+
+void
+gsl_histogramnd_pdf_free (gsl_histogramnd_pdf * p)
+{
+  RETURN_IF_NULL (p);
+
+  if (p->range != 0)
+    {
+      free (p->range[0]);
+    }
+
+  free (p->n);
+  free (p->stride);
+  free (p->range);
+  free (p->index);
+  free (p->sum);
+  free (p);
+}
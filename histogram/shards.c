@@ -0,0 +1,162 @@
+/* histogram/shards.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* A set of histograms sharing one array of ranges, for filling a
+   histogram from several threads. Each shard is an ordinary
+   gsl_histogram whose bins start on a separate cache line, so that
+   threads updating different shards never write to the same line.
+   The shards are summed into a target histogram at the end. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogram.h>
+
+/* assumed size of a cache line in bytes */
+#define CACHE_LINE 64
+
+#define CACHE_DOUBLES (CACHE_LINE / sizeof (double))
+
+/* number of bins summed over all shards at a time */
+#define REDUCE_BLOCK 1024
+
+gsl_histogram_shards *
+gsl_histogram_shards_alloc (const gsl_histogram * h, const size_t nshards)
+{
+  const size_t n = h->n;
+  gsl_histogram_shards *s;
+  size_t i, k, offset;
+
+  if (nshards == 0)
+    {
+      GSL_ERROR_NULL ("number of shards must be positive", GSL_EINVAL);
+    }
+
+  s = (gsl_histogram_shards *) calloc (1, sizeof (gsl_histogram_shards));
+
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for shards struct",
+                      GSL_ENOMEM);
+    }
+
+  s->n = n;
+  s->nshards = nshards;
+  s->stride = ((n + CACHE_DOUBLES - 1) / CACHE_DOUBLES) * CACHE_DOUBLES;
+
+  s->range = (double *) malloc ((n + 1) * sizeof (double));
+  s->data = (double *) malloc ((nshards * s->stride + CACHE_DOUBLES)
+                               * sizeof (double));
+  s->shard = (gsl_histogram *) malloc (nshards * sizeof (gsl_histogram));
+
+  if (s->range == 0 || s->data == 0 || s->shard == 0)
+    {
+      gsl_histogram_shards_free (s);
+      GSL_ERROR_NULL ("failed to allocate space for shards", GSL_ENOMEM);
+    }
+
+  for (i = 0; i <= n; i++)
+    {
+      s->range[i] = h->range[i];
+    }
+
+  /* align the first shard to a cache line */
+
+  offset = ((size_t) s->data % CACHE_LINE) / sizeof (double);
+  offset = (offset == 0) ? 0 : CACHE_DOUBLES - offset;
+
+  for (k = 0; k < nshards; k++)
+    {
+      s->shard[k].n = n;
+      s->shard[k].range = s->range;
+      s->shard[k].bin = s->data + offset + k * s->stride;
+    }
+
+  gsl_histogram_shards_reset (s);
+
+  return s;
+}
+
+void
+gsl_histogram_shards_free (gsl_histogram_shards * s)
+{
+  RETURN_IF_NULL (s);
+  free (s->range);
+  free (s->data);
+  free (s->shard);
+  free (s);
+}
+
+void
+gsl_histogram_shards_reset (gsl_histogram_shards * s)
+{
+  size_t i, k;
+
+  for (k = 0; k < s->nshards; k++)
+    {
+      double *bin = s->shard[k].bin;
+
+      for (i = 0; i < s->n; i++)
+        {
+          bin[i] = 0;
+        }
+    }
+}
+
+gsl_histogram *
+gsl_histogram_shards_get (gsl_histogram_shards * s, const size_t k)
+{
+  if (k >= s->nshards)
+    {
+      GSL_ERROR_NULL ("shard index lies outside valid range of 0 .. nshards - 1",
+                      GSL_EINVAL);
+    }
+
+  return &(s->shard[k]);
+}
+
+int
+gsl_histogram_shards_reduce (gsl_histogram * h, const gsl_histogram_shards * s)
+{
+  double *hbin = h->bin;
+  size_t i, i0, k;
+
+  if (!gsl_histogram_equal_bins_p (h, &(s->shard[0])))
+    {
+      GSL_ERROR ("histogram and shards have different binning", GSL_EINVAL);
+    }
+
+  /* sum in blocks which stay in cache across the shards */
+
+  for (i0 = 0; i0 < s->n; i0 += REDUCE_BLOCK)
+    {
+      const size_t i1 = GSL_MIN (i0 + REDUCE_BLOCK, s->n);
+
+      for (k = 0; k < s->nshards; k++)
+        {
+          const double *bin = s->shard[k].bin;
+
+          for (i = i0; i < i1; i++)
+            {
+              hbin[i] += bin[i];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
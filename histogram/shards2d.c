@@ -0,0 +1,171 @@
+/* histogram/shards2d.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogram2d.h>
+
+/* assumed size of a cache line in bytes */
+#define CACHE_LINE 64
+
+#define CACHE_DOUBLES (CACHE_LINE / sizeof (double))
+
+/* number of bins summed over all shards at a time */
+#define REDUCE_BLOCK 1024
+
+gsl_histogram2d_shards *
+gsl_histogram2d_shards_alloc (const gsl_histogram2d * h, const size_t nshards)
+{
+  const size_t nx = h->nx;
+  const size_t ny = h->ny;
+  const size_t n = nx * ny;
+  gsl_histogram2d_shards *s;
+  size_t i, k, offset;
+
+  if (nshards == 0)
+    {
+      GSL_ERROR_NULL ("number of shards must be positive", GSL_EINVAL);
+    }
+
+  s = (gsl_histogram2d_shards *) calloc (1, sizeof (gsl_histogram2d_shards));
+
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for shards struct",
+                      GSL_ENOMEM);
+    }
+
+  s->nx = nx;
+  s->ny = ny;
+  s->nshards = nshards;
+  s->stride = ((n + CACHE_DOUBLES - 1) / CACHE_DOUBLES) * CACHE_DOUBLES;
+
+  s->xrange = (double *) malloc ((nx + 1) * sizeof (double));
+  s->yrange = (double *) malloc ((ny + 1) * sizeof (double));
+  s->data = (double *) malloc ((nshards * s->stride + CACHE_DOUBLES)
+                               * sizeof (double));
+  s->shard = (gsl_histogram2d *) malloc (nshards * sizeof (gsl_histogram2d));
+
+  if (s->xrange == 0 || s->yrange == 0 || s->data == 0 || s->shard == 0)
+    {
+      gsl_histogram2d_shards_free (s);
+      GSL_ERROR_NULL ("failed to allocate space for shards", GSL_ENOMEM);
+    }
+
+  for (i = 0; i <= nx; i++)
+    {
+      s->xrange[i] = h->xrange[i];
+    }
+
+  for (i = 0; i <= ny; i++)
+    {
+      s->yrange[i] = h->yrange[i];
+    }
+
+  /* align the first shard to a cache line */
+
+  offset = ((size_t) s->data % CACHE_LINE) / sizeof (double);
+  offset = (offset == 0) ? 0 : CACHE_DOUBLES - offset;
+
+  for (k = 0; k < nshards; k++)
+    {
+      s->shard[k].nx = nx;
+      s->shard[k].ny = ny;
+      s->shard[k].xrange = s->xrange;
+      s->shard[k].yrange = s->yrange;
+      s->shard[k].bin = s->data + offset + k * s->stride;
+    }
+
+  gsl_histogram2d_shards_reset (s);
+
+  return s;
+}
+
+void
+gsl_histogram2d_shards_free (gsl_histogram2d_shards * s)
+{
+  RETURN_IF_NULL (s);
+  free (s->xrange);
+  free (s->yrange);
+  free (s->data);
+  free (s->shard);
+  free (s);
+}
+
+void
+gsl_histogram2d_shards_reset (gsl_histogram2d_shards * s)
+{
+  const size_t n = s->nx * s->ny;
+  size_t i, k;
+
+  for (k = 0; k < s->nshards; k++)
+    {
+      double *bin = s->shard[k].bin;
+
+      for (i = 0; i < n; i++)
+        {
+          bin[i] = 0;
+        }
+    }
+}
+
+gsl_histogram2d *
+gsl_histogram2d_shards_get (gsl_histogram2d_shards * s, const size_t k)
+{
+  if (k >= s->nshards)
+    {
+      GSL_ERROR_NULL ("shard index lies outside valid range of 0 .. nshards - 1",
+                      GSL_EINVAL);
+    }
+
+  return &(s->shard[k]);
+}
+
+int
+gsl_histogram2d_shards_reduce (gsl_histogram2d * h,
+                               const gsl_histogram2d_shards * s)
+{
+  const size_t n = s->nx * s->ny;
+  double *hbin = h->bin;
+  size_t i, i0, k;
+
+  if (!gsl_histogram2d_equal_bins_p (h, &(s->shard[0])))
+    {
+      GSL_ERROR ("histogram and shards have different binning", GSL_EINVAL);
+    }
+
+  /* sum in blocks which stay in cache across the shards */
+
+  for (i0 = 0; i0 < n; i0 += REDUCE_BLOCK)
+    {
+      const size_t i1 = GSL_MIN (i0 + REDUCE_BLOCK, n);
+
+      for (k = 0; k < s->nshards; k++)
+        {
+          const double *bin = s->shard[k].bin;
+
+          for (i = i0; i < i1; i++)
+            {
+              hbin[i] += bin[i];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
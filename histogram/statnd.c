@@ -0,0 +1,184 @@
+/* histogram/statnd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_histogramnd.h>
+
+/* The stored bins are visited as slots j = 0 .. nslots - 1, which are
+   the bins themselves for dense storage and the hash table for sparse
+   storage. */
+
+static size_t nslots (const gsl_histogramnd * h);
+static int slot_bin (const gsl_histogramnd * h, const size_t j,
+                     size_t * k, double * v);
+
+static size_t
+nslots (const gsl_histogramnd * h)
+{
+  return (h->bin != 0) ? h->nbins : h->tsize;
+}
+
+/* return the index k and value v of the bin in slot j, or zero for an
+   empty slot */
+
+static int
+slot_bin (const gsl_histogramnd * h, const size_t j, size_t * k, double * v)
+{
+  if (h->bin != 0)
+    {
+      *k = j;
+      *v = h->bin[j];
+      return 1;
+    }
+
+  *k = h->key[j];
+  *v = h->val[j];
+
+  return (*k != h->nbins);
+}
+
+size_t
+gsl_histogramnd_nnz (const gsl_histogramnd * h)
+{
+  const size_t m = nslots (h);
+  size_t j, k, nnz = 0;
+  double v;
+
+  for (j = 0; j < m; j++)
+    {
+      if (slot_bin (h, j, &k, &v) && v != 0)
+        {
+          nnz++;
+        }
+    }
+
+  return nnz;
+}
+
+double
+gsl_histogramnd_sum (const gsl_histogramnd * h)
+{
+  const size_t m = nslots (h);
+  double sum = 0;
+  size_t j, k;
+  double v;
+
+  for (j = 0; j < m; j++)
+    {
+      if (slot_bin (h, j, &k, &v))
+        {
+          sum += v;
+        }
+    }
+
+  return sum;
+}
+
+int
+gsl_histogramnd_project (const gsl_histogramnd * h, const size_t d,
+                         gsl_histogram * p)
+{
+  const size_t m = nslots (h);
+  size_t i, j, k;
+  double v;
+
+  if (d >= h->ndim)
+    {
+      GSL_ERROR ("dimension d must be less than ndim", GSL_EINVAL);
+    }
+
+  if (p->n != h->n[d])
+    {
+      GSL_ERROR ("histogram size must match size of dimension d",
+                 GSL_EBADLEN);
+    }
+
+  for (i = 0; i <= p->n; i++)
+    {
+      p->range[i] = h->range[d][i];
+    }
+
+  for (i = 0; i < p->n; i++)
+    {
+      p->bin[i] = 0;
+    }
+
+  for (j = 0; j < m; j++)
+    {
+      if (slot_bin (h, j, &k, &v))
+        {
+          p->bin[(k / h->stride[d]) % h->n[d]] += v;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_histogramnd_project2d (const gsl_histogramnd * h,
+                           const size_t d1, const size_t d2,
+                           gsl_histogram2d * p)
+{
+  const size_t m = nslots (h);
+  size_t i, j, k;
+  double v;
+
+  if (d1 >= h->ndim || d2 >= h->ndim)
+    {
+      GSL_ERROR ("dimensions d1 and d2 must be less than ndim", GSL_EINVAL);
+    }
+
+  if (d1 == d2)
+    {
+      GSL_ERROR ("dimensions d1 and d2 must be different", GSL_EINVAL);
+    }
+
+  if (p->nx != h->n[d1] || p->ny != h->n[d2])
+    {
+      GSL_ERROR ("histogram2d size must match size of dimensions d1 and d2",
+                 GSL_EBADLEN);
+    }
+
+  for (i = 0; i <= p->nx; i++)
+    {
+      p->xrange[i] = h->range[d1][i];
+    }
+
+  for (i = 0; i <= p->ny; i++)
+    {
+      p->yrange[i] = h->range[d2][i];
+    }
+
+  for (i = 0; i < p->nx * p->ny; i++)
+    {
+      p->bin[i] = 0;
+    }
+
+  for (j = 0; j < m; j++)
+    {
+      if (slot_bin (h, j, &k, &v))
+        {
+          const size_t ix = (k / h->stride[d1]) % h->n[d1];
+          const size_t iy = (k / h->stride[d2]) % h->n[d2];
+          p->bin[ix * p->ny + iy] += v;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
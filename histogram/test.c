@@ -26,6 +26,7 @@
 
 void test1d (void);
 void test2d (void);
+void testnd (void);
 void test1d_resample (void);
 void test2d_resample (void);
 void test1d_trap (void);
@@ -36,6 +37,7 @@ main (void)
 {
   test1d();
   test2d();
+  testnd();
   test1d_resample();
   test2d_resample();
   test1d_trap();
@@ -20,12 +20,98 @@
 #include <config.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_histogram.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_ieee_utils.h>
 
 #define N 397
 #define NR 10
+#define NA 5000
+
+/* compare the array functions with gsl_histogram_accumulate on values
+   spread over and beyond the range of h, including every range point
+   and a NaN */
+
+static void
+test1d_array (gsl_histogram * h, const char *desc)
+{
+  const size_t n = h->n;
+  const size_t na = NA + n + 1;
+  double *x = (double *) malloc (na * sizeof (double));
+  double *w = (double *) malloc (na * sizeof (double));
+  gsl_histogram *g = gsl_histogram_clone (h);
+  gsl_histogram *ga = gsl_histogram_clone (h);
+  double xmin = h->range[0], xmax = h->range[n];
+  double width = xmax - xmin;
+  size_t i;
+  int s, status;
+
+  for (i = 0; i < NA; i++)
+    {
+      double u = fmod (0.6180339887498949 * i, 1.0);
+      x[i] = xmin - 0.1 * width + 1.2 * width * u;
+      w[i] = 1.0 + (i % 7);
+    }
+
+  for (i = 0; i <= n; i++)
+    {
+      x[NA + i] = h->range[i];
+      w[NA + i] = 0.5;
+    }
+
+  x[NA / 2] = GSL_NAN;
+
+  gsl_histogram_reset (g);
+  gsl_histogram_reset (ga);
+
+  for (i = 0; i < na; i++)
+    gsl_histogram_accumulate (g, x[i], w[i]);
+
+  s = gsl_histogram_accumulate_array (ga, x, 1, w, 1, na);
+
+  status = (s != GSL_EDOM);
+
+  for (i = 0; i < n; i++)
+    {
+      if (ga->bin[i] != g->bin[i])
+        status = 1;
+    }
+
+  gsl_test (status, "gsl_histogram_accumulate_array, %s", desc);
+
+  /* every other value, with a stride, all inside the range */
+
+  gsl_histogram_reset (g);
+  gsl_histogram_reset (ga);
+
+  for (i = 0; i < n; i++)
+    {
+      x[2 * i] = h->range[i] + 0.5 * (h->range[i + 1] - h->range[i]);
+      gsl_histogram_increment (g, x[2 * i]);
+      gsl_histogram_increment (g, h->range[i]);
+    }
+
+  s = gsl_histogram_increment_array (ga, x, 2, n);
+  s += gsl_histogram_increment_array (ga, h->range, 1, n);
+
+  status = (s != GSL_SUCCESS);
+
+  for (i = 0; i < n; i++)
+    {
+      if (ga->bin[i] != g->bin[i] || ga->bin[i] != 2.0)
+        status = 1;
+    }
+
+  gsl_test (status, "gsl_histogram_increment_array, %s", desc);
+
+  gsl_histogram_free (g);
+  gsl_histogram_free (ga);
+  free (x);
+  free (w);
+}
 
 void
 test1d (void)
@@ -476,6 +562,77 @@ test1d (void)
     fclose (f);
   }
 
+  {
+    gsl_histogram *ha = gsl_histogram_calloc_uniform (N, -3.7, 12.1);
+
+    test1d_array (ha, "uniform ranges");
+
+    for (i = 1; i < N; i++)
+      ha->range[i] += ((i % 2) ? 1 : -1) * GSL_DBL_EPSILON * fabs (ha->range[i]);
+
+    test1d_array (ha, "uniform ranges with rounding");
+
+    ha->range[N / 3] += 0.2 * (ha->range[1] - ha->range[0]);
+
+    test1d_array (ha, "nearly uniform ranges");
+
+    for (i = 0; i <= N; i++)
+      ha->range[i] = (double) i * i * i;
+
+    test1d_array (ha, "cubic ranges");
+
+    test1d_array (hr, "integer ranges");
+
+    gsl_histogram_free (ha);
+  }
+
+  {
+    gsl_histogram *ha = gsl_histogram_calloc_uniform (N, 0.0, 1.0);
+    gsl_histogram *hb = gsl_histogram_calloc_uniform (N, 0.0, 1.0);
+    gsl_histogram_shards *s = gsl_histogram_shards_alloc (ha, 3);
+    gsl_histogram *s0 = gsl_histogram_shards_get (s, 0);
+    gsl_histogram *s1 = gsl_histogram_shards_get (s, 1);
+    int status = 0;
+
+    for (i = 0; i < 10 * N; i++)
+      {
+        double x = fmod (0.6180339887498949 * i, 1.0);
+        gsl_histogram_accumulate (gsl_histogram_shards_get (s, i % 3), x,
+                                  1.0 + i % 5);
+        gsl_histogram_accumulate (ha, x, 1.0 + i % 5);
+      }
+
+    gsl_test (!gsl_histogram_equal_bins_p (s0, ha),
+              "gsl_histogram_shards_get shares ranges");
+
+    gsl_test ((size_t) s0->bin % 64 != 0 || (size_t) s1->bin % 64 != 0
+              || s1->bin < s0->bin + N,
+              "gsl_histogram_shards_alloc aligns shards to cache lines");
+
+    gsl_histogram_shards_reduce (hb, s);
+    gsl_histogram_shards_reduce (hb, s);
+
+    for (i = 0; i < N; i++)
+      {
+        if (hb->bin[i] != 2.0 * ha->bin[i])
+          status = 1;
+      }
+
+    gsl_test (status, "gsl_histogram_shards_reduce sums shards");
+
+    gsl_histogram_shards_reset (s);
+    gsl_histogram_reset (hb);
+    gsl_histogram_shards_reduce (hb, s);
+
+    gsl_test (gsl_histogram_max_val (hb) != 0.0
+              || gsl_histogram_min_val (hb) != 0.0,
+              "gsl_histogram_shards_reset zeros shards");
+
+    gsl_histogram_shards_free (s);
+    gsl_histogram_free (ha);
+    gsl_histogram_free (hb);
+  }
+
   gsl_histogram_free (h);
   gsl_histogram_free (g);
   gsl_histogram_free (h1);
@@ -117,6 +117,31 @@ test1d_trap (void)
   gsl_histogram_find (h, 1.1, &i);
   gsl_test (status != GSL_EDOM, "gsl_histogram_find traps x above xmax");
 
+  {
+    gsl_histogram *hs = gsl_histogram_calloc_uniform (N, 0.0, 2.0);
+    gsl_histogram_shards *s;
+    gsl_histogram *sk;
+
+    status = 0;
+    s = gsl_histogram_shards_alloc (h, 0);
+    gsl_test (!status, "gsl_histogram_shards_alloc traps zero shards");
+    gsl_test (s != 0, "gsl_histogram_shards_alloc returns NULL for zero shards");
+
+    s = gsl_histogram_shards_alloc (h, 2);
+
+    status = 0;
+    sk = gsl_histogram_shards_get (s, 2);
+    gsl_test (!status || sk != 0,
+              "gsl_histogram_shards_get traps index at nshards");
+
+    status = 0;
+    gsl_histogram_shards_reduce (hs, s);
+    gsl_test (!status, "gsl_histogram_shards_reduce traps different ranges");
+
+    gsl_histogram_shards_free (s);
+    gsl_histogram_free (hs);
+  }
+
   gsl_histogram_free (h);
 }
 
@@ -20,6 +20,7 @@
 #include <config.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_machine.h>
@@ -33,6 +34,78 @@
 #define N1 23
 #define MR 10
 #define NR 5
+#define NA 5000
+
+/* compare the array functions with gsl_histogram2d_accumulate on
+   points spread over and beyond the ranges of h */
+
+static void
+test2d_array (gsl_histogram2d * h, const char *desc)
+{
+  const size_t nx = h->nx, ny = h->ny;
+  double *xy = (double *) malloc (3 * NA * sizeof (double));
+  gsl_histogram2d *g = gsl_histogram2d_clone (h);
+  gsl_histogram2d *ga = gsl_histogram2d_clone (h);
+  double xmin = h->xrange[0], xwidth = h->xrange[nx] - xmin;
+  double ymin = h->yrange[0], ywidth = h->yrange[ny] - ymin;
+  size_t i;
+  int s, status;
+
+  for (i = 0; i < NA; i++)
+    {
+      double u = fmod (0.6180339887498949 * i, 1.0);
+      double v = fmod (0.7548776662466927 * i, 1.0);
+      xy[3 * i] = xmin - 0.1 * xwidth + 1.2 * xwidth * u;
+      xy[3 * i + 1] = ymin - 0.1 * ywidth + 1.2 * ywidth * v;
+      xy[3 * i + 2] = 1.0 + (i % 5);
+    }
+
+  for (i = 0; i <= nx && i <= ny; i++)
+    {
+      xy[3 * i] = h->xrange[i];
+      xy[3 * i + 1] = h->yrange[i];
+    }
+
+  gsl_histogram2d_reset (g);
+  gsl_histogram2d_reset (ga);
+
+  for (i = 0; i < NA; i++)
+    gsl_histogram2d_accumulate (g, xy[3 * i], xy[3 * i + 1], xy[3 * i + 2]);
+
+  s = gsl_histogram2d_accumulate_array (ga, xy, 3, xy + 1, 3, xy + 2, 3, NA);
+
+  status = (s != GSL_EDOM);
+
+  for (i = 0; i < nx * ny; i++)
+    {
+      if (ga->bin[i] != g->bin[i])
+        status = 1;
+    }
+
+  gsl_test (status, "gsl_histogram2d_accumulate_array, %s", desc);
+
+  gsl_histogram2d_reset (g);
+  gsl_histogram2d_reset (ga);
+
+  for (i = 0; i < NA; i++)
+    gsl_histogram2d_increment (g, xy[3 * i], xy[3 * i + 1]);
+
+  s = gsl_histogram2d_increment_array (ga, xy, 3, xy + 1, 3, NA);
+
+  status = (s != GSL_EDOM);
+
+  for (i = 0; i < nx * ny; i++)
+    {
+      if (ga->bin[i] != g->bin[i])
+        status = 1;
+    }
+
+  gsl_test (status, "gsl_histogram2d_increment_array, %s", desc);
+
+  gsl_histogram2d_free (g);
+  gsl_histogram2d_free (ga);
+  free (xy);
+}
 
 void
 test2d (void)
@@ -746,6 +819,70 @@ test2d (void)
     fclose (f);
   }
 
+  {
+    gsl_histogram2d *ha = gsl_histogram2d_calloc_uniform (M, N, -1.5, 2.5,
+                                                          10.0, 1e3);
+
+    test2d_array (ha, "uniform ranges");
+
+    for (j = 0; j <= N; j++)
+      ha->yrange[j] = exp (0.01 * j);
+
+    test2d_array (ha, "exponential y ranges");
+
+    test2d_array (hr, "integer ranges");
+
+    gsl_histogram2d_free (ha);
+  }
+
+  {
+    gsl_histogram2d *ha = gsl_histogram2d_calloc_uniform (M1, N1, 0.0, 1.0,
+                                                          0.0, 1.0);
+    gsl_histogram2d *hb = gsl_histogram2d_clone (ha);
+    gsl_histogram2d_shards *s = gsl_histogram2d_shards_alloc (ha, 4);
+    gsl_histogram2d *s0 = gsl_histogram2d_shards_get (s, 0);
+    gsl_histogram2d *s1 = gsl_histogram2d_shards_get (s, 1);
+    int status = 0;
+
+    for (k = 0; k < 10 * M1 * N1; k++)
+      {
+        double x = fmod (0.6180339887498949 * k, 1.0);
+        double y = fmod (0.7548776662466927 * k, 1.0);
+        gsl_histogram2d_accumulate (gsl_histogram2d_shards_get (s, k % 4),
+                                    x, y, 1.0 + k % 3);
+        gsl_histogram2d_accumulate (ha, x, y, 1.0 + k % 3);
+      }
+
+    gsl_test (!gsl_histogram2d_equal_bins_p (s0, ha),
+              "gsl_histogram2d_shards_get shares ranges");
+
+    gsl_test ((size_t) s0->bin % 64 != 0 || (size_t) s1->bin % 64 != 0
+              || s1->bin < s0->bin + M1 * N1,
+              "gsl_histogram2d_shards_alloc aligns shards to cache lines");
+
+    gsl_histogram2d_shards_reduce (hb, s);
+
+    for (k = 0; k < M1 * N1; k++)
+      {
+        if (hb->bin[k] != ha->bin[k])
+          status = 1;
+      }
+
+    gsl_test (status, "gsl_histogram2d_shards_reduce sums shards");
+
+    gsl_histogram2d_shards_reset (s);
+    gsl_histogram2d_reset (hb);
+    gsl_histogram2d_shards_reduce (hb, s);
+
+    gsl_test (gsl_histogram2d_max_val (hb) != 0.0
+              || gsl_histogram2d_min_val (hb) != 0.0,
+              "gsl_histogram2d_shards_reset zeros shards");
+
+    gsl_histogram2d_shards_free (s);
+    gsl_histogram2d_free (ha);
+    gsl_histogram2d_free (hb);
+  }
+
   gsl_histogram2d_free (h);
   gsl_histogram2d_free (h1);
   gsl_histogram2d_free (g);
@@ -190,6 +190,33 @@ test2d_trap (void)
   gsl_histogram2d_find (h, 0.0, 1.1, &i, &j);
   gsl_test (status != GSL_EDOM, "gsl_histogram2d_find traps y above ymax");
 
+  {
+    gsl_histogram2d *hs = gsl_histogram2d_calloc (h->nx, h->ny + 1);
+    gsl_histogram2d_shards *s;
+    gsl_histogram2d *sk;
+
+    status = 0;
+    s = gsl_histogram2d_shards_alloc (h, 0);
+    gsl_test (!status, "gsl_histogram2d_shards_alloc traps zero shards");
+    gsl_test (s != 0,
+              "gsl_histogram2d_shards_alloc returns NULL for zero shards");
+
+    s = gsl_histogram2d_shards_alloc (h, 2);
+
+    status = 0;
+    sk = gsl_histogram2d_shards_get (s, 2);
+    gsl_test (!status || sk != 0,
+              "gsl_histogram2d_shards_get traps index at nshards");
+
+    status = 0;
+    gsl_histogram2d_shards_reduce (hs, s);
+    gsl_test (!status,
+              "gsl_histogram2d_shards_reduce traps different binning");
+
+    gsl_histogram2d_shards_free (s);
+    gsl_histogram2d_free (hs);
+  }
+
   gsl_histogram2d_free (h);
 }
 
@@ -0,0 +1,356 @@
+/* histogram/testnd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_histogramnd.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_ieee_utils.h>
+
+#define D 4
+#define NP 20000
+
+/* coordinates of a point of an additive recurrence, spread over and
+   beyond [xmin, xmax] in each dimension */
+
+static void
+point (const size_t i, const double xmin[], const double xmax[],
+       const size_t ndim, double x[])
+{
+  static const double alpha[] = { 0.6180339887498949, 0.7548776662466927,
+                                  0.5698402909980532, 0.4142135623730950,
+                                  0.7320508075688772 };
+  size_t d;
+
+  for (d = 0; d < ndim; d++)
+    {
+      double u = fmod (alpha[d] * i, 1.0);
+      double w = xmax[d] - xmin[d];
+      x[d] = xmin[d] - 0.05 * w + 1.1 * w * u;
+    }
+}
+
+void
+testnd (void)
+{
+  const size_t n[D] = { 7, 5, 11, 3 };
+  const double xmin[D] = { 0.0, -1.0, 10.0, -5.0 };
+  const double xmax[D] = { 1.0, 1.0, 20.0, 5.0 };
+  gsl_histogramnd *hd, *hs;
+  gsl_histogram *h1[D], *p1;
+  gsl_histogram2d *h2, *p2;
+  size_t i, j, d, k;
+  double x[D];
+
+  gsl_ieee_env_setup ();
+
+  hd = gsl_histogramnd_calloc (D, n);
+  hs = gsl_histogramnd_calloc_sparse (D, n);
+
+  gsl_test (hd->nbins != 7 * 5 * 11 * 3,
+            "gsl_histogramnd_calloc returns valid number of bins");
+  gsl_test (hd->stride[0] != 5 * 11 * 3 || hd->stride[D - 1] != 1,
+            "gsl_histogramnd_calloc returns row-major strides");
+
+  gsl_histogramnd_set_ranges_uniform (hd, xmin, xmax);
+  gsl_histogramnd_set_ranges_uniform (hs, xmin, xmax);
+
+  {
+    double r[4] = { -5.0, -4.0, 0.5, 5.0 };
+    gsl_histogramnd_set_ranges (hd, 3, r, 4);
+    gsl_histogramnd_set_ranges (hs, 3, r, 4);
+  }
+
+  for (d = 0; d < D; d++)
+    {
+      h1[d] = gsl_histogram_calloc_range (n[d], hd->range[d]);
+    }
+
+  h2 = gsl_histogram2d_calloc_range (n[1], n[2], hd->range[1], hd->range[2]);
+
+  {
+    int status = 0, s1, s2;
+    size_t inside = 0;
+
+    for (i = 0; i < NP; i++)
+      {
+        const double w = 1.0 + i % 3;
+
+        point (i, xmin, xmax, D, x);
+
+        s1 = gsl_histogramnd_accumulate (hd, x, w);
+        s2 = gsl_histogramnd_accumulate (hs, x, w);
+
+        if (s1 != s2)
+          status = 1;
+
+        if (s1 == GSL_SUCCESS)
+          {
+            inside++;
+
+            for (d = 0; d < D; d++)
+              gsl_histogram_accumulate (h1[d], x[d], w);
+
+            gsl_histogram2d_accumulate (h2, x[1], x[2], w);
+          }
+        else if (s1 != GSL_EDOM)
+          {
+            status = 1;
+          }
+      }
+
+    gsl_test (status, "gsl_histogramnd_accumulate traps points outside");
+    gsl_test (inside == 0 || inside == NP,
+              "gsl_histogramnd_accumulate test covers inside and outside");
+  }
+
+  {
+    int status = 0;
+    size_t idx[D];
+
+    for (k = 0; k < hd->nbins; k++)
+      {
+        for (d = 0; d < D; d++)
+          idx[d] = (k / hd->stride[d]) % n[d];
+
+        if (gsl_histogramnd_get (hd, idx) != gsl_histogramnd_get (hs, idx))
+          status = 1;
+
+        if (gsl_histogramnd_get (hd, idx) != hd->bin[k])
+          status = 1;
+      }
+
+    gsl_test (status, "gsl_histogramnd_get sparse and dense storage");
+  }
+
+  gsl_test (gsl_histogramnd_nnz (hd) != gsl_histogramnd_nnz (hs)
+            || gsl_histogramnd_nnz (hs) != hs->nz,
+            "gsl_histogramnd_nnz sparse and dense storage");
+
+  gsl_test (hs->tsize < 2 * hs->nz,
+            "gsl_histogramnd sparse hash table at most half full");
+
+  gsl_test_rel (gsl_histogramnd_sum (hs), gsl_histogramnd_sum (hd), 1e-15,
+                "gsl_histogramnd_sum sparse and dense storage");
+
+  {
+    int status = 0;
+    size_t idx[D], i1;
+
+    for (i = 0; i < 100; i++)
+      {
+        int inside = 1;
+
+        point (i, xmin, xmax, D, x);
+
+        for (d = 0; d < D; d++)
+          {
+            if (x[d] < hd->range[d][0] || x[d] >= hd->range[d][n[d]])
+              inside = 0;
+          }
+
+        if (inside)
+          {
+            gsl_histogramnd_find (hd, x, idx);
+
+            for (d = 0; d < D; d++)
+              {
+                gsl_histogram_find (h1[d], x[d], &i1);
+
+                if (idx[d] != i1)
+                  status = 1;
+              }
+          }
+      }
+
+    gsl_test (status, "gsl_histogramnd_find returns index");
+  }
+
+  for (j = 0; j < 2; j++)
+    {
+      gsl_histogramnd *h = (j == 0) ? hd : hs;
+      const char *desc = (j == 0) ? "dense" : "sparse";
+      int status = 0;
+
+      for (d = 0; d < D; d++)
+        {
+          p1 = gsl_histogram_calloc (n[d]);
+          gsl_histogramnd_project (h, d, p1);
+
+          if (!gsl_histogram_equal_bins_p (p1, h1[d]))
+            status = 1;
+
+          for (i = 0; i < n[d]; i++)
+            {
+              if (p1->bin[i] != h1[d]->bin[i])
+                status = 1;
+            }
+
+          gsl_histogram_free (p1);
+        }
+
+      gsl_test (status, "gsl_histogramnd_project, %s", desc);
+
+      status = 0;
+      p2 = gsl_histogram2d_calloc (n[1], n[2]);
+      gsl_histogramnd_project2d (h, 1, 2, p2);
+
+      if (!gsl_histogram2d_equal_bins_p (p2, h2))
+        status = 1;
+
+      for (i = 0; i < n[1] * n[2]; i++)
+        {
+          if (p2->bin[i] != h2->bin[i])
+            status = 1;
+        }
+
+      gsl_test (status, "gsl_histogramnd_project2d, %s", desc);
+
+      gsl_histogram2d_free (p2);
+    }
+
+  gsl_histogramnd_reset (hs);
+
+  gsl_test (hs->nz != 0 || gsl_histogramnd_sum (hs) != 0.0,
+            "gsl_histogramnd_reset clears sparse storage");
+
+  /* a sparse histogram with 80^5 = 3.3 x 10^9 bins */
+
+  {
+    const size_t nb[5] = { 80, 80, 80, 80, 80 };
+    const double zero[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    const double one[5] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+    gsl_histogramnd *h = gsl_histogramnd_calloc_sparse (5, nb);
+    double y[5];
+    size_t inside = 0, first = NP;
+    int status = 0;
+
+    gsl_histogramnd_set_ranges_uniform (h, zero, one);
+
+    for (i = 0; i < NP; i++)
+      {
+        point (i, zero, one, 5, y);
+
+        if (gsl_histogramnd_accumulate (h, y, 0.5) == GSL_SUCCESS)
+          {
+            if (inside++ == 0)
+              first = i;
+
+            gsl_histogramnd_accumulate (h, y, 0.5);
+          }
+      }
+
+    gsl_test (h->nz != inside || h->tsize > 4 * inside,
+              "gsl_histogramnd sparse memory proportional to occupied bins");
+
+    gsl_test_rel (gsl_histogramnd_sum (h), (double) inside, 1e-15,
+                  "gsl_histogramnd_sum sparse 80^5 bins");
+
+    {
+      size_t idx[5];
+
+      point (first, zero, one, 5, y);
+
+      for (d = 0; d < 5; d++)
+        idx[d] = (size_t) (y[d] * 80);
+
+      if (gsl_histogramnd_get (h, idx) != 1.0)
+        status = 1;
+
+      idx[0] = (idx[0] + 1) % 80;
+
+      if (gsl_histogramnd_get (h, idx) != 0.0)
+        status = 1;
+    }
+
+    gsl_test (status, "gsl_histogramnd_get sparse 80^5 bins");
+
+    gsl_histogramnd_free (h);
+  }
+
+  /* sampling from a sparse histogram */
+
+  {
+    gsl_histogramnd *h = gsl_histogramnd_calloc_sparse (D, n);
+    gsl_histogramnd *g = gsl_histogramnd_calloc (D, n);
+    gsl_histogramnd_pdf *p = gsl_histogramnd_pdf_alloc (D, n);
+    const double w[3] = { 1.0, 2.0, 5.0 };
+    const size_t ns = 80000;
+    double r[D];
+    size_t idx[D];
+    int status = 0;
+
+    gsl_histogramnd_set_ranges_uniform (h, xmin, xmax);
+
+    for (i = 0; i < 3; i++)
+      {
+        for (d = 0; d < D; d++)
+          x[d] = xmin[d] + (0.1 + 0.3 * i) * (xmax[d] - xmin[d]);
+
+        gsl_histogramnd_accumulate (h, x, w[i]);
+      }
+
+    gsl_histogramnd_pdf_init (p, h);
+
+    gsl_test (p->nbins != 3, "gsl_histogramnd_pdf_init stores occupied bins");
+
+    gsl_histogramnd_set_ranges_uniform (g, xmin, xmax);
+
+    for (i = 0; i < ns; i++)
+      {
+        r[0] = (i + 0.5) / ns;
+
+        for (d = 1; d < D; d++)
+          r[d] = fmod (0.6180339887498949 * (i + d), 1.0);
+
+        gsl_histogramnd_pdf_sample (p, r, x);
+
+        if (gsl_histogramnd_increment (g, x) != GSL_SUCCESS)
+          status = 1;
+      }
+
+    for (k = 0; k < g->nbins; k++)
+      {
+        double expected;
+
+        for (d = 0; d < D; d++)
+          idx[d] = (k / g->stride[d]) % n[d];
+
+        expected = ns * gsl_histogramnd_get (h, idx) / 8.0;
+
+        if (fabs (g->bin[k] - expected) > 1.0)
+          status = 1;
+      }
+
+    gsl_test (status, "gsl_histogramnd_pdf_sample");
+
+    gsl_histogramnd_pdf_free (p);
+    gsl_histogramnd_free (g);
+    gsl_histogramnd_free (h);
+  }
+
+  for (d = 0; d < D; d++)
+    gsl_histogram_free (h1[d]);
+
+  gsl_histogram2d_free (h2);
+  gsl_histogramnd_free (hd);
+  gsl_histogramnd_free (hs);
+}
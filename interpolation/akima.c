@@ -358,6 +358,37 @@ akima_eval_integ (const void * vstate,
 }
 
 
+/* evaluate a block of points with known intervals, see interp.c */
+
+static int
+akima_eval_array (const void * vstate,
+                  const double x_array[], const double y_array[],
+                  size_t size, const double x[], const size_t index[],
+                  size_t n, int order, double y[])
+{
+  const akima_state_t *state = (const akima_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t k = index[i];
+      const double delx = x[i] - x_array[k];
+      const double b = state->b[k];
+      const double c = state->c[k];
+      const double d = state->d[k];
+
+      if (order == 0)
+        y[i] = y_array[k] + delx * (b + delx * (c + d * delx));
+      else if (order == 1)
+        y[i] = b + delx * (2.0 * c + 3.0 * d * delx);
+      else
+        y[i] = 2.0 * c + 6.0 * d * delx;
+    }
+
+  return GSL_SUCCESS;
+}
+
+
 static const gsl_interp_type akima_type = 
 {
   "akima", 
@@ -368,7 +399,8 @@ static const gsl_interp_type akima_type =
   &akima_eval_deriv,
   &akima_eval_deriv2,
   &akima_eval_integ,
-  &akima_free
+  &akima_free,
+  &akima_eval_array
 };
 
 const gsl_interp_type * gsl_interp_akima = &akima_type;
@@ -383,7 +415,8 @@ static const gsl_interp_type akima_periodic_type =
   &akima_eval_deriv,
   &akima_eval_deriv2,
   &akima_eval_integ,
-  &akima_free
+  &akima_free,
+  &akima_eval_array
 };
 
 const gsl_interp_type * gsl_interp_akima_periodic = &akima_periodic_type;
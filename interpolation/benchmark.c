@@ -0,0 +1,112 @@
+/* interpolation/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Rate at which splines of NK knots are evaluated at N points, one
+   point at a time with gsl_spline_eval and an accelerator, and in bulk
+   with gsl_spline_eval_array, for sorted and for unordered points. */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_spline.h>
+
+#define N 10000000
+#define NK 1000
+
+static double
+seconds (clock_t start, clock_t end)
+{
+  return (end - start) / (double) CLOCKS_PER_SEC;
+}
+
+static void
+time_spline (const gsl_interp_type * T, const double x[], double y[],
+             const char * order)
+{
+  double xa[NK], ya[NK];
+  gsl_spline *spline = gsl_spline_alloc (T, NK);
+  gsl_interp_accel *a = gsl_interp_accel_alloc ();
+  clock_t t0, t1, t2;
+  double sum = 0;
+  size_t i;
+
+  for (i = 0; i < NK; i++)
+    {
+      xa[i] = i;
+      ya[i] = sin (0.01 * i);
+    }
+
+  gsl_spline_init (spline, xa, ya, NK);
+
+  t0 = clock ();
+
+  for (i = 0; i < N; i++)
+    y[i] = gsl_spline_eval (spline, x[i], a);
+
+  t1 = clock ();
+
+  gsl_interp_accel_reset (a);
+  gsl_spline_eval_array (spline, x, N, a, y);
+
+  t2 = clock ();
+
+  for (i = 0; i < N; i++)
+    sum += y[i];
+
+  printf ("%-9s %-8s  scalar %6.1f Mpoints/s  array %6.1f Mpoints/s"
+          "  (sum %g)\n", gsl_spline_name (spline), order,
+          N / seconds (t0, t1) / 1e6, N / seconds (t1, t2) / 1e6, sum);
+
+  gsl_interp_accel_free (a);
+  gsl_spline_free (spline);
+}
+
+int
+main (void)
+{
+  const gsl_interp_type *types[4];
+  double *xs = malloc (N * sizeof (double));
+  double *xr = malloc (N * sizeof (double));
+  double *y = malloc (N * sizeof (double));
+  size_t i, k;
+
+  types[0] = gsl_interp_linear;
+  types[1] = gsl_interp_cspline;
+  types[2] = gsl_interp_akima;
+  types[3] = gsl_interp_steffen;
+
+  for (i = 0; i < N; i++)
+    {
+      xs[i] = (NK - 1) * (double) i / (N - 1);
+      xr[i] = (NK - 1) * fmod (0.6180339887498949 * i, 1.0);
+      y[i] = 0;
+    }
+
+  for (k = 0; k < 4; k++)
+    {
+      time_spline (types[k], xs, y, "sorted");
+      time_spline (types[k], xr, y, "unsorted");
+    }
+
+  free (xs);
+  free (xr);
+  free (y);
+
+  return 0;
+}
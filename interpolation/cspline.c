@@ -442,6 +442,40 @@ cspline_eval_integ (const void * vstate,
   return GSL_SUCCESS;
 }
 
+/* evaluate a block of points with known intervals, see interp.c */
+
+static int
+cspline_eval_array (const void * vstate,
+                    const double x_array[], const double y_array[],
+                    size_t size, const double x[], const size_t index[],
+                    size_t n, int order, double y[])
+{
+  const cspline_state_t *state = (const cspline_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t k = index[i];
+      const double x_lo = x_array[k];
+      const double dx = x_array[k + 1] - x_lo;
+      const double dy = y_array[k + 1] - y_array[k];
+      const double delx = x[i] - x_lo;
+      double b_i, c_i, d_i;
+
+      coeff_calc (state->c, dy, dx, k, &b_i, &c_i, &d_i);
+
+      if (order == 0)
+        y[i] = y_array[k] + delx * (b_i + delx * (c_i + delx * d_i));
+      else if (order == 1)
+        y[i] = b_i + delx * (2.0 * c_i + 3.0 * d_i * delx);
+      else
+        y[i] = 2.0 * c_i + 6.0 * d_i * delx;
+    }
+
+  return GSL_SUCCESS;
+}
+
+
 static const gsl_interp_type cspline_type = 
 {
   "cspline", 
@@ -452,7 +486,8 @@ static const gsl_interp_type cspline_type =
   &cspline_eval_deriv,
   &cspline_eval_deriv2,
   &cspline_eval_integ,
-  &cspline_free
+  &cspline_free,
+  &cspline_eval_array
 };
 
 const gsl_interp_type * gsl_interp_cspline = &cspline_type;
@@ -467,7 +502,8 @@ static const gsl_interp_type cspline_periodic_type =
   &cspline_eval_deriv,
   &cspline_eval_deriv2,
   &cspline_eval_integ,
-  &cspline_free
+  &cspline_free,
+  &cspline_eval_array
 };
 
 const gsl_interp_type * gsl_interp_cspline_periodic = &cspline_periodic_type;
@@ -57,6 +57,7 @@ typedef struct {
   int     (*eval_deriv2) (const void *, const double xa[], const double ya[], size_t size, double x, gsl_interp_accel *, double * y_pp);
   int     (*eval_integ)  (const void *, const double xa[], const double ya[], size_t size, gsl_interp_accel *, double a, double b, double * result);
   void    (*free)         (void *);
+  int     (*eval_array)   (const void *, const double xa[], const double ya[], size_t size, const double x[], const size_t index[], size_t n, int order, double y[]);
 
 } gsl_interp_type;
 
@@ -145,6 +146,24 @@ gsl_interp_eval_integ(const gsl_interp * obj,
                       double a, double b,
                       gsl_interp_accel * acc);
 
+int
+gsl_interp_eval_array(const gsl_interp * obj,
+                      const double xa[], const double ya[],
+                      const double x[], size_t n,
+                      gsl_interp_accel * a, double y[]);
+
+int
+gsl_interp_eval_deriv_array(const gsl_interp * obj,
+                            const double xa[], const double ya[],
+                            const double x[], size_t n,
+                            gsl_interp_accel * a, double d[]);
+
+int
+gsl_interp_eval_deriv2_array(const gsl_interp * obj,
+                             const double xa[], const double ya[],
+                             const double x[], size_t n,
+                             gsl_interp_accel * a, double d2[]);
+
 void
 gsl_interp_free(gsl_interp * interp);
 
@@ -93,6 +93,21 @@ gsl_spline_eval_integ(const gsl_spline * spline,
                       double a, double b,
                       gsl_interp_accel * acc);
 
+int
+gsl_spline_eval_array(const gsl_spline * spline,
+                      const double x[], size_t n,
+                      gsl_interp_accel * a, double y[]);
+
+int
+gsl_spline_eval_deriv_array(const gsl_spline * spline,
+                            const double x[], size_t n,
+                            gsl_interp_accel * a, double d[]);
+
+int
+gsl_spline_eval_deriv2_array(const gsl_spline * spline,
+                             const double x[], size_t n,
+                             gsl_interp_accel * a, double d2[]);
+
 void
 gsl_spline_free(gsl_spline * spline);
 
@@ -278,3 +278,181 @@ gsl_interp_eval_integ (const gsl_interp * interp,
 }
 
 
+
+
+/* Evaluation of arrays of points. The interval of each point is found
+   by walking forward from the interval of the previous point, a few
+   intervals at a time before falling back to a binary search, so that
+   sorted points cost O(n + size) comparisons in total. The binary
+   search is written without branches on the comparisons, which would
+   be mispredicted for unordered points. The intervals of a block of
+   points are passed to the eval_array method of the type, which
+   evaluates the block without any searching, or to the scalar methods
+   for types without one. */
+
+#define ARRAY_BLOCK 256
+#define WALK_STEPS 2
+
+/* return the same index as gsl_interp_bsearch, for xa[lo] <= x */
+
+static size_t
+search_index (const double xa[], double x, size_t lo, size_t hi)
+{
+  size_t n = hi - lo;
+
+  while (n > 1)
+    {
+      const size_t half = n / 2;
+      lo = (xa[lo + half] <= x) ? lo + half : lo;
+      n -= half;
+    }
+
+  return lo;
+}
+
+static size_t
+walk_index (const double xa[], size_t size, double x, size_t index)
+{
+  size_t k;
+
+  if (x < xa[index])
+    {
+      return search_index (xa, x, 0, index);
+    }
+
+  for (k = 0; k < WALK_STEPS; k++)
+    {
+      if (index + 2 >= size || x < xa[index + 1])
+        {
+          return index;
+        }
+
+      index++;
+    }
+
+  return search_index (xa, x, index, size - 1);
+}
+
+static int
+eval_array (const gsl_interp * interp, const double xa[], const double ya[],
+            const double x[], size_t n, gsl_interp_accel * a, int order,
+            double y[])
+{
+  const size_t size = interp->size;
+  size_t index[ARRAY_BLOCK];
+  size_t i, j, m, nout;
+  size_t k = (a != 0 && a->cache + 1 < size) ? a->cache : 0;
+  int status = GSL_SUCCESS, s;
+
+  for (i = 0; i < n; i += m)
+    {
+      m = GSL_MIN (ARRAY_BLOCK, n - i);
+      nout = 0;
+
+      for (j = 0; j < m; j++)
+        {
+          const double xj = x[i + j];
+
+          if (xj >= interp->xmin && xj <= interp->xmax)
+            {
+              k = walk_index (xa, size, xj, k);
+              index[j] = k;
+            }
+          else
+            {
+              index[j] = 0;     /* evaluated, then replaced by NaN */
+              nout++;
+            }
+        }
+
+      if (interp->type->eval_array != NULL)
+        {
+          s = interp->type->eval_array (interp->state, xa, ya, size,
+                                        x + i, index, m, order, y + i);
+        }
+      else
+        {
+          s = GSL_SUCCESS;
+
+          for (j = 0; j < m; j++)
+            {
+              gsl_interp_accel acc;
+              int sj;
+
+              acc.cache = index[j];
+              acc.hit_count = 0;
+              acc.miss_count = 0;
+
+              if (order == 0)
+                sj = interp->type->eval (interp->state, xa, ya, size,
+                                         x[i + j], &acc, &y[i + j]);
+              else if (order == 1)
+                sj = interp->type->eval_deriv (interp->state, xa, ya, size,
+                                               x[i + j], &acc, &y[i + j]);
+              else
+                sj = interp->type->eval_deriv2 (interp->state, xa, ya, size,
+                                                x[i + j], &acc, &y[i + j]);
+
+              if (sj != GSL_SUCCESS)
+                s = sj;
+            }
+        }
+
+      if (s != GSL_SUCCESS && status == GSL_SUCCESS)
+        {
+          status = s;
+        }
+
+      if (nout > 0)
+        {
+          for (j = 0; j < m; j++)
+            {
+              const double xj = x[i + j];
+
+              if (!(xj >= interp->xmin && xj <= interp->xmax))
+                {
+                  y[i + j] = GSL_NAN;
+                }
+            }
+
+          if (status == GSL_SUCCESS)
+            {
+              status = GSL_EDOM;
+            }
+        }
+    }
+
+  if (a != 0)
+    {
+      a->cache = k;
+    }
+
+  return status;
+}
+
+int
+gsl_interp_eval_array (const gsl_interp * interp,
+                       const double xa[], const double ya[],
+                       const double x[], size_t n,
+                       gsl_interp_accel * a, double y[])
+{
+  return eval_array (interp, xa, ya, x, n, a, 0, y);
+}
+
+int
+gsl_interp_eval_deriv_array (const gsl_interp * interp,
+                             const double xa[], const double ya[],
+                             const double x[], size_t n,
+                             gsl_interp_accel * a, double d[])
+{
+  return eval_array (interp, xa, ya, x, n, a, 1, d);
+}
+
+int
+gsl_interp_eval_deriv2_array (const gsl_interp * interp,
+                              const double xa[], const double ya[],
+                              const double x[], size_t n,
+                              gsl_interp_accel * a, double d2[])
+{
+  return eval_array (interp, xa, ya, x, n, a, 2, d2);
+}
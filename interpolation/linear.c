@@ -182,6 +182,35 @@ linear_eval_integ (const void * vstate,
   return GSL_SUCCESS;
 }
 
+/* evaluate a block of points with known intervals, see interp.c */
+
+static
+int
+linear_eval_array (const void * vstate,
+                   const double x_array[], const double y_array[],
+                   size_t size, const double x[], const size_t index[],
+                   size_t n, int order, double y[])
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t k = index[i];
+      const double x_lo = x_array[k];
+      const double dx = x_array[k + 1] - x_lo;
+      const double dy = y_array[k + 1] - y_array[k];
+
+      if (order == 0)
+        y[i] = y_array[k] + (x[i] - x_lo) / dx * dy;
+      else if (order == 1)
+        y[i] = dy / dx;
+      else
+        y[i] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type linear_type = 
 {
   "linear", 
@@ -193,6 +222,7 @@ static const gsl_interp_type linear_type =
   &linear_eval_deriv2,
   &linear_eval_integ,
   NULL, /* free, not applicable */
+  &linear_eval_array
 };
 
 const gsl_interp_type * gsl_interp_linear = &linear_type;
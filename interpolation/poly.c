@@ -168,6 +168,7 @@ static const gsl_interp_type polynomial_type = {
   &polynomial_deriv2,
   &polynomial_integ,
   &polynomial_free,
+  NULL                          /* eval_array, evaluated point by point */
 };
 
 const gsl_interp_type *gsl_interp_polynomial = &polynomial_type;
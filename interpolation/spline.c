@@ -192,3 +192,34 @@ gsl_spline_eval_integ (const gsl_spline * spline,
                                 a, b, acc);
 }
 
+
+
+int
+gsl_spline_eval_array (const gsl_spline * spline,
+                       const double x[], size_t n,
+                       gsl_interp_accel * a, double y[])
+{
+  return gsl_interp_eval_array (spline->interp, 
+                                spline->x, spline->y,
+                                x, n, a, y);
+}
+
+int
+gsl_spline_eval_deriv_array (const gsl_spline * spline,
+                             const double x[], size_t n,
+                             gsl_interp_accel * a, double d[])
+{
+  return gsl_interp_eval_deriv_array (spline->interp, 
+                                      spline->x, spline->y,
+                                      x, n, a, d);
+}
+
+int
+gsl_spline_eval_deriv2_array (const gsl_spline * spline,
+                              const double x[], size_t n,
+                              gsl_interp_accel * a, double d2[])
+{
+  return gsl_interp_eval_deriv2_array (spline->interp, 
+                                       spline->x, spline->y,
+                                       x, n, a, d2);
+}
@@ -370,6 +370,37 @@ steffen_copysign(const double x, const double y)
   return x;
 }
 
+/* evaluate a block of points with known intervals, see interp.c */
+
+static int
+steffen_eval_array (const void * vstate,
+                    const double x_array[], const double y_array[],
+                    size_t size, const double x[], const size_t index[],
+                    size_t n, int order, double y[])
+{
+  const steffen_state_t *state = (const steffen_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t k = index[i];
+      const double delx = x[i] - x_array[k];
+      const double a = state->a[k];
+      const double b = state->b[k];
+      const double c = state->c[k];
+      const double d = state->d[k];
+
+      if (order == 0)
+        y[i] = d + delx*(c + delx*(b + delx*a));
+      else if (order == 1)
+        y[i] = c + delx*(2*b + delx*3*a);
+      else
+        y[i] = 6*a*delx + 2*b;
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type steffen_type = 
 {
   "steffen", 
@@ -380,7 +411,8 @@ static const gsl_interp_type steffen_type =
   &steffen_eval_deriv,
   &steffen_eval_deriv2,
   &steffen_eval_integ,
-  &steffen_free
+  &steffen_free,
+  &steffen_eval_array
 };
 
 const gsl_interp_type * gsl_interp_steffen = &steffen_type;
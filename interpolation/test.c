@@ -28,7 +28,9 @@
 #include <math.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_interp.h>
+#include <gsl/gsl_spline.h>
 #include <gsl/gsl_ieee_utils.h>
 
 #include "test2d.c"
@@ -1205,6 +1207,119 @@ test_steffen2 (void)
   return s;
 }
 
+/* compare the array functions with the scalar functions for sorted,
+   reversed and unordered points, including points outside the range */
+
+#define NA_DATA 40
+#define NA_TEST 1000
+
+static int
+test_eval_array (const gsl_interp_type * T)
+{
+  int status = 0;
+  double xa[NA_DATA], ya[NA_DATA];
+  double x[NA_TEST], y[NA_TEST], ys;
+  size_t i, p, order;
+
+  gsl_spline *spline = gsl_spline_alloc (T, NA_DATA);
+  gsl_interp_accel *a = gsl_interp_accel_alloc ();
+
+  for (i = 0; i < NA_DATA; i++)
+    {
+      xa[i] = i + 0.5 * sin (0.7 * i);
+      ya[i] = cos (0.3 * i) + 0.1 * i * (NA_DATA - 1 - i);
+    }
+
+  ya[NA_DATA - 1] = ya[0];      /* for the periodic types */
+
+  gsl_spline_init (spline, xa, ya, NA_DATA);
+
+  for (p = 0; p < 3; p++)
+    {
+      for (i = 0; i < NA_TEST; i++)
+        {
+          double u = (p == 2) ? fmod (0.6180339887498949 * i, 1.0)
+            : (double) i / (NA_TEST - 1);
+
+          if (p == 1)
+            u = 1.0 - u;
+
+          x[i] = xa[0] + u * (xa[NA_DATA - 1] - xa[0]);
+        }
+
+      /* points on the knots, outside the range and repeated */
+
+      x[10] = xa[3];
+      x[11] = xa[3];
+      x[20] = xa[0] - 1.0;
+      x[21] = xa[NA_DATA - 1] + 0.5;
+      x[NA_TEST - 1] = (p == 1) ? xa[0] : xa[NA_DATA - 1];
+
+      for (order = 0; order < 3; order++)
+        {
+          int s, s1, fail = 0;
+
+          gsl_interp_accel_reset (a);
+
+          if (order == 0)
+            s = gsl_spline_eval_array (spline, x, NA_TEST, a, y);
+          else if (order == 1)
+            s = gsl_spline_eval_deriv_array (spline, x, NA_TEST, a, y);
+          else
+            s = gsl_spline_eval_deriv2_array (spline, x, NA_TEST, a, y);
+
+          for (i = 0; i < NA_TEST; i++)
+            {
+              if (order == 0)
+                s1 = gsl_spline_eval_e (spline, x[i], a, &ys);
+              else if (order == 1)
+                s1 = gsl_spline_eval_deriv_e (spline, x[i], a, &ys);
+              else
+                s1 = gsl_spline_eval_deriv2_e (spline, x[i], a, &ys);
+
+              if (s1 == GSL_EDOM)
+                fail |= !gsl_isnan (y[i]);
+              else
+                fail |= (y[i] != ys);
+            }
+
+          fail |= (s != GSL_EDOM);
+
+          gsl_test (fail, "gsl_spline_eval_array %s, order %d, points %d",
+                    gsl_spline_name (spline), (int) order, (int) p);
+
+          status |= fail;
+        }
+    }
+
+  /* points inside the range, without an accelerator */
+
+  {
+    int s;
+
+    for (i = 0; i < NA_TEST; i++)
+      x[i] = xa[0] + fmod (0.7548776662466927 * i, 1.0) * (xa[NA_DATA - 1] - xa[0]);
+
+    s = gsl_interp_eval_array (spline->interp, xa, ya, x, NA_TEST, NULL, y);
+
+    for (i = 0; i < NA_TEST; i++)
+      {
+        if (y[i] != gsl_interp_eval (spline->interp, xa, ya, x[i], NULL))
+          s = 1;
+      }
+
+    gsl_test (s, "gsl_interp_eval_array %s without accelerator",
+              gsl_spline_name (spline));
+
+    status |= s;
+  }
+
+  gsl_interp_accel_free (a);
+  gsl_spline_free (spline);
+
+  return status;
+}
+
 int 
 main (int argc, char **argv)
 {
@@ -1227,6 +1342,14 @@ main (int argc, char **argv)
   status += test_steffen1();
   status += test_steffen2();
 
+  status += test_eval_array (gsl_interp_linear);
+  status += test_eval_array (gsl_interp_polynomial);
+  status += test_eval_array (gsl_interp_cspline);
+  status += test_eval_array (gsl_interp_cspline_periodic);
+  status += test_eval_array (gsl_interp_akima);
+  status += test_eval_array (gsl_interp_akima_periodic);
+  status += test_eval_array (gsl_interp_steffen);
+
   status += test_interp2d_main();
 
   exit (gsl_test_summary());
@@ -199,6 +199,33 @@ double gsl_linalg_LU_det (gsl_matrix * LU, int signum);
 double gsl_linalg_LU_lndet (gsl_matrix * LU);
 int gsl_linalg_LU_sgndet (gsl_matrix * lu, int signum);
 
+/* Mixed precision LU solver: single precision factorization with
+ * iterative refinement in double precision */
+
+typedef struct
+{
+  size_t n;                  /* size of system */
+  gsl_matrix_float * LU;     /* single precision LU factors */
+  gsl_matrix * LUd;          /* double precision LU factors, allocated on fallback */
+  gsl_permutation * p;       /* row permutation */
+  gsl_vector * r;            /* residual vector, double precision */
+  gsl_vector_float * d;      /* correction vector, single precision */
+  gsl_vector * work;         /* workspace for condition estimate, size 3*n */
+  double Anorm1;             /* ||A||_1 */
+  double Anorminf;           /* ||A||_inf */
+  double rcond;              /* reciprocal condition number estimate of single precision factors */
+  double rcond_min;          /* fall back to double precision if rcond < rcond_min */
+  size_t maxiter;            /* maximum number of refinement iterations */
+  size_t niter;              /* number of refinement iterations in last solve */
+  int fallback;              /* 1 if double precision factorization is in use */
+} gsl_linalg_LU_mixed_workspace;
+
+gsl_linalg_LU_mixed_workspace * gsl_linalg_LU_mixed_alloc (const size_t n);
+void gsl_linalg_LU_mixed_free (gsl_linalg_LU_mixed_workspace * w);
+int gsl_linalg_LU_mixed_decomp (const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w);
+int gsl_linalg_LU_mixed_solve (const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w,
+                               const gsl_vector * b, gsl_vector * x);
+
 /* Complex LU Decomposition */
 
 int gsl_linalg_complex_LU_decomp (gsl_matrix_complex * A, 
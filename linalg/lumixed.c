@@ -0,0 +1,515 @@
+/* linalg/lumixed.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_permute_vector.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * This module solves a general square system A x = b using mixed
+ * precision iterative refinement. The matrix is factored in single
+ * precision, P A = L U, and the solution is then refined in double
+ * precision,
+ *
+ *   r = b - A x        (double)
+ *   L U d = P r        (single)
+ *   x = x + d          (double)
+ *
+ * until the residual satisfies the same backward error criterion
+ * as a double precision solve. The single precision factorization
+ * needs half the memory traffic of the double one. If the condition
+ * number estimate of the single precision factors indicates that the
+ * refinement will not converge, or if the refinement fails to converge
+ * in practice, the solver falls back to a double precision LU
+ * factorization of A.
+ *
+ * The algorithm follows LAPACK routine DSGESV and
+ *
+ * [1] J. Langou et al, "Exploiting the performance of 32 bit floating
+ * point arithmetic in obtaining 64 bit accuracy", Proceedings of the
+ * 2006 ACM/IEEE Conference on Supercomputing, 2006.
+ */
+
+/* block size for single precision factorization */
+#define LU_MIXED_BLOCK     32
+
+/* maximum number of refinement iterations */
+#define LU_MIXED_MAXITER   30
+
+static int lu_mixed_decomp_float(gsl_matrix_float * A, gsl_permutation * p);
+static int lu_mixed_svx_float(CBLAS_TRANSPOSE_t TransA, const gsl_matrix_float * LU,
+                              const gsl_permutation * p, gsl_vector_float * x);
+static int lu_mixed_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
+static int lu_mixed_fallback(const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w);
+static double lu_mixed_norm(const gsl_matrix * A, const int norm1);
+
+gsl_linalg_LU_mixed_workspace *
+gsl_linalg_LU_mixed_alloc(const size_t n)
+{
+  gsl_linalg_LU_mixed_workspace *w;
+
+  w = calloc(1, sizeof(gsl_linalg_LU_mixed_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->LU = gsl_matrix_float_alloc(n, n);
+  if (w->LU == 0)
+    {
+      gsl_linalg_LU_mixed_free(w);
+      GSL_ERROR_NULL("failed to allocate space for LU factors", GSL_ENOMEM);
+    }
+
+  w->p = gsl_permutation_alloc(n);
+  if (w->p == 0)
+    {
+      gsl_linalg_LU_mixed_free(w);
+      GSL_ERROR_NULL("failed to allocate space for permutation", GSL_ENOMEM);
+    }
+
+  w->r = gsl_vector_alloc(n);
+  if (w->r == 0)
+    {
+      gsl_linalg_LU_mixed_free(w);
+      GSL_ERROR_NULL("failed to allocate space for residual", GSL_ENOMEM);
+    }
+
+  w->d = gsl_vector_float_alloc(n);
+  if (w->d == 0)
+    {
+      gsl_linalg_LU_mixed_free(w);
+      GSL_ERROR_NULL("failed to allocate space for correction", GSL_ENOMEM);
+    }
+
+  w->work = gsl_vector_alloc(3 * n);
+  if (w->work == 0)
+    {
+      gsl_linalg_LU_mixed_free(w);
+      GSL_ERROR_NULL("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  /* the double precision factors are only allocated on fallback */
+  w->LUd = NULL;
+
+  w->n = n;
+  w->maxiter = LU_MIXED_MAXITER;
+  w->rcond_min = 16.0 * GSL_FLT_EPSILON;
+  w->rcond = 0.0;
+  w->niter = 0;
+  w->fallback = 0;
+
+  return w;
+}
+
+void
+gsl_linalg_LU_mixed_free(gsl_linalg_LU_mixed_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->LU)
+    gsl_matrix_float_free(w->LU);
+
+  if (w->LUd)
+    gsl_matrix_free(w->LUd);
+
+  if (w->p)
+    gsl_permutation_free(w->p);
+
+  if (w->r)
+    gsl_vector_free(w->r);
+
+  if (w->d)
+    gsl_vector_float_free(w->d);
+
+  if (w->work)
+    gsl_vector_free(w->work);
+
+  free(w);
+}
+
+/*
+gsl_linalg_LU_mixed_decomp()
+  Factor A in single precision and estimate the reciprocal condition
+number of the factors. If the estimate indicates that iterative refinement
+will not converge, A is factored in double precision instead.
+
+Inputs: A - N-by-N matrix (not modified)
+        w - workspace
+
+Return: success/error
+*/
+
+int
+gsl_linalg_LU_mixed_decomp(const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w)
+{
+  const size_t N = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("LU decomposition requires square matrix", GSL_ENOTSQR);
+    }
+  else if (A->size1 != N)
+    {
+      GSL_ERROR ("matrix size must match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      int too_large = 0;
+      double Ainvnorm;
+      size_t i, j;
+
+      w->fallback = 0;
+      w->niter = 0;
+      w->rcond = 0.0;
+      w->Anorm1 = lu_mixed_norm(A, 1);
+      w->Anorminf = lu_mixed_norm(A, 0);
+
+      /* convert A to single precision */
+      for (i = 0; i < N; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              double aij = gsl_matrix_get(A, i, j);
+
+              if (fabs(aij) > GSL_FLT_MAX)
+                too_large = 1;
+
+              gsl_matrix_float_set(w->LU, i, j, (float) aij);
+            }
+        }
+
+      if (too_large)
+        {
+          /* A cannot be represented in single precision */
+          return lu_mixed_fallback(A, w);
+        }
+
+      status = lu_mixed_decomp_float(w->LU, w->p);
+      if (status)
+        return status;
+
+      for (i = 0; i < N; ++i)
+        {
+          if (gsl_matrix_float_get(w->LU, i, i) == 0.0f)
+            {
+              /* U is exactly singular in single precision */
+              return lu_mixed_fallback(A, w);
+            }
+        }
+
+      if (w->Anorm1 == 0.0)
+        return GSL_SUCCESS;
+
+      /* estimate ||A^{-1}||_1 from the single precision factors */
+      status = gsl_linalg_invnorm1(N, lu_mixed_Ainv, w, &Ainvnorm, w->work);
+      if (status)
+        return status;
+
+      if (Ainvnorm != 0.0)
+        w->rcond = (1.0 / w->Anorm1) / Ainvnorm;
+
+      if (w->rcond < w->rcond_min)
+        {
+          /* refinement is not expected to converge */
+          return lu_mixed_fallback(A, w);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_LU_mixed_solve()
+  Solve A x = b using the factorization computed by
+gsl_linalg_LU_mixed_decomp() and iterative refinement in double precision
+
+Inputs: A - original N-by-N matrix
+        w - workspace containing factorization
+        b - right hand side vector, length N
+        x - (output) solution vector, length N
+
+Return: success/error
+
+Notes:
+1) On output, w->niter contains the number of refinement iterations
+performed and w->fallback is set if a double precision factorization
+was used
+*/
+
+int
+gsl_linalg_LU_mixed_solve(const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w,
+                          const gsl_vector * b, gsl_vector * x)
+{
+  const size_t N = w->n;
+
+  if (A->size1 != N || A->size2 != N)
+    {
+      GSL_ERROR ("matrix size must match workspace", GSL_EBADLEN);
+    }
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      const double cte = w->Anorminf * GSL_DBL_EPSILON * sqrt((double) N);
+      int status;
+      size_t i, iter;
+
+      w->niter = 0;
+
+      if (!w->fallback)
+        {
+          /* x = (L U)^{-1} P b in single precision */
+          for (i = 0; i < N; ++i)
+            gsl_vector_float_set(w->d, i, (float) gsl_vector_get(b, i));
+
+          status = lu_mixed_svx_float(CblasNoTrans, w->LU, w->p, w->d);
+          if (status)
+            return status;
+
+          for (i = 0; i < N; ++i)
+            gsl_vector_set(x, i, (double) gsl_vector_float_get(w->d, i));
+
+          for (iter = 0; iter <= w->maxiter; ++iter)
+            {
+              double xnorm, rnorm;
+
+              /* r = b - A x in double precision */
+              gsl_vector_memcpy(w->r, b);
+              gsl_blas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, w->r);
+
+              xnorm = fabs(gsl_vector_get(x, gsl_blas_idamax(x)));
+              rnorm = fabs(gsl_vector_get(w->r, gsl_blas_idamax(w->r)));
+
+              if (rnorm <= xnorm * cte)
+                return GSL_SUCCESS;
+
+              if (iter == w->maxiter)
+                break;
+
+              /* d = (L U)^{-1} P r in single precision */
+              for (i = 0; i < N; ++i)
+                gsl_vector_float_set(w->d, i, (float) gsl_vector_get(w->r, i));
+
+              status = lu_mixed_svx_float(CblasNoTrans, w->LU, w->p, w->d);
+              if (status)
+                return status;
+
+              /* x = x + d */
+              for (i = 0; i < N; ++i)
+                {
+                  double *xi = gsl_vector_ptr(x, i);
+                  *xi += (double) gsl_vector_float_get(w->d, i);
+                }
+
+              ++(w->niter);
+            }
+
+          /* refinement did not converge, factor A in double precision */
+          status = lu_mixed_fallback(A, w);
+          if (status)
+            return status;
+        }
+
+      status = gsl_linalg_LU_solve(w->LUd, w->p, b, x);
+      if (status)
+        return status;
+
+      /* one step of refinement with the double precision factors */
+      status = gsl_linalg_LU_refine(A, w->LUd, w->p, b, x, w->r);
+
+      return status;
+    }
+}
+
+/*
+lu_mixed_fallback()
+  Compute double precision LU factorization of A, allocating
+the storage if needed
+*/
+
+static int
+lu_mixed_fallback(const gsl_matrix * A, gsl_linalg_LU_mixed_workspace * w)
+{
+  int signum;
+
+  if (w->LUd == NULL)
+    {
+      w->LUd = gsl_matrix_alloc(w->n, w->n);
+      if (w->LUd == NULL)
+        {
+          GSL_ERROR("failed to allocate space for double precision LU", GSL_ENOMEM);
+        }
+    }
+
+  w->fallback = 1;
+  gsl_matrix_memcpy(w->LUd, A);
+
+  return gsl_linalg_LU_decomp(w->LUd, w->p, &signum);
+}
+
+/*
+lu_mixed_decomp_float()
+  Blocked right-looking LU decomposition with partial pivoting
+in single precision. Panels of LU_MIXED_BLOCK columns are factored
+with level 2 operations and the trailing matrix is updated with
+strsm and sgemm.
+*/
+
+static int
+lu_mixed_decomp_float(gsl_matrix_float * A, gsl_permutation * p)
+{
+  const size_t N = A->size1;
+  size_t j0, j;
+
+  gsl_permutation_init(p);
+
+  for (j0 = 0; j0 < N; j0 += LU_MIXED_BLOCK)
+    {
+      const size_t nb = GSL_MIN(LU_MIXED_BLOCK, N - j0);
+      const size_t jend = j0 + nb;
+
+      /* factor panel A(j0:N-1, j0:jend-1) */
+      for (j = j0; j < jend; ++j)
+        {
+          gsl_vector_float_view c = gsl_matrix_float_subcolumn(A, j, j, N - j);
+          size_t i_pivot = j + gsl_blas_isamax(&c.vector);
+          float ajj;
+
+          if (i_pivot != j)
+            {
+              gsl_matrix_float_swap_rows(A, j, i_pivot);
+              gsl_permutation_swap(p, j, i_pivot);
+            }
+
+          ajj = gsl_matrix_float_get(A, j, j);
+
+          if (ajj != 0.0f && j < N - 1)
+            {
+              gsl_vector_float_view v = gsl_matrix_float_subcolumn(A, j, j + 1, N - j - 1);
+
+              gsl_blas_sscal(1.0f / ajj, &v.vector);
+
+              if (j + 1 < jend)
+                {
+                  gsl_vector_float_view u = gsl_matrix_float_subrow(A, j, j + 1, jend - j - 1);
+                  gsl_matrix_float_view m = gsl_matrix_float_submatrix(A, j + 1, j + 1, N - j - 1, jend - j - 1);
+
+                  gsl_blas_sger(-1.0f, &v.vector, &u.vector, &m.matrix);
+                }
+            }
+        }
+
+      if (jend < N)
+        {
+          gsl_matrix_float_view L11 = gsl_matrix_float_submatrix(A, j0, j0, nb, nb);
+          gsl_matrix_float_view A12 = gsl_matrix_float_submatrix(A, j0, jend, nb, N - jend);
+          gsl_matrix_float_view A21 = gsl_matrix_float_submatrix(A, jend, j0, N - jend, nb);
+          gsl_matrix_float_view A22 = gsl_matrix_float_submatrix(A, jend, jend, N - jend, N - jend);
+
+          /* A12 := L11^{-1} A12 */
+          gsl_blas_strsm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0f,
+                         &L11.matrix, &A12.matrix);
+
+          /* A22 := A22 - A21 A12 */
+          gsl_blas_sgemm(CblasNoTrans, CblasNoTrans, -1.0f, &A21.matrix, &A12.matrix,
+                         1.0f, &A22.matrix);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* solve op(A) x = b in single precision using P A = L U */
+static int
+lu_mixed_svx_float(CBLAS_TRANSPOSE_t TransA, const gsl_matrix_float * LU,
+                   const gsl_permutation * p, gsl_vector_float * x)
+{
+  if (TransA == CblasNoTrans)
+    {
+      gsl_permute_vector_float(p, x);
+      gsl_blas_strsv(CblasLower, CblasNoTrans, CblasUnit, LU, x);
+      gsl_blas_strsv(CblasUpper, CblasNoTrans, CblasNonUnit, LU, x);
+    }
+  else
+    {
+      /* A^T = U^T L^T P */
+      gsl_blas_strsv(CblasUpper, CblasTrans, CblasNonUnit, LU, x);
+      gsl_blas_strsv(CblasLower, CblasTrans, CblasUnit, LU, x);
+      gsl_permute_vector_float_inverse(p, x);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* compute x := A^{-1} x or A^{-T} x using the single precision factors */
+static int
+lu_mixed_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params)
+{
+  gsl_linalg_LU_mixed_workspace * w = (gsl_linalg_LU_mixed_workspace *) params;
+  const size_t N = x->size;
+  size_t i;
+  int status;
+
+  for (i = 0; i < N; ++i)
+    gsl_vector_float_set(w->d, i, (float) gsl_vector_get(x, i));
+
+  status = lu_mixed_svx_float(TransA, w->LU, w->p, w->d);
+
+  for (i = 0; i < N; ++i)
+    gsl_vector_set(x, i, (double) gsl_vector_float_get(w->d, i));
+
+  return status;
+}
+
+/* compute ||A||_1 (norm1 = 1) or ||A||_inf (norm1 = 0) */
+static double
+lu_mixed_norm(const gsl_matrix * A, const int norm1)
+{
+  const size_t N = A->size1;
+  double max = 0.0;
+  size_t i, j;
+
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < N; ++j)
+        {
+          double a = norm1 ? gsl_matrix_get(A, j, i) : gsl_matrix_get(A, i, j);
+          sum += fabs(a);
+        }
+
+      max = GSL_MAX(max, sum);
+    }
+
+  return max;
+}
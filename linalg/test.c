@@ -493,6 +493,109 @@ int test_LU_solve(void)
   return s;
 }
 
+static int
+test_LU_mixed_eps(const gsl_matrix * m, const gsl_vector * sol, const int fallback,
+                  const double eps, const char * desc)
+{
+  int s = 0;
+  size_t N = m->size1;
+  gsl_linalg_LU_mixed_workspace * w = gsl_linalg_LU_mixed_alloc(N);
+  gsl_vector * rhs = gsl_vector_alloc(N);
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_vector * r = gsl_vector_alloc(N);
+  double xnorm, rnorm, err;
+
+  /* rhs = m * sol */
+  gsl_blas_dgemv(CblasNoTrans, 1.0, m, sol, 0.0, rhs);
+
+  s += gsl_linalg_LU_mixed_decomp(m, w);
+  s += gsl_linalg_LU_mixed_solve(m, w, rhs, x);
+
+  /* backward error: ||b - A x|| / (||A|| ||x||) */
+  gsl_vector_memcpy(r, rhs);
+  gsl_blas_dgemv(CblasNoTrans, -1.0, m, x, 1.0, r);
+  xnorm = fabs(gsl_vector_get(x, gsl_blas_idamax(x)));
+  rnorm = fabs(gsl_vector_get(r, gsl_blas_idamax(r)));
+  err = rnorm / (w->Anorminf * xnorm);
+
+  gsl_test(!(err < N * GSL_DBL_EPSILON), "%s: %3lu backward error %e",
+           desc, N, err);
+
+  /* forward error: ||x - sol|| / ||sol|| */
+  if (eps > 0.0)
+    {
+      gsl_vector_sub(x, sol);
+      err = fabs(gsl_vector_get(x, gsl_blas_idamax(x))) /
+            fabs(gsl_vector_get(sol, gsl_blas_idamax(sol)));
+
+      gsl_test(!(err < eps), "%s: %3lu forward error %e", desc, N, err);
+    }
+
+  if (fallback >= 0)
+    {
+      gsl_test(w->fallback != fallback, "%s: %3lu fallback %d expected %d",
+               desc, N, w->fallback, fallback);
+    }
+
+  gsl_vector_free(r);
+  gsl_vector_free(x);
+  gsl_vector_free(rhs);
+  gsl_linalg_LU_mixed_free(w);
+
+  return s;
+}
+
+static int
+test_LU_mixed(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 80;
+  size_t N;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * sol = gsl_vector_alloc(N);
+      size_t i;
+
+      /* diagonally dominant matrix: refinement must converge in single precision */
+      create_random_matrix(m, r);
+      for (i = 0; i < N; ++i)
+        {
+          double *mii = gsl_matrix_ptr(m, i, i);
+          *mii += (double) N;
+        }
+
+      create_random_vector(sol, r);
+
+      s += test_LU_mixed_eps(m, sol, 0, 64.0 * N * GSL_DBL_EPSILON, "LU_mixed random");
+
+      gsl_matrix_free(m);
+      gsl_vector_free(sol);
+    }
+
+  {
+    /* ill-conditioned matrix: refinement must fall back to double precision */
+    gsl_vector * sol = gsl_vector_alloc(hilb12->size1);
+
+    create_random_vector(sol, r);
+    s += test_LU_mixed_eps(hilb12, sol, 1, -1.0, "LU_mixed hilbert(12)");
+
+    gsl_vector_free(sol);
+  }
+
+  {
+    gsl_vector * sol = gsl_vector_alloc(hilb4->size1);
+
+    create_random_vector(sol, r);
+    s += test_LU_mixed_eps(hilb4, sol, -1, 1.0e5 * GSL_DBL_EPSILON, "LU_mixed hilbert(4)");
+
+    gsl_vector_free(sol);
+  }
+
+  return s;
+}
+
 
 int
 test_LUc_solve_dim(const gsl_matrix_complex * m, const double * actual, double eps)
@@ -4408,6 +4511,7 @@ main(void)
 
   gsl_test(test_bidiag_decomp(),         "Bidiagonal Decomposition");
   gsl_test(test_LU_solve(),              "LU Decomposition and Solve");
+  gsl_test(test_LU_mixed(r),             "Mixed precision LU Solve");
   gsl_test(test_LUc_solve(),             "Complex LU Decomposition and Solve");
   gsl_test(test_QR_decomp(),             "QR Decomposition");
   gsl_test(test_QR_solve(),              "QR Solve");
@@ -26,6 +26,7 @@
 #include <gsl/gsl_rng.h>
 
 static int create_random_vector(gsl_vector * v, gsl_rng * r);
+static int create_random_matrix(gsl_matrix * m, gsl_rng * r);
 static int create_posdef_matrix(gsl_matrix * m, gsl_rng * r);
 static int create_hilbert_matrix2(gsl_matrix * m);
 
@@ -44,6 +45,25 @@ create_random_vector(gsl_vector * v, gsl_rng * r)
   return GSL_SUCCESS;
 }
 
+static int
+create_random_matrix(gsl_matrix * m, gsl_rng * r)
+{
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+  size_t i, j;
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double mij = gsl_rng_uniform(r);
+          gsl_matrix_set(m, i, j, mij);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
 static int
 create_symm_matrix(gsl_matrix * m, gsl_rng * r)
 {
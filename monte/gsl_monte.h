@@ -49,6 +49,21 @@ typedef struct gsl_monte_function_struct gsl_monte_function;
 
 #define GSL_MONTE_FN_EVAL(F,x) (*((F)->f))(x,(F)->dim,(F)->params)
 
+/* Batched integrand, which evaluates the function at npoints points
+   stored one after another in x[] (npoints * dim values) and writes
+   the values to fval[]. */
+
+struct gsl_monte_function_vec_struct {
+  void (*f)(const double * x, size_t npoints, size_t dim, void * params,
+            double * fval);
+  size_t dim;
+  void * params;
+};
+
+typedef struct gsl_monte_function_vec_struct gsl_monte_function_vec;
+
+#define GSL_MONTE_FN_VEC_EVAL(F,x,n,fval) (*((F)->f))(x,n,(F)->dim,(F)->params,fval)
+
 
 __END_DECLS
 
@@ -72,6 +72,13 @@ int gsl_monte_miser_integrate(gsl_monte_function * f,
                               gsl_monte_miser_state* state,
                               double *result, double *abserr);
 
+int gsl_monte_miser_integrate_vec(const gsl_monte_function_vec * f, 
+                                  const double xl[], const double xh[], 
+                                  size_t dim, size_t calls, 
+                                  gsl_rng *r, 
+                                  gsl_monte_miser_state* state,
+                                  double *result, double *abserr);
+
 gsl_monte_miser_state* gsl_monte_miser_alloc(size_t dim);
 
 int gsl_monte_miser_init(gsl_monte_miser_state* state);
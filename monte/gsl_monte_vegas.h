@@ -84,10 +84,28 @@ typedef struct {
   unsigned int samples;
   unsigned int calls_per_box;
 
+  /* results accumulated since the start of the current call */
+  unsigned int it_count;
+  double cum_int;
+  double cum_sig;
+
   FILE * ostream;
 
 } gsl_monte_vegas_state;
 
+/* partial sums from sampling a range of boxes in one iteration */
+
+typedef struct {
+  size_t dim;
+  double * d;       /* distribution */
+  double intgrl;    /* sum of the integral estimates of the boxes */
+  double tss;       /* sum of the variance estimates of the boxes */
+
+  double * x;
+  int * bin;
+  int * box;
+} gsl_monte_vegas_partial;
+
 int gsl_monte_vegas_integrate(gsl_monte_function * f, 
                               double xl[], double xu[], 
                               size_t dim, size_t calls,
@@ -95,6 +113,40 @@ int gsl_monte_vegas_integrate(gsl_monte_function * f,
                               gsl_monte_vegas_state *state,
                               double* result, double* abserr);
 
+int gsl_monte_vegas_integrate_vec (const gsl_monte_function_vec * f, 
+                                   double xl[], double xu[], 
+                                   size_t dim, size_t calls,
+                                   gsl_rng * r,
+                                   gsl_monte_vegas_state *state,
+                                   double* result, double* abserr);
+
+int gsl_monte_vegas_begin (double xl[], double xu[],
+                           size_t dim, size_t calls,
+                           gsl_monte_vegas_state * state,
+                           size_t * nboxes);
+
+int gsl_monte_vegas_sample (gsl_monte_function * f,
+                            double xl[], double xu[],
+                            gsl_rng * r,
+                            const gsl_monte_vegas_state * state,
+                            size_t first_box, size_t nboxes,
+                            gsl_monte_vegas_partial * p);
+
+int gsl_monte_vegas_sample_vec (const gsl_monte_function_vec * f,
+                                double xl[], double xu[],
+                                gsl_rng * r,
+                                const gsl_monte_vegas_state * state,
+                                size_t first_box, size_t nboxes,
+                                gsl_monte_vegas_partial * p);
+
+int gsl_monte_vegas_end (gsl_monte_vegas_state * state,
+                         gsl_monte_vegas_partial * p[], size_t n,
+                         double * result, double * abserr);
+
+gsl_monte_vegas_partial * gsl_monte_vegas_partial_alloc (size_t dim);
+
+void gsl_monte_vegas_partial_free (gsl_monte_vegas_partial * p);
+
 gsl_monte_vegas_state* gsl_monte_vegas_alloc(size_t dim);
 
 int gsl_monte_vegas_init(gsl_monte_vegas_state* state);
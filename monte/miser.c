@@ -39,14 +39,34 @@
 #include <gsl/gsl_monte.h>
 #include <gsl/gsl_monte_miser.h>
 
+/* number of points evaluated in each call of a batched integrand */
+#define BLOCK_SIZE 256
+
+/* The integrand is either f, evaluated one point at a time, or fv,
+   evaluated in blocks of points stored in xb[] with values in fb[].
+   The points are drawn in the same order in both cases, so the
+   results are identical. */
+
+static int
+miser_integrate (gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
+                 const double xl[], const double xu[],
+                 size_t dim, size_t calls,
+                 gsl_rng * r,
+                 gsl_monte_miser_state * state,
+                 double *result, double *abserr,
+                 double xb[], double fb[]);
+
 static int
 estimate_corrmc (gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
                  const double xl[], const double xu[],
                  size_t dim, size_t calls,
                  gsl_rng * r,
                  gsl_monte_miser_state * state,
                  double *result, double *abserr,
-                 const double xmid[], double sigma_l[], double sigma_r[]);
+                 const double xmid[], double sigma_l[], double sigma_r[],
+                 double xb[], double fb[]);
 
 
 int
@@ -56,6 +76,48 @@ gsl_monte_miser_integrate (gsl_monte_function * f,
                            gsl_rng * r,
                            gsl_monte_miser_state * state,
                            double *result, double *abserr)
+{
+  return miser_integrate (f, NULL, xl, xu, dim, calls, r, state,
+                          result, abserr, NULL, NULL);
+}
+
+int
+gsl_monte_miser_integrate_vec (const gsl_monte_function_vec * f,
+                               const double xl[], const double xu[],
+                               size_t dim, size_t calls,
+                               gsl_rng * r,
+                               gsl_monte_miser_state * state,
+                               double *result, double *abserr)
+{
+  int status;
+  double *xb = (double *) malloc (BLOCK_SIZE * dim * sizeof (double));
+  double *fb = (double *) malloc (BLOCK_SIZE * sizeof (double));
+
+  if (xb == 0 || fb == 0)
+    {
+      free (xb);
+      free (fb);
+      GSL_ERROR ("failed to allocate space for block of points", GSL_ENOMEM);
+    }
+
+  status = miser_integrate (NULL, f, xl, xu, dim, calls, r, state,
+                            result, abserr, xb, fb);
+
+  free (xb);
+  free (fb);
+
+  return status;
+}
+
+static int
+miser_integrate (gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
+                 const double xl[], const double xu[],
+                 size_t dim, size_t calls,
+                 gsl_rng * r,
+                 gsl_monte_miser_state * state,
+                 double *result, double *abserr,
+                 double xb[], double fb[])
 {
   size_t n, estimate_calls, calls_l, calls_r;
   const size_t min_calls = state->min_calls;
@@ -110,30 +172,67 @@ gsl_monte_miser_integrate (gsl_monte_function * f,
   if (calls < state->min_calls_per_bisection)
     {
       double m = 0.0, q = 0.0;
+      size_t block;
 
       if (calls < 2)
         {
           GSL_ERROR ("insufficient calls for subvolume", GSL_EFAILED);
         }
 
-      for (n = 0; n < calls; n++)
+      block = (fv != NULL) ? BLOCK_SIZE : 1;
+
+      for (n = 0; n < calls; n += block)
         {
-          /* Choose a random point in the integration region */
+          const size_t nb = GSL_MIN (block, calls - n);
+          size_t k;
 
-          for (i = 0; i < dim; i++)
+          if (fv != NULL)
             {
-              x[i] = xl[i] + gsl_rng_uniform_pos (r) * (xu[i] - xl[i]);
+              /* Choose a block of random points in the integration region */
+
+              gsl_rng_uniform_pos_array (r, xb, nb * dim);
+
+              for (k = 0; k < nb; k++)
+                {
+                  double *xk = xb + k * dim;
+
+                  for (i = 0; i < dim; i++)
+                    {
+                      xk[i] = xl[i] + xk[i] * (xu[i] - xl[i]);
+                    }
+                }
+
+              GSL_MONTE_FN_VEC_EVAL (fv, xb, nb, fb);
             }
 
-          {
-            double fval = GSL_MONTE_FN_EVAL (f, x);
+          for (k = 0; k < nb; k++)
+            {
+              double fval;
 
-            /* recurrence for mean and variance */
+              if (fv != NULL)
+                {
+                  fval = fb[k];
+                }
+              else
+                {
+                  /* Choose a random point in the integration region */
 
-            double d = fval - m;
-            m += d / (n + 1.0);
-            q += d * d * (n / (n + 1.0));
-          }
+                  for (i = 0; i < dim; i++)
+                    {
+                      x[i] = xl[i] + gsl_rng_uniform_pos (r) * (xu[i] - xl[i]);
+                    }
+
+                  fval = GSL_MONTE_FN_EVAL (f, x);
+                }
+
+              /* recurrence for mean and variance */
+
+              {
+                double d = fval - m;
+                m += d / (n + k + 1.0);
+                q += d * d * ((n + k) / (n + k + 1.0));
+              }
+            }
         }
 
       *result = vol * m;
@@ -164,8 +263,9 @@ gsl_monte_miser_integrate (gsl_monte_function * f,
      the variances by finding the min and max function values 
      for each half-region for each bisection. */
 
-  estimate_corrmc (f, xl, xu, dim, estimate_calls,
-                   r, state, &res_est, &err_est, xmid, sigma_l, sigma_r);
+  estimate_corrmc (f, fv, xl, xu, dim, estimate_calls,
+                   r, state, &res_est, &err_est, xmid, sigma_l, sigma_r,
+                   xb, fb);
 
   /* We have now used up some calls for the estimation */
 
@@ -263,9 +363,9 @@ gsl_monte_miser_integrate (gsl_monte_function * f,
 
     xu_tmp[i_bisect] = xbi_m;
 
-    status = gsl_monte_miser_integrate (f, xl, xu_tmp,
-                                        dim, calls_l, r, state,
-                                        &res_l, &err_l);
+    status = miser_integrate (f, fv, xl, xu_tmp,
+                              dim, calls_l, r, state,
+                              &res_l, &err_l, xb, fb);
     free (xu_tmp);
 
     if (status != GSL_SUCCESS)
@@ -293,9 +393,9 @@ gsl_monte_miser_integrate (gsl_monte_function * f,
 
     xl_tmp[i_bisect] = xbi_m;
 
-    status = gsl_monte_miser_integrate (f, xl_tmp, xu,
-                                        dim, calls_r, r, state,
-                                        &res_r, &err_r);
+    status = miser_integrate (f, fv, xl_tmp, xu,
+                              dim, calls_r, r, state,
+                              &res_r, &err_r, xb, fb);
     free (xl_tmp);
 
     if (status != GSL_SUCCESS)
@@ -590,16 +690,18 @@ gsl_monte_miser_params_set (gsl_monte_miser_state * s, const gsl_monte_miser_par
 
 static int
 estimate_corrmc (gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
                  const double xl[], const double xu[],
                  size_t dim, size_t calls,
                  gsl_rng * r,
                  gsl_monte_miser_state * state,
                  double *result, double *abserr,
-                 const double xmid[], double sigma_l[], double sigma_r[])
+                 const double xmid[], double sigma_l[], double sigma_r[],
+                 double xb[], double fb[])
 {
-  size_t i, n;
+  const size_t block = (fv != NULL) ? BLOCK_SIZE : 1;
+  size_t i, n, k;
   
-  double *x = state->x;
   double *fsum_l = state->fsum_l;
   double *fsum_r = state->fsum_r;
   double *fsum2_l = state->fsum2_l;
@@ -610,6 +712,10 @@ estimate_corrmc (gsl_monte_function * f,
   double m = 0.0, q = 0.0; 
   double vol = 1.0;
 
+  /* function values, a single value when evaluating f */
+  double fval1;
+  double *fvals = (fv != NULL) ? fb : &fval1;
+
   for (i = 0; i < dim; i++)
     {
       vol *= xu[i] - xl[i];
@@ -619,57 +725,81 @@ estimate_corrmc (gsl_monte_function * f,
       sigma_l[i] = sigma_r[i] = -1;
     }
 
-  for (n = 0; n < calls; n++)
+  for (n = 0; n < calls; n += block)
     {
-      double fval;
-      
-      unsigned int j = (n/2) % dim;
-      unsigned int side = (n % 2);
+      const size_t nb = GSL_MIN (block, calls - n);
+      double *x = (fv != NULL) ? xb : state->x;
 
-      for (i = 0; i < dim; i++)
+      if (fv != NULL)
         {
-          double z = gsl_rng_uniform_pos (r) ;
+          gsl_rng_uniform_pos_array (r, xb, nb * dim);
+        }
 
-          if (i != j) 
-            {
-              x[i] = xl[i] + z * (xu[i] - xl[i]);
-            }
-          else
+      for (k = 0; k < nb; k++)
+        {
+          double *xk = x + k * dim;
+          unsigned int j = ((n + k)/2) % dim;
+          unsigned int side = ((n + k) % 2);
+
+          for (i = 0; i < dim; i++)
             {
-              if (side == 0) 
+              double z = (fv != NULL) ? xk[i] : gsl_rng_uniform_pos (r);
+
+              if (i != j) 
                 {
-                  x[i] = xmid[i] + z * (xu[i] - xmid[i]);
+                  xk[i] = xl[i] + z * (xu[i] - xl[i]);
                 }
               else
                 {
-                  x[i] = xl[i] + z * (xmid[i] - xl[i]);
+                  if (side == 0) 
+                    {
+                      xk[i] = xmid[i] + z * (xu[i] - xmid[i]);
+                    }
+                  else
+                    {
+                      xk[i] = xl[i] + z * (xmid[i] - xl[i]);
+                    }
                 }
             }
-        }
 
-      fval = GSL_MONTE_FN_EVAL (f, x);
+          if (fv == NULL)
+            {
+              fvals[k] = GSL_MONTE_FN_EVAL (f, xk);
+            }
+        }
 
-      /* recurrence for mean and variance */
-      {
-        double d = fval - m;
-        m += d / (n + 1.0);
-        q += d * d * (n / (n + 1.0));
-      }
+      if (fv != NULL)
+        {
+          GSL_MONTE_FN_VEC_EVAL (fv, xb, nb, fb);
+        }
 
-      /* compute the variances on each side of the bisection */
-      for (i = 0; i < dim; i++)
+      for (k = 0; k < nb; k++)
         {
-          if (x[i] <= xmid[i])
-            {
-              fsum_l[i] += fval;
-              fsum2_l[i] += fval * fval;
-              hits_l[i]++;
-            }
-          else
+          const double *xk = x + k * dim;
+          const double fval = fvals[k];
+
+          /* recurrence for mean and variance */
+          {
+            double d = fval - m;
+            m += d / (n + k + 1.0);
+            q += d * d * ((n + k) / (n + k + 1.0));
+          }
+
+          /* compute the variances on each side of the bisection */
+          for (i = 0; i < dim; i++)
             {
-              fsum_r[i] += fval;
-              fsum2_r[i] += fval * fval;
-              hits_r[i]++;
+              if (xk[i] <= xmid[i])
+                {
+                  fsum_l[i] += fval;
+                  fsum2_l[i] += fval * fval;
+                  hits_l[i]++;
+                }
+              else
+                {
+                  fsum_r[i] += fval;
+                  fsum2_r[i] += fval * fval;
+                  hits_r[i]++;
+                }
             }
         }
     }
@@ -23,10 +23,22 @@
 
 #include <config.h>
 #include <math.h>
+#include <stdlib.h>
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_monte_plain.h>
 
+/* number of points evaluated in each call of a batched integrand */
+#define BLOCK_SIZE 256
+
+static int plain_integrate (const gsl_monte_function * f,
+                            const gsl_monte_function_vec * fv,
+                            const double xl[], const double xu[],
+                            const size_t dim, const size_t calls,
+                            gsl_rng * r, gsl_monte_plain_state * state,
+                            double *result, double *abserr);
+
 int
 gsl_monte_plain_integrate (const gsl_monte_function * f,
                            const double xl[], const double xu[],
@@ -35,10 +47,41 @@ gsl_monte_plain_integrate (const gsl_monte_function * f,
                            gsl_rng * r,
                            gsl_monte_plain_state * state,
                            double *result, double *abserr)
+{
+  return plain_integrate (f, NULL, xl, xu, dim, calls, r, state,
+                          result, abserr);
+}
+
+int
+gsl_monte_plain_integrate_vec (const gsl_monte_function_vec * f,
+                               const double xl[], const double xu[],
+                               const size_t dim,
+                               const size_t calls,
+                               gsl_rng * r,
+                               gsl_monte_plain_state * state,
+                               double *result, double *abserr)
+{
+  return plain_integrate (NULL, f, xl, xu, dim, calls, r, state,
+                          result, abserr);
+}
+
+/* Integrate either f, one point at a time, or fv, in blocks of
+   BLOCK_SIZE points.  The points are drawn in the same order in
+   both cases, so the results are identical. */
+
+static int
+plain_integrate (const gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
+                 const double xl[], const double xu[],
+                 const size_t dim, const size_t calls,
+                 gsl_rng * r, gsl_monte_plain_state * state,
+                 double *result, double *abserr)
 {
   double vol, m = 0, q = 0;
   double *x = state->x;
-  size_t n, i;
+  double *xb = 0, *fb = 0;
+  size_t block = 1;
+  size_t n, i, k;
 
   if (dim != state->dim)
     {
@@ -59,6 +102,21 @@ gsl_monte_plain_integrate (const gsl_monte_function * f,
         }
     }
 
+  if (fv != NULL)
+    {
+      block = GSL_MAX (GSL_MIN (calls, BLOCK_SIZE), 1);
+      xb = (double *) malloc (block * dim * sizeof (double));
+      fb = (double *) malloc (block * sizeof (double));
+
+      if (xb == 0 || fb == 0)
+        {
+          free (xb);
+          free (fb);
+          GSL_ERROR ("failed to allocate space for block of points",
+                     GSL_ENOMEM);
+        }
+    }
+
   /* Compute the volume of the region */
 
   vol = 1;
@@ -68,26 +126,61 @@ gsl_monte_plain_integrate (const gsl_monte_function * f,
       vol *= xu[i] - xl[i];
     }
 
-  for (n = 0; n < calls; n++)
+  for (n = 0; n < calls; n += block)
     {
-      /* Choose a random point in the integration region */
+      const size_t nb = GSL_MIN (block, calls - n);
 
-      for (i = 0; i < dim; i++)
+      if (fv != NULL)
         {
-          x[i] = xl[i] + gsl_rng_uniform_pos (r) * (xu[i] - xl[i]);
-        }
+          /* Choose a block of random points in the integration region */
 
-      {
-        double fval = GSL_MONTE_FN_EVAL (f, x);
+          gsl_rng_uniform_pos_array (r, xb, nb * dim);
 
-        /* recurrence for mean and variance */
+          for (k = 0; k < nb; k++)
+            {
+              for (i = 0; i < dim; i++)
+                {
+                  double *xk = xb + k * dim;
+                  xk[i] = xl[i] + xk[i] * (xu[i] - xl[i]);
+                }
+            }
 
-        double d = fval - m;
-        m += d / (n + 1.0);
-        q += d * d * (n / (n + 1.0));
-      }
+          GSL_MONTE_FN_VEC_EVAL (fv, xb, nb, fb);
+        }
+
+      for (k = 0; k < nb; k++)
+        {
+          double fval;
+
+          if (fv != NULL)
+            {
+              fval = fb[k];
+            }
+          else
+            {
+              /* Choose a random point in the integration region */
+
+              for (i = 0; i < dim; i++)
+                {
+                  x[i] = xl[i] + gsl_rng_uniform_pos (r) * (xu[i] - xl[i]);
+                }
+
+              fval = GSL_MONTE_FN_EVAL (f, x);
+            }
+
+          /* recurrence for mean and variance */
+
+          {
+            double d = fval - m;
+            m += d / (n + k + 1.0);
+            q += d * d * ((n + k) / (n + k + 1.0));
+          }
+        }
     }
 
+  free (xb);
+  free (fb);
+
   *result = vol * m;
 
   if (calls < 2)
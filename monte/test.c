@@ -60,6 +60,23 @@ double f3 (double x[], size_t d, void *params);
 void my_error_handler (const char *reason, const char *file,
                        int line, int err);
 
+int vegas_split_integrate (gsl_monte_function * f, double xl[], double xu[],
+                           size_t dim, size_t calls, gsl_rng * r,
+                           gsl_monte_vegas_state * s,
+                           double *result, double *abserr, int reverse);
+void test_vegas_split (void);
+void test_vec (void);
+
+/* batched integrand which calls a scalar function for each point */
+
+struct vec_params {
+  double (*f)(double *, size_t, void *);
+  void * params;
+};
+
+void fvec (const double x[], size_t npoints, size_t dim, void *params,
+           double fval[]);
+
 struct problem {
   gsl_monte_function * f;
   double * xl;
@@ -381,10 +398,139 @@ main (void)
 #undef MONTE_SPEEDUP
 #endif
 
+#ifdef VEGAS
+#define NAME "vegas(split)"
+#define MONTE_STATE gsl_monte_vegas_state
+#define MONTE_ALLOC gsl_monte_vegas_alloc
+#define MONTE_INTEGRATE(f,xl,xu,dim,calls,r,s,res,err) { vegas_split_integrate(f,xl,xu,dim,calls,r,s,res,err,0) ;  }
+#define MONTE_FREE gsl_monte_vegas_free
+#define MONTE_SPEEDUP 3
+#define MONTE_ERROR_TEST(err,expected) gsl_test(err > 3.0 * (expected == 0 ? 1.0/(I->calls/MONTE_SPEEDUP) : expected), NAME ", %s, abserr[%d] (obs %g vs exp %g)", I->description, i, err, expected) ; gsl_test(gsl_monte_vegas_chisq(s) < 0, NAME " returns valid chisq (%g)", gsl_monte_vegas_chisq(s))
+#include "test_main.c"
+#undef NAME
+#undef MONTE_STATE
+#undef MONTE_ALLOC
+#undef MONTE_INTEGRATE
+#undef MONTE_FREE
+#undef MONTE_ERROR_TEST
+#undef MONTE_SPEEDUP
+#endif
+
+#ifdef VEGAS
+  test_vegas_split ();
+#endif
+
+  test_vec ();
       
   exit (gsl_test_summary ());
 }
 
+/* Integrate with the boxes of each iteration divided into NSPLIT
+   ranges, each sampled with its own stream of a counter-based
+   generator, in forward or reverse order. */
+
+#define NSPLIT 4
+
+int
+vegas_split_integrate (gsl_monte_function * f, double xl[], double xu[],
+                       size_t dim, size_t calls, gsl_rng * r,
+                       gsl_monte_vegas_state * s,
+                       double *result, double *abserr, int reverse)
+{
+  gsl_monte_vegas_partial * p[NSPLIT];
+  gsl_rng * rs[NSPLIT];
+  unsigned long int seed = gsl_rng_get (r);
+  size_t nboxes, it, j;
+  int status = gsl_monte_vegas_begin (xl, xu, dim, calls, s, &nboxes);
+
+  for (j = 0; j < NSPLIT; j++)
+    {
+      p[j] = gsl_monte_vegas_partial_alloc (dim);
+      rs[j] = gsl_rng_alloc (gsl_rng_philox4x32);
+      gsl_rng_set_stream (rs[j], seed, j);
+    }
+
+  *result = 0;
+  *abserr = 0;
+
+  for (it = 0; it < s->iterations && status == GSL_SUCCESS; it++)
+    {
+      for (j = 0; j < NSPLIT; j++)
+        {
+          size_t k = reverse ? NSPLIT - 1 - j : j;
+          size_t first = k * nboxes / NSPLIT;
+          size_t last = (k + 1) * nboxes / NSPLIT;
+
+          status += gsl_monte_vegas_sample (f, xl, xu, rs[k], s, 
+                                            first, last - first, p[k]);
+        }
+
+      status += gsl_monte_vegas_end (s, p, NSPLIT, result, abserr);
+    }
+
+  for (j = 0; j < NSPLIT; j++)
+    {
+      gsl_monte_vegas_partial_free (p[j]);
+      gsl_rng_free (rs[j]);
+    }
+
+  return status;
+}
+
+void
+test_vegas_split (void)
+{
+  double a = 0.1;
+  gsl_monte_function F1 = make_function (&f1, 3, &a);
+  gsl_monte_vegas_state *s1 = gsl_monte_vegas_alloc (3);
+  gsl_monte_vegas_state *s2 = gsl_monte_vegas_alloc (3);
+  gsl_monte_vegas_partial *p = gsl_monte_vegas_partial_alloc (3);
+  gsl_rng *r1 = gsl_rng_alloc (gsl_rng_default);
+  gsl_rng *r2 = gsl_rng_clone (r1);
+  double res1, err1, res2, err2;
+  size_t it, nboxes;
+  int pass;
+
+  /* a single range reproduces gsl_monte_vegas_integrate exactly */
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      gsl_monte_vegas_integrate (&F1, xl, xu, 3, 10000, r1, s1, &res1, &err1);
+
+      gsl_monte_vegas_begin (xl, xu, 3, 10000, s2, &nboxes);
+
+      for (it = 0; it < s2->iterations; it++)
+        {
+          gsl_monte_vegas_sample (&F1, xl, xu, r2, s2, 0, nboxes, p);
+          gsl_monte_vegas_end (s2, &p, 1, &res2, &err2);
+        }
+
+      gsl_test (res1 != res2 || err1 != err2 
+                || gsl_monte_vegas_chisq (s1) != gsl_monte_vegas_chisq (s2),
+                "vegas(split), single range matches integrate, call %d", pass);
+    }
+
+  /* the order in which the ranges are sampled does not matter */
+
+  gsl_monte_vegas_init (s1);
+  gsl_monte_vegas_init (s2);
+  gsl_rng_set (r1, 1);
+  gsl_rng_set (r2, 1);
+
+  vegas_split_integrate (&F1, xl, xu, 3, 10000, r1, s1, &res1, &err1, 0);
+  vegas_split_integrate (&F1, xl, xu, 3, 10000, r2, s2, &res2, &err2, 1);
+
+  gsl_test (res1 != res2 || err1 != err2,
+            "vegas(split), reduction independent of order");
+  gsl_test_abs (res1, 1.0, 5 * err1, "vegas(split), result");
+
+  gsl_monte_vegas_partial_free (p);
+  gsl_monte_vegas_free (s1);
+  gsl_monte_vegas_free (s2);
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
 /* Simple constant function */
 double
 fconst (double x[], size_t num_dim, void *params)
@@ -472,6 +618,137 @@ f3 (double x[], size_t num_dim, void *params)
 }
 
 
+void
+fvec (const double x[], size_t npoints, size_t dim, void *params,
+      double fval[])
+{
+  struct vec_params *p = (struct vec_params *) params;
+  size_t k;
+
+  for (k = 0; k < npoints; k++)
+    {
+      fval[k] = p->f ((double *) (x + k * dim), dim, p->params);
+    }
+}
+
+/* The batched integrators draw the same points in the same order as
+   the scalar ones, so the results must be identical */
+
+void
+test_vec (void)
+{
+  double a = 0.1;
+  double (*funcs[3])(double *, size_t, void *) = { &f0, &f1, &f2 };
+  const char *names[3] = { "product", "gaussian", "double gaussian" };
+  size_t dims[3] = { 1, 3, 5 };
+  size_t calls[3] = { 1000, 100000, 10000 };
+  gsl_rng *r1 = gsl_rng_alloc (gsl_rng_default);
+  gsl_rng *r2 = gsl_rng_alloc (gsl_rng_default);
+  size_t i, j, c;
+
+  for (i = 0; i < 3; i++)
+    {
+      struct vec_params vp;
+      gsl_monte_function F;
+      gsl_monte_function_vec Fv;
+
+      vp.f = funcs[i];
+      vp.params = &a;
+
+      for (j = 0; j < 3; j++)
+        {
+          const size_t dim = dims[j];
+
+          F = make_function (funcs[i], dim, &a);
+          Fv.f = &fvec;
+          Fv.dim = dim;
+          Fv.params = &vp;
+
+          for (c = 0; c < 3; c++)
+            {
+              double res1, err1, res2, err2;
+
+              {
+                gsl_monte_plain_state *s1 = gsl_monte_plain_alloc (dim);
+                gsl_monte_plain_state *s2 = gsl_monte_plain_alloc (dim);
+
+                gsl_rng_memcpy (r2, r1);
+                gsl_monte_plain_integrate (&F, xl, xu, dim, calls[c], r1, s1,
+                                           &res1, &err1);
+                gsl_monte_plain_integrate_vec (&Fv, xl, xu, dim, calls[c], r2, 
+                                               s2, &res2, &err2);
+                gsl_test (res1 != res2 || err1 != err2 
+                          || gsl_rng_get (r1) != gsl_rng_get (r2),
+                          "plain_vec, %s, %dd, %d calls", names[i], 
+                          (int) dim, (int) calls[c]);
+
+                gsl_monte_plain_free (s1);
+                gsl_monte_plain_free (s2);
+              }
+
+              {
+                gsl_monte_miser_state *s1 = gsl_monte_miser_alloc (dim);
+                gsl_monte_miser_state *s2 = gsl_monte_miser_alloc (dim);
+
+                gsl_rng_memcpy (r2, r1);
+                gsl_monte_miser_integrate (&F, xl, xu, dim, calls[c], r1, s1,
+                                           &res1, &err1);
+                gsl_monte_miser_integrate_vec (&Fv, xl, xu, dim, calls[c], r2, 
+                                               s2, &res2, &err2);
+                gsl_test (res1 != res2 || err1 != err2
+                          || gsl_rng_get (r1) != gsl_rng_get (r2),
+                          "miser_vec, %s, %dd, %d calls", names[i], 
+                          (int) dim, (int) calls[c]);
+
+                gsl_monte_miser_free (s1);
+                gsl_monte_miser_free (s2);
+              }
+
+              {
+                gsl_monte_vegas_state *s1 = gsl_monte_vegas_alloc (dim);
+                gsl_monte_vegas_state *s2 = gsl_monte_vegas_alloc (dim);
+                gsl_monte_vegas_state *s3 = gsl_monte_vegas_alloc (dim);
+                gsl_monte_vegas_partial *p = gsl_monte_vegas_partial_alloc (dim);
+                gsl_rng *r3 = gsl_rng_clone (r1);
+                double res3, err3;
+                size_t it, nboxes;
+
+                gsl_rng_memcpy (r2, r1);
+                gsl_monte_vegas_integrate (&F, xl, xu, dim, calls[c], r1, s1,
+                                           &res1, &err1);
+                gsl_monte_vegas_integrate_vec (&Fv, xl, xu, dim, calls[c], r2,
+                                               s2, &res2, &err2);
+                gsl_test (res1 != res2 || err1 != err2
+                          || gsl_monte_vegas_chisq (s1) != gsl_monte_vegas_chisq (s2),
+                          "vegas_vec, %s, %dd, %d calls", names[i], 
+                          (int) dim, (int) calls[c]);
+
+                gsl_monte_vegas_begin (xl, xu, dim, calls[c], s3, &nboxes);
+
+                for (it = 0; it < s3->iterations; it++)
+                  {
+                    gsl_monte_vegas_sample_vec (&Fv, xl, xu, r3, s3, 0, nboxes, p);
+                    gsl_monte_vegas_end (s3, &p, 1, &res3, &err3);
+                  }
+
+                gsl_test (res1 != res3 || err1 != err3,
+                          "vegas_sample_vec, %s, %dd, %d calls", names[i], 
+                          (int) dim, (int) calls[c]);
+
+                gsl_rng_free (r3);
+                gsl_monte_vegas_partial_free (p);
+                gsl_monte_vegas_free (s1);
+                gsl_monte_vegas_free (s2);
+                gsl_monte_vegas_free (s3);
+              }
+            }
+        }
+    }
+
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
 void
 my_error_handler (const char *reason, const char *file, int line, int err)
 {
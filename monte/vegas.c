@@ -67,6 +67,9 @@
 /* lib-specific headers */
 #define BINS_MAX 50             /* even integer, will be divided by two */
 
+/* number of points evaluated in each call of a batched integrand */
+#define BLOCK_SIZE 256
+
 /* A separable grid with coordinates and values */
 #define COORD(s,i,j) ((s)->xi[(i)*(s)->dim + (j)])
 #define NEW_COORD(s,i) ((s)->xin[(i)])
@@ -81,14 +84,40 @@ typedef int coord;
 static void init_grid (gsl_monte_vegas_state * s, double xl[], double xu[],
                 size_t dim);
 static void reset_grid_values (gsl_monte_vegas_state * s);
-static void init_box_coord (gsl_monte_vegas_state * s, coord box[]);
-static int change_box_coord (gsl_monte_vegas_state * s, coord box[]);
-static void accumulate_distribution (gsl_monte_vegas_state * s, coord bin[],
+static void init_box_coord (const gsl_monte_vegas_state * s, coord box[]);
+static void set_box_coord (const gsl_monte_vegas_state * s, coord box[],
+                           size_t index);
+static int change_box_coord (const gsl_monte_vegas_state * s, coord box[]);
+static size_t total_boxes (const gsl_monte_vegas_state * s);
+static void accumulate_distribution (double d[], size_t dim, coord bin[],
                                      double y);
 static void random_point (double x[], coord bin[], double *bin_vol,
                           const coord box[], 
                           const double xl[], const double xu[],
-                          gsl_monte_vegas_state * s, gsl_rng * r);
+                          const gsl_monte_vegas_state * s, gsl_rng * r);
+static void sample_boxes (gsl_monte_function * f,
+                          double xl[], double xu[], gsl_rng * r,
+                          const gsl_monte_vegas_state * s,
+                          size_t first_box, size_t nboxes,
+                          double d[], double x[], coord bin[], coord box[],
+                          double *intgrl, double *tss);
+static void sample_boxes_vec (const gsl_monte_function_vec * f,
+                              double xl[], double xu[], gsl_rng * r,
+                              const gsl_monte_vegas_state * s,
+                              size_t first_box, size_t nboxes,
+                              double d[], coord box[],
+                              double xb[], coord binb[],
+                              double *intgrl, double *tss);
+static int alloc_block (size_t dim, double **xb, coord **binb);
+static void end_iteration (gsl_monte_vegas_state * state,
+                           double intgrl, double tss);
+static int vegas_integrate (gsl_monte_function * f,
+                            const gsl_monte_function_vec * fv,
+                            double xl[], double xu[],
+                            size_t dim, size_t calls,
+                            gsl_rng * r,
+                            gsl_monte_vegas_state * state,
+                            double *result, double *abserr);
 static void resize_grid (gsl_monte_vegas_state * s, unsigned int bins);
 static void refine_grid (gsl_monte_vegas_state * s);
 
@@ -113,8 +142,105 @@ gsl_monte_vegas_integrate (gsl_monte_function * f,
                            gsl_monte_vegas_state * state,
                            double *result, double *abserr)
 {
-  double cum_int, cum_sig;
-  size_t i, k, it;
+  return vegas_integrate (f, NULL, xl, xu, dim, calls, r, state,
+                          result, abserr);
+}
+
+int
+gsl_monte_vegas_integrate_vec (const gsl_monte_function_vec * f,
+                               double xl[], double xu[],
+                               size_t dim, size_t calls,
+                               gsl_rng * r,
+                               gsl_monte_vegas_state * state,
+                               double *result, double *abserr)
+{
+  return vegas_integrate (NULL, f, xl, xu, dim, calls, r, state,
+                          result, abserr);
+}
+
+/* Integrate either f, one point at a time, or fv, in blocks of
+   BLOCK_SIZE points.  The points are drawn in the same order in
+   both cases, so the results are identical. */
+
+static int
+vegas_integrate (gsl_monte_function * f,
+                 const gsl_monte_function_vec * fv,
+                 double xl[], double xu[],
+                 size_t dim, size_t calls,
+                 gsl_rng * r,
+                 gsl_monte_vegas_state * state,
+                 double *result, double *abserr)
+{
+  size_t it, nboxes;
+  double *xb = 0;
+  coord *binb = 0;
+  int status = gsl_monte_vegas_begin (xl, xu, dim, calls, state, &nboxes);
+
+  if (status)
+    {
+      return status;
+    }
+
+  if (fv != NULL)
+    {
+      status = alloc_block (dim, &xb, &binb);
+
+      if (status)
+        {
+          return status;
+        }
+    }
+
+  for (it = 0; it < state->iterations; it++)
+    {
+      double intgrl = 0.0, tss = 0.0;
+
+      reset_grid_values (state);
+
+      if (fv != NULL)
+        {
+          sample_boxes_vec (fv, xl, xu, r, state, 0, nboxes,
+                            state->d, state->box, xb, binb,
+                            &intgrl, &tss);
+        }
+      else
+        {
+          sample_boxes (f, xl, xu, r, state, 0, nboxes,
+                        state->d, state->x, state->bin, state->box,
+                        &intgrl, &tss);
+        }
+
+      end_iteration (state, intgrl, tss);
+    }
+
+  free (xb);
+  free (binb);
+
+  /* By setting stage to 1 further calls will generate independent
+     estimates based on the same grid, although it may be rebinned. */
+
+  state->stage = 1;  
+
+  *result = state->cum_int;
+  *abserr = state->cum_sig;
+
+  return GSL_SUCCESS;
+}
+
+/* The iterations can also be carried out step by step, with the
+   boxes of each iteration divided into ranges which are sampled
+   independently into separate partial results, for example by
+   different threads.  The partial results are combined in a fixed
+   order, so the outcome depends only on the division into ranges and
+   the random number generators used for each range. */
+
+int
+gsl_monte_vegas_begin (double xl[], double xu[],
+                       size_t dim, size_t calls,
+                       gsl_monte_vegas_state * state,
+                       size_t * nboxes)
+{
+  size_t i;
 
   if (dim != state->dim)
     {
@@ -212,172 +338,492 @@ gsl_monte_vegas_integrate (gsl_monte_function * f,
     }
 
   state->it_start = state->it_num;
+  state->it_count = 0;
+  state->cum_int = 0.0;
+  state->cum_sig = 0.0;
 
-  cum_int = 0.0;
-  cum_sig = 0.0;
+  *nboxes = total_boxes (state);
 
-  for (it = 0; it < state->iterations; it++)
+  return GSL_SUCCESS;
+}
+
+int
+gsl_monte_vegas_sample (gsl_monte_function * f,
+                        double xl[], double xu[],
+                        gsl_rng * r,
+                        const gsl_monte_vegas_state * state,
+                        size_t first_box, size_t nboxes,
+                        gsl_monte_vegas_partial * p)
+{
+  size_t i;
+
+  if (p->dim != state->dim)
+    {
+      GSL_ERROR ("number of dimensions must match allocated size", GSL_EINVAL);
+    }
+
+  if (first_box > total_boxes (state) 
+      || nboxes > total_boxes (state) - first_box)
+    {
+      GSL_ERROR ("range of boxes exceeds total number of boxes", GSL_EINVAL);
+    }
+
+  for (i = 0; i < state->bins * state->dim; i++)
     {
-      double intgrl = 0.0, intgrl_sq = 0.0;
-      double tss = 0.0;
-      double wgt, var, sig;
-      size_t calls_per_box = state->calls_per_box;
-      double jacbin = state->jac;
-      double *x = state->x;
-      coord *bin = state->bin;
+      p->d[i] = 0.0;
+    }
 
-      state->it_num = state->it_start + it;
+  p->intgrl = 0.0;
+  p->tss = 0.0;
 
-      reset_grid_values (state);
-      init_box_coord (state, state->box);
-      
-      do
+  sample_boxes (f, xl, xu, r, state, first_box, nboxes,
+                p->d, p->x, p->bin, p->box, &(p->intgrl), &(p->tss));
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_monte_vegas_sample_vec (const gsl_monte_function_vec * f,
+                            double xl[], double xu[],
+                            gsl_rng * r,
+                            const gsl_monte_vegas_state * state,
+                            size_t first_box, size_t nboxes,
+                            gsl_monte_vegas_partial * p)
+{
+  double *xb;
+  coord *binb;
+  size_t i;
+  int status;
+
+  if (p->dim != state->dim)
+    {
+      GSL_ERROR ("number of dimensions must match allocated size", GSL_EINVAL);
+    }
+
+  if (first_box > total_boxes (state) 
+      || nboxes > total_boxes (state) - first_box)
+    {
+      GSL_ERROR ("range of boxes exceeds total number of boxes", GSL_EINVAL);
+    }
+
+  status = alloc_block (state->dim, &xb, &binb);
+
+  if (status)
+    {
+      return status;
+    }
+
+  for (i = 0; i < state->bins * state->dim; i++)
+    {
+      p->d[i] = 0.0;
+    }
+
+  p->intgrl = 0.0;
+  p->tss = 0.0;
+
+  sample_boxes_vec (f, xl, xu, r, state, first_box, nboxes,
+                    p->d, p->box, xb, binb, &(p->intgrl), &(p->tss));
+
+  free (xb);
+  free (binb);
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_monte_vegas_end (gsl_monte_vegas_state * state,
+                     gsl_monte_vegas_partial * p[], size_t n,
+                     double *result, double *abserr)
+{
+  double intgrl = 0.0, tss = 0.0;
+  size_t i, k;
+
+  for (k = 0; k < n; k++)
+    {
+      if (p[k]->dim != state->dim)
         {
-          volatile double m = 0, q = 0;
-          double f_sq_sum = 0.0;
+          GSL_ERROR ("number of dimensions must match allocated size",
+                     GSL_EINVAL);
+        }
+    }
 
-          for (k = 0; k < calls_per_box; k++)
-            {
-              volatile double fval;
-              double bin_vol;
+  reset_grid_values (state);
 
-              random_point (x, bin, &bin_vol, state->box, xl, xu, state, r);
+  for (k = 0; k < n; k++)
+    {
+      for (i = 0; i < state->bins * state->dim; i++)
+        {
+          state->d[i] += p[k]->d[i];
+        }
 
-              fval = jacbin * bin_vol * GSL_MONTE_FN_EVAL (f, x);
+      intgrl += p[k]->intgrl;
+      tss += p[k]->tss;
+    }
 
-              /* recurrence for mean and variance (sum of squares) */
+  end_iteration (state, intgrl, tss);
 
-              {
-                double d = fval - m;
-                m += d / (k + 1.0);
-                q += d * d * (k / (k + 1.0));
-              }
+  state->stage = 1;
 
-              if (state->mode != GSL_VEGAS_MODE_STRATIFIED)
-                {
-                  double f_sq = fval * fval;
-                  accumulate_distribution (state, bin, f_sq);
-                }
-            }
+  *result = state->cum_int;
+  *abserr = state->cum_sig;
+
+  return GSL_SUCCESS;
+}
+
+gsl_monte_vegas_partial *
+gsl_monte_vegas_partial_alloc (size_t dim)
+{
+  gsl_monte_vegas_partial *p =
+    (gsl_monte_vegas_partial *) malloc (sizeof (gsl_monte_vegas_partial));
+
+  if (p == 0)
+    {
+      GSL_ERROR_VAL ("failed to allocate space for vegas partial struct",
+                     GSL_ENOMEM, 0);
+    }
+
+  p->d = (double *) malloc (BINS_MAX * dim * sizeof (double));
+
+  if (p->d == 0)
+    {
+      free (p);
+      GSL_ERROR_VAL ("failed to allocate space for d", GSL_ENOMEM, 0);
+    }
+
+  p->x = (double *) malloc (dim * sizeof (double));
+
+  if (p->x == 0)
+    {
+      free (p->d);
+      free (p);
+      GSL_ERROR_VAL ("failed to allocate space for x", GSL_ENOMEM, 0);
+    }
+
+  p->bin = (int *) malloc (dim * sizeof (int));
+
+  if (p->bin == 0)
+    {
+      free (p->x);
+      free (p->d);
+      free (p);
+      GSL_ERROR_VAL ("failed to allocate space for bin", GSL_ENOMEM, 0);
+    }
 
-          intgrl += m * calls_per_box;
+  p->box = (int *) malloc (dim * sizeof (int));
 
-          f_sq_sum = q * calls_per_box;
+  if (p->box == 0)
+    {
+      free (p->bin);
+      free (p->x);
+      free (p->d);
+      free (p);
+      GSL_ERROR_VAL ("failed to allocate space for box", GSL_ENOMEM, 0);
+    }
 
-          tss += f_sq_sum;
+  p->dim = dim;
+  p->intgrl = 0.0;
+  p->tss = 0.0;
 
-          if (state->mode == GSL_VEGAS_MODE_STRATIFIED)
+  return p;
+}
+
+void
+gsl_monte_vegas_partial_free (gsl_monte_vegas_partial * p)
+{
+  RETURN_IF_NULL (p);
+  free (p->box);
+  free (p->bin);
+  free (p->x);
+  free (p->d);
+  free (p);
+}
+
+/* Sample the boxes first_box, ..., first_box + nboxes - 1, in the
+   order of change_box_coord, accumulating the distribution in d[] and
+   the sums of the integral and variance estimates of the boxes. */
+
+static void
+sample_boxes (gsl_monte_function * f,
+              double xl[], double xu[], gsl_rng * r,
+              const gsl_monte_vegas_state * state,
+              size_t first_box, size_t nboxes,
+              double d[], double x[], coord bin[], coord box[],
+              double *intgrl_out, double *tss_out)
+{
+  double intgrl = 0.0, tss = 0.0;
+  size_t calls_per_box = state->calls_per_box;
+  double jacbin = state->jac;
+  size_t b, k;
+
+  set_box_coord (state, box, first_box);
+
+  for (b = 0; b < nboxes; b++)
+    {
+      volatile double m = 0, q = 0;
+      double f_sq_sum = 0.0;
+
+      for (k = 0; k < calls_per_box; k++)
+        {
+          volatile double fval;
+          double bin_vol;
+
+          random_point (x, bin, &bin_vol, box, xl, xu, state, r);
+
+          fval = jacbin * bin_vol * GSL_MONTE_FN_EVAL (f, x);
+
+          /* recurrence for mean and variance (sum of squares) */
+
+          {
+            double dv = fval - m;
+            m += dv / (k + 1.0);
+            q += dv * dv * (k / (k + 1.0));
+          }
+
+          if (state->mode != GSL_VEGAS_MODE_STRATIFIED)
             {
-              accumulate_distribution (state, bin, f_sq_sum);
+              double f_sq = fval * fval;
+              accumulate_distribution (d, state->dim, bin, f_sq);
             }
         }
-      while (change_box_coord (state, state->box));
 
-      /* Compute final results for this iteration   */
+      intgrl += m * calls_per_box;
+
+      f_sq_sum = q * calls_per_box;
 
-      var = tss / (calls_per_box - 1.0)  ;
+      tss += f_sq_sum;
 
-      if (var > 0) 
+      if (state->mode == GSL_VEGAS_MODE_STRATIFIED)
         {
-          wgt = 1.0 / var;
+          accumulate_distribution (d, state->dim, bin, f_sq_sum);
         }
-      else if (state->sum_wgts > 0) 
+
+      change_box_coord (state, box);
+    }
+
+  *intgrl_out = intgrl;
+  *tss_out = tss;
+}
+
+/* Allocate space for a block of BLOCK_SIZE points, with the
+   coordinates, bin volumes and function values in xb[] and the bin
+   indices in binb[]. */
+
+static int
+alloc_block (size_t dim, double **xb, coord **binb)
+{
+  *xb = (double *) malloc (BLOCK_SIZE * (dim + 2) * sizeof (double));
+  *binb = (coord *) malloc (BLOCK_SIZE * dim * sizeof (coord));
+
+  if (*xb == 0 || *binb == 0)
+    {
+      free (*xb);
+      free (*binb);
+      GSL_ERROR ("failed to allocate space for block of points", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* As sample_boxes, but evaluating the function for blocks of up to
+   BLOCK_SIZE points, which may span several boxes.  The points of a
+   block are generated first, walking through the boxes, and then
+   processed in the same order as in sample_boxes. */
+
+static void
+sample_boxes_vec (const gsl_monte_function_vec * f,
+                  double xl[], double xu[], gsl_rng * r,
+                  const gsl_monte_vegas_state * state,
+                  size_t first_box, size_t nboxes,
+                  double d[], coord box[],
+                  double xb[], coord binb[],
+                  double *intgrl_out, double *tss_out)
+{
+  const size_t dim = state->dim;
+  const size_t calls_per_box = state->calls_per_box;
+  const size_t npoints = nboxes * calls_per_box;
+  const double jacbin = state->jac;
+  double *volb = xb + BLOCK_SIZE * dim;
+  double *fb = volb + BLOCK_SIZE;
+  double intgrl = 0.0, tss = 0.0;
+  volatile double m = 0, q = 0;
+  size_t n, j, kg = 0, k = 0;
+
+  set_box_coord (state, box, first_box);
+
+  for (n = 0; n < npoints; n += BLOCK_SIZE)
+    {
+      const size_t nb = GSL_MIN (BLOCK_SIZE, npoints - n);
+
+      for (j = 0; j < nb; j++)
         {
-          wgt = state->sum_wgts / state->samples;
+          random_point (xb + j * dim, binb + j * dim, &volb[j], box,
+                        xl, xu, state, r);
+
+          if (++kg == calls_per_box)
+            {
+              kg = 0;
+              change_box_coord (state, box);
+            }
         }
-      else 
+
+      GSL_MONTE_FN_VEC_EVAL (f, xb, nb, fb);
+
+      for (j = 0; j < nb; j++)
         {
-          wgt = 0.0;
+          coord *bin = binb + j * dim;
+          volatile double fval = jacbin * volb[j] * fb[j];
+
+          /* recurrence for mean and variance (sum of squares) */
+
+          {
+            double dv = fval - m;
+            m += dv / (k + 1.0);
+            q += dv * dv * (k / (k + 1.0));
+          }
+
+          if (state->mode != GSL_VEGAS_MODE_STRATIFIED)
+            {
+              double f_sq = fval * fval;
+              accumulate_distribution (d, dim, bin, f_sq);
+            }
+
+          if (++k == calls_per_box)
+            {
+              double f_sq_sum;
+
+              intgrl += m * calls_per_box;
+
+              f_sq_sum = q * calls_per_box;
+
+              tss += f_sq_sum;
+
+              if (state->mode == GSL_VEGAS_MODE_STRATIFIED)
+                {
+                  accumulate_distribution (d, dim, bin, f_sq_sum);
+                }
+
+              k = 0;
+              m = 0;
+              q = 0;
+            }
         }
+    }
+
+  *intgrl_out = intgrl;
+  *tss_out = tss;
+}
+
+/* Compute the results of an iteration from the sums over all the
+   boxes, combine them with the previous iterations and refine the
+   grid using the distribution in state->d. */
+
+static void
+end_iteration (gsl_monte_vegas_state * state, double intgrl, double tss)
+{
+  const size_t it = state->it_count;
+  const size_t dim = state->dim;
+  size_t calls_per_box = state->calls_per_box;
+  double intgrl_sq;
+  double wgt, var, sig;
+  double cum_int = state->cum_int, cum_sig = state->cum_sig;
+
+  state->it_num = state->it_start + it;
+
+  /* Compute final results for this iteration   */
+
+  var = tss / (calls_per_box - 1.0)  ;
+
+  if (var > 0) 
+    {
+      wgt = 1.0 / var;
+    }
+  else if (state->sum_wgts > 0) 
+    {
+      wgt = state->sum_wgts / state->samples;
+    }
+  else 
+    {
+      wgt = 0.0;
+    }
         
-     intgrl_sq = intgrl * intgrl;
+  intgrl_sq = intgrl * intgrl;
 
-     sig = sqrt (var);
+  sig = sqrt (var);
 
-     state->result = intgrl;
-     state->sigma  = sig;
+  state->result = intgrl;
+  state->sigma  = sig;
 
-     if (wgt > 0.0)
-       {
-         double sum_wgts = state->sum_wgts;
-         double wtd_int_sum = state->wtd_int_sum;
-         double m = (sum_wgts > 0) ? (wtd_int_sum / sum_wgts) : 0;
-         double q = intgrl - m;
+  if (wgt > 0.0)
+    {
+      double sum_wgts = state->sum_wgts;
+      double wtd_int_sum = state->wtd_int_sum;
+      double m = (sum_wgts > 0) ? (wtd_int_sum / sum_wgts) : 0;
+      double q = intgrl - m;
 
-         state->samples++ ;
-         state->sum_wgts += wgt;
-         state->wtd_int_sum += intgrl * wgt;
-         state->chi_sum += intgrl_sq * wgt;
+      state->samples++ ;
+      state->sum_wgts += wgt;
+      state->wtd_int_sum += intgrl * wgt;
+      state->chi_sum += intgrl_sq * wgt;
 
-         cum_int = state->wtd_int_sum / state->sum_wgts;
-         cum_sig = sqrt (1 / state->sum_wgts);
+      cum_int = state->wtd_int_sum / state->sum_wgts;
+      cum_sig = sqrt (1 / state->sum_wgts);
 
 #if USE_ORIGINAL_CHISQ_FORMULA
 /* This is the chisq formula from the original Lepage paper.  It
    computes the variance from <x^2> - <x>^2 and can suffer from
    catastrophic cancellations, e.g. returning negative chisq. */
-         if (state->samples > 1)
-           {
-             state->chisq = (state->chi_sum - state->wtd_int_sum * cum_int) /
-               (state->samples - 1.0);
-           }
+      if (state->samples > 1)
+        {
+          state->chisq = (state->chi_sum - state->wtd_int_sum * cum_int) /
+            (state->samples - 1.0);
+        }
 #else
 /* The new formula below computes exactly the same quantity as above
    but using a stable recurrence */
-         if (state->samples == 1) {
-           state->chisq = 0;
-         } else {
-           state->chisq *= (state->samples - 2.0);
-           state->chisq += (wgt / (1 + (wgt / sum_wgts))) * q * q;
-           state->chisq /= (state->samples - 1.0);
-         }
+      if (state->samples == 1) {
+        state->chisq = 0;
+      } else {
+        state->chisq *= (state->samples - 2.0);
+        state->chisq += (wgt / (1 + (wgt / sum_wgts))) * q * q;
+        state->chisq /= (state->samples - 1.0);
+      }
 #endif
-       }
-     else
-       {
-         cum_int += (intgrl - cum_int) / (it + 1.0);
-         cum_sig = 0.0;
-       }         
-
-
-      if (state->verbose >= 0)
-        {
-          print_res (state,
-                     state->it_num, intgrl, sig, cum_int, cum_sig,
-                     state->chisq);
-          if (it + 1 == state->iterations && state->verbose > 0)
-            {
-              print_grid (state, dim);
-            }
-        }
-
-      if (state->verbose > 1)
-        {
-          print_dist (state, dim);
-        }
+    }
+  else
+    {
+      cum_int += (intgrl - cum_int) / (it + 1.0);
+      cum_sig = 0.0;
+    }         
 
-      refine_grid (state);
+  state->cum_int = cum_int;
+  state->cum_sig = cum_sig;
+  state->it_count++;
 
-      if (state->verbose > 1)
+  if (state->verbose >= 0)
+    {
+      print_res (state,
+                 state->it_num, intgrl, sig, cum_int, cum_sig,
+                 state->chisq);
+      if (it + 1 == state->iterations && state->verbose > 0)
         {
           print_grid (state, dim);
         }
-
     }
 
-  /* By setting stage to 1 further calls will generate independent
-     estimates based on the same grid, although it may be rebinned. */
-
-  state->stage = 1;  
+  if (state->verbose > 1)
+    {
+      print_dist (state, dim);
+    }
 
-  *result = cum_int;
-  *abserr = cum_sig;
+  refine_grid (state);
 
-  return GSL_SUCCESS;
+  if (state->verbose > 1)
+    {
+      print_grid (state, dim);
+    }
 }
 
 
-
 gsl_monte_vegas_state *
 gsl_monte_vegas_alloc (size_t dim)
 {
@@ -557,7 +1003,7 @@ gsl_monte_vegas_params_set (gsl_monte_vegas_state * s, const gsl_monte_vegas_par
 }
 
 static void
-init_box_coord (gsl_monte_vegas_state * s, coord box[])
+init_box_coord (const gsl_monte_vegas_state * s, coord box[])
 {
   size_t i;
 
@@ -569,11 +1015,28 @@ init_box_coord (gsl_monte_vegas_state * s, coord box[])
     }
 }
 
+/* set_box_coord sets the box coord to the box with the given index
+   in the order of change_box_coord, the last coordinate varying
+   fastest */
+static void
+set_box_coord (const gsl_monte_vegas_state * s, coord box[], size_t index)
+{
+  int j;
+
+  init_box_coord (s, box);
+
+  for (j = s->dim - 1; j >= 0 && index > 0; j--)
+    {
+      box[j] = index % s->boxes;
+      index /= s->boxes;
+    }
+}
+
 /* change_box_coord steps through the box coord like
    {0,0}, {0, 1}, {0, 2}, {0, 3}, {1, 0}, {1, 1}, {1, 2}, ...
 */
 static int
-change_box_coord (gsl_monte_vegas_state * s, coord box[])
+change_box_coord (const gsl_monte_vegas_state * s, coord box[])
 {
   int j = s->dim - 1;
 
@@ -594,6 +1057,19 @@ change_box_coord (gsl_monte_vegas_state * s, coord box[])
   return 0;
 }
 
+static size_t
+total_boxes (const gsl_monte_vegas_state * s)
+{
+  size_t j, n = 1;
+
+  for (j = 0; j < s->dim; j++)
+    {
+      n *= s->boxes;
+    }
+
+  return n;
+}
+
 static void
 init_grid (gsl_monte_vegas_state * s, double xl[], double xu[], size_t dim)
 {
@@ -635,22 +1111,21 @@ reset_grid_values (gsl_monte_vegas_state * s)
 }
 
 static void
-accumulate_distribution (gsl_monte_vegas_state * s, coord bin[], double y)
+accumulate_distribution (double d[], size_t dim, coord bin[], double y)
 {
   size_t j;
-  size_t dim = s->dim;
 
   for (j = 0; j < dim; j++)
     {
       int i = bin[j];
-      VALUE (s, i, j) += y;
+      d[i * dim + j] += y;
     }
 }
 
 static void
 random_point (double x[], coord bin[], double *bin_vol,
               const coord box[], const double xl[], const double xu[],
-              gsl_monte_vegas_state * s, gsl_rng * r)
+              const gsl_monte_vegas_state * s, gsl_rng * r)
 {
   /* Use the random number generator r to return a random position x
      in a given box.  The value of bin gives the bin location of the
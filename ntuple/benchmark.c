@@ -0,0 +1,253 @@
+/* ntuple/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Time to write an ntuple of N rows of NC doubles and to project one
+   column of it onto a histogram, selecting on a second column, with
+   the row-at-a-time gsl_ntuple functions and with blocked ntuple files
+   in row and column layout.
+
+   Then the time to project the same gsl_ntuple file split into NS
+   ranges with gsl_ntuple_project_range, each range with its own
+   ntuple and histogram shard. The ranges are projected one after
+   another, or in parallel if the benchmark is compiled with OpenMP
+   (the pragma is only used when _OPENMP is defined, since the library
+   itself does no threading). */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_ntuple.h>
+#include <gsl/gsl_histogram.h>
+
+#define N 2000000
+#define NC 8
+
+#define NS 8
+
+struct row
+{
+  double x[NC];
+};
+
+static double
+seconds (clock_t start, clock_t end)
+{
+  return (end - start) / (double) CLOCKS_PER_SEC;
+}
+
+static void
+set_row (struct row *r, const size_t i)
+{
+  size_t j;
+
+  for (j = 0; j < NC; j++)
+    r->x[j] = ((i * (2 * j + 1) * 2654435761UL) % 1000003) / 1000003.0;
+}
+
+static int
+sel_func (void *ntuple_data, void *params)
+{
+  (void) params;
+  return ((struct row *) ntuple_data)->x[1] > 0.5;
+}
+
+static double
+val_func (void *ntuple_data, void *params)
+{
+  (void) params;
+  return ((struct row *) ntuple_data)->x[0];
+}
+
+static void
+sel_array_func (const gsl_ntuple_chunk * chunk, int selected[], void *params)
+{
+  size_t i;
+
+  (void) params;
+
+  for (i = 0; i < chunk->n; i++)
+    selected[i] = *(const double *) (chunk->col[1] + i * chunk->stride[1]) > 0.5;
+}
+
+static void
+val_array_func (const gsl_ntuple_chunk * chunk, double values[], void *params)
+{
+  size_t i;
+
+  (void) params;
+
+  for (i = 0; i < chunk->n; i++)
+    values[i] = *(const double *) (chunk->col[0] + i * chunk->stride[0]);
+}
+
+static void
+time_plain (void)
+{
+  struct row r;
+  gsl_ntuple_select_fn S;
+  gsl_ntuple_value_fn V;
+  gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0.0, 1.0);
+  gsl_ntuple *nt;
+  clock_t t0, t1, t2;
+  size_t i;
+
+  S.function = &sel_func;
+  S.params = 0;
+  V.function = &val_func;
+  V.params = 0;
+
+  t0 = clock ();
+
+  nt = gsl_ntuple_create ("benchmark.dat", &r, sizeof (r));
+
+  for (i = 0; i < N; i++)
+    {
+      set_row (&r, i);
+      gsl_ntuple_write (nt);
+    }
+
+  gsl_ntuple_close (nt);
+
+  t1 = clock ();
+
+  nt = gsl_ntuple_open ("benchmark.dat", &r, sizeof (r));
+  gsl_ntuple_project (h, nt, &V, &S);
+  gsl_ntuple_close (nt);
+
+  t2 = clock ();
+
+  printf ("gsl_ntuple         write %.3f s  project %.3f s  sum %g\n",
+          seconds (t0, t1), seconds (t1, t2), gsl_histogram_sum (h));
+
+  gsl_histogram_free (h);
+}
+
+static void
+time_ranges (void)
+{
+  gsl_ntuple_select_fn S;
+  gsl_ntuple_value_fn V;
+  gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0.0, 1.0);
+  gsl_histogram_shards *s = gsl_histogram_shards_alloc (h, NS);
+  struct row r[NS];
+  size_t nrows;
+  clock_t t0, t1;
+  int k;
+
+  S.function = &sel_func;
+  S.params = 0;
+  V.function = &val_func;
+  V.params = 0;
+
+  t0 = clock ();
+
+  {
+    gsl_ntuple *nt = gsl_ntuple_open ("benchmark.dat", &r[0], sizeof (r[0]));
+    gsl_ntuple_nrows (nt, &nrows);
+    gsl_ntuple_close (nt);
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (k = 0; k < NS; k++)
+    {
+      const size_t first = k * nrows / NS;
+      const size_t last = (k + 1) * nrows / NS;
+      gsl_ntuple *nt = gsl_ntuple_open ("benchmark.dat", &r[k], sizeof (r[k]));
+      gsl_histogram *hk = gsl_histogram_shards_get (s, k);
+
+      gsl_ntuple_project_range (hk, nt, &V, &S, first, last - first);
+      gsl_ntuple_close (nt);
+    }
+
+  gsl_histogram_shards_reduce (h, s);
+
+  t1 = clock ();
+
+  printf ("gsl_ntuple, %d ranges              project %.3f s  sum %g\n",
+          NS, seconds (t0, t1), gsl_histogram_sum (h));
+
+  gsl_histogram_shards_free (s);
+  gsl_histogram_free (h);
+}
+
+static void
+time_blocked (const int layout)
+{
+  const size_t cols[2] = { 0, 1 };
+  size_t offset[NC], colsize[NC];
+  struct row r;
+  gsl_ntuple_select_array_fn S;
+  gsl_ntuple_value_array_fn V;
+  gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0.0, 1.0);
+  gsl_ntuple_blocked *nt;
+  clock_t t0, t1, t2;
+  size_t i;
+
+  S.function = &sel_array_func;
+  S.params = 0;
+  V.function = &val_array_func;
+  V.params = 0;
+
+  for (i = 0; i < NC; i++)
+    {
+      offset[i] = i * sizeof (double);
+      colsize[i] = sizeof (double);
+    }
+
+  t0 = clock ();
+
+  nt = gsl_ntuple_blocked_create ("benchmark.dat", &r, sizeof (r),
+                                  offset, colsize, NC, layout);
+
+  for (i = 0; i < N; i++)
+    {
+      set_row (&r, i);
+      gsl_ntuple_blocked_write (nt);
+    }
+
+  gsl_ntuple_blocked_close (nt);
+
+  t1 = clock ();
+
+  nt = gsl_ntuple_blocked_open ("benchmark.dat", &r, sizeof (r));
+  gsl_ntuple_blocked_project (h, nt, &V, &S, cols, 2);
+  gsl_ntuple_blocked_close (nt);
+
+  t2 = clock ();
+
+  printf ("blocked, %-7s   write %.3f s  project %.3f s  sum %g\n",
+          (layout == GSL_NTUPLE_ROWS) ? "rows" : "columns",
+          seconds (t0, t1), seconds (t1, t2), gsl_histogram_sum (h));
+
+  gsl_histogram_free (h);
+}
+
+int
+main (void)
+{
+  time_plain ();
+  time_ranges ();
+  time_blocked (GSL_NTUPLE_ROWS);
+  time_blocked (GSL_NTUPLE_COLUMNS);
+
+  remove ("benchmark.dat");
+
+  return 0;
+}
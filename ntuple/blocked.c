@@ -0,0 +1,609 @@
+/* ntuple/blocked.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Blocked ntuple files. The file starts with a header describing the
+   row size and the columns of the ntuple,
+
+     magic[8], layout, size, ncols, block, offset[ncols], colsize[ncols]
+
+   stored as size_t values in native binary format, followed by blocks
+   of at most 'block' rows. Each block is the number of rows m it
+   contains followed by the rows, either one after another
+   (GSL_NTUPLE_ROWS) or column by column, m values of the first
+   column, then m values of the second, and so on (GSL_NTUPLE_COLUMNS).
+   A projection of a columnar file only reads the columns it needs and
+   skips over the others. Rows are copied between the user's data and
+   a buffer holding the current block, so that the file is accessed
+   once per block rather than once per row. */
+
+#include <config.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_ntuple.h>
+
+/* target number of bytes in a block, and the multiple of rows in a
+   block which keeps each column of the buffer aligned for any type */
+#define BLOCK_BYTES 65536
+#define BLOCK_ALIGN 16
+
+static const char magic[8] = "gslntpb";
+
+static gsl_ntuple_blocked *blocked_alloc (void *ntuple_data, size_t size,
+                                          const size_t offset[],
+                                          const size_t colsize[],
+                                          size_t ncols, int layout,
+                                          size_t block);
+static void blocked_free (gsl_ntuple_blocked * ntuple);
+static int flush_block (gsl_ntuple_blocked * ntuple);
+static int load_block (gsl_ntuple_blocked * ntuple, const int need[]);
+static void set_chunk (gsl_ntuple_blocked * ntuple, gsl_ntuple_chunk * chunk,
+                       const int need[]);
+
+static gsl_ntuple_blocked *
+blocked_alloc (void *ntuple_data, size_t size, const size_t offset[],
+               const size_t colsize[], size_t ncols, int layout,
+               size_t block)
+{
+  gsl_ntuple_blocked *ntuple;
+  size_t j, start = 0;
+
+  if (layout != GSL_NTUPLE_ROWS && layout != GSL_NTUPLE_COLUMNS)
+    {
+      GSL_ERROR_NULL ("unknown ntuple layout", GSL_EINVAL);
+    }
+
+  if (size == 0 || ncols == 0 || block == 0)
+    {
+      GSL_ERROR_NULL ("ntuple size, columns and block must be positive",
+                      GSL_EINVAL);
+    }
+
+  for (j = 0; j < ncols; j++)
+    {
+      if (colsize[j] == 0 || offset[j] > size || colsize[j] > size - offset[j])
+        {
+          GSL_ERROR_NULL ("ntuple column lies outside the row", GSL_EINVAL);
+        }
+    }
+
+  ntuple = (gsl_ntuple_blocked *) calloc (1, sizeof (gsl_ntuple_blocked));
+
+  if (ntuple == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for ntuple struct",
+                      GSL_ENOMEM);
+    }
+
+  ntuple->offset = (size_t *) malloc (ncols * sizeof (size_t));
+  ntuple->colsize = (size_t *) malloc (ncols * sizeof (size_t));
+  ntuple->colstart = (size_t *) malloc (ncols * sizeof (size_t));
+  ntuple->stride = (size_t *) malloc (ncols * sizeof (size_t));
+  ntuple->col = (const char **) malloc (ncols * sizeof (const char *));
+  ntuple->buffer = (char *) malloc (block * size);
+
+  if (ntuple->offset == 0 || ntuple->colsize == 0 || ntuple->colstart == 0
+      || ntuple->stride == 0 || ntuple->col == 0 || ntuple->buffer == 0)
+    {
+      blocked_free (ntuple);
+      GSL_ERROR_NULL ("failed to allocate space for ntuple buffers",
+                      GSL_ENOMEM);
+    }
+
+  ntuple->ntuple_data = ntuple_data;
+  ntuple->size = size;
+  ntuple->layout = layout;
+  ntuple->ncols = ncols;
+  ntuple->block = block;
+
+  for (j = 0; j < ncols; j++)
+    {
+      ntuple->offset[j] = offset[j];
+      ntuple->colsize[j] = colsize[j];
+      ntuple->colstart[j] = start;
+      start += colsize[j];
+    }
+
+  if (start > size)
+    {
+      blocked_free (ntuple);
+      GSL_ERROR_NULL ("ntuple columns are larger than the row", GSL_EINVAL);
+    }
+
+  return ntuple;
+}
+
+static void
+blocked_free (gsl_ntuple_blocked * ntuple)
+{
+  free (ntuple->offset);
+  free (ntuple->colsize);
+  free (ntuple->colstart);
+  free (ntuple->stride);
+  free (ntuple->col);
+  free (ntuple->buffer);
+  free (ntuple);
+}
+
+gsl_ntuple_blocked *
+gsl_ntuple_blocked_create (char *filename, void *ntuple_data, size_t size,
+                           const size_t offset[], const size_t colsize[],
+                           size_t ncols, int layout)
+{
+  const size_t row_offset = 0;
+  size_t block = BLOCK_BYTES / GSL_MAX (size, 1);
+  gsl_ntuple_blocked *ntuple;
+  size_t hdr[4], nwrite;
+
+  block = BLOCK_ALIGN * (block / BLOCK_ALIGN + (block % BLOCK_ALIGN != 0));
+
+  if (block == 0)
+    {
+      block = BLOCK_ALIGN;
+    }
+
+  if (ncols == 0)
+    {
+      /* a single column holding the whole row */
+      offset = &row_offset;
+      colsize = &size;
+      ncols = 1;
+    }
+
+  ntuple = blocked_alloc (ntuple_data, size, offset, colsize, ncols, layout,
+                          block);
+
+  if (ntuple == 0)
+    {
+      return 0;
+    }
+
+  ntuple->writing = 1;
+  ntuple->file = fopen (filename, "wb");
+
+  if (ntuple->file == 0)
+    {
+      blocked_free (ntuple);
+      GSL_ERROR_NULL ("unable to create ntuple file", GSL_EFAILED);
+    }
+
+  hdr[0] = layout;
+  hdr[1] = size;
+  hdr[2] = ncols;
+  hdr[3] = block;
+
+  nwrite = fwrite (magic, sizeof (magic), 1, ntuple->file);
+  nwrite += fwrite (hdr, sizeof (size_t), 4, ntuple->file);
+  nwrite += fwrite (ntuple->offset, sizeof (size_t), ncols, ntuple->file);
+  nwrite += fwrite (ntuple->colsize, sizeof (size_t), ncols, ntuple->file);
+
+  if (nwrite != 5 + 2 * ncols)
+    {
+      fclose (ntuple->file);
+      blocked_free (ntuple);
+      GSL_ERROR_NULL ("failed to write ntuple header", GSL_EFAILED);
+    }
+
+  return ntuple;
+}
+
+gsl_ntuple_blocked *
+gsl_ntuple_blocked_open (char *filename, void *ntuple_data, size_t size)
+{
+  gsl_ntuple_blocked *ntuple;
+  FILE *file = fopen (filename, "rb");
+  char m[sizeof (magic)];
+  size_t hdr[4], ncols, *offset, *colsize;
+
+  if (file == 0)
+    {
+      GSL_ERROR_NULL ("unable to open ntuple file for reading", GSL_EFAILED);
+    }
+
+  if (fread (m, sizeof (m), 1, file) != 1
+      || memcmp (m, magic, sizeof (magic)) != 0
+      || fread (hdr, sizeof (size_t), 4, file) != 4)
+    {
+      fclose (file);
+      GSL_ERROR_NULL ("file is not a blocked ntuple file", GSL_EFAILED);
+    }
+
+  if (hdr[1] != size)
+    {
+      fclose (file);
+      GSL_ERROR_NULL ("ntuple size does not match file", GSL_EBADLEN);
+    }
+
+  ncols = hdr[2];
+
+  if (ncols == 0 || ncols > size)
+    {
+      fclose (file);
+      GSL_ERROR_NULL ("invalid number of columns in ntuple file",
+                      GSL_EFAILED);
+    }
+
+  offset = (size_t *) malloc (2 * ncols * sizeof (size_t));
+
+  if (offset == 0)
+    {
+      fclose (file);
+      GSL_ERROR_NULL ("failed to allocate space for ntuple columns",
+                      GSL_ENOMEM);
+    }
+
+  colsize = offset + ncols;
+
+  if (fread (offset, sizeof (size_t), 2 * ncols, file) != 2 * ncols)
+    {
+      free (offset);
+      fclose (file);
+      GSL_ERROR_NULL ("failed to read ntuple header", GSL_EFAILED);
+    }
+
+  ntuple = blocked_alloc (ntuple_data, size, offset, colsize, ncols,
+                          (int) hdr[0], hdr[3]);
+  free (offset);
+
+  if (ntuple == 0)
+    {
+      fclose (file);
+      return 0;
+    }
+
+  ntuple->writing = 0;
+  ntuple->file = file;
+
+  return ntuple;
+}
+
+static int
+flush_block (gsl_ntuple_blocked * ntuple)
+{
+  const size_t m = ntuple->nbuf;
+  size_t j, nwrite = 0, nexpect = 1;
+
+  if (m == 0)
+    {
+      return GSL_SUCCESS;
+    }
+
+  nwrite += fwrite (&m, sizeof (size_t), 1, ntuple->file);
+
+  if (ntuple->layout == GSL_NTUPLE_ROWS)
+    {
+      nwrite += fwrite (ntuple->buffer, ntuple->size, m, ntuple->file);
+      nexpect += m;
+    }
+  else
+    {
+      for (j = 0; j < ntuple->ncols; j++)
+        {
+          const char *c = ntuple->buffer + ntuple->block * ntuple->colstart[j];
+          nwrite += fwrite (c, ntuple->colsize[j], m, ntuple->file);
+          nexpect += m;
+        }
+    }
+
+  ntuple->nbuf = 0;
+
+  if (nwrite != nexpect)
+    {
+      GSL_ERROR ("failed to write ntuple block to file", GSL_EFAILED);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* read the next block into the buffer, reading only the columns with
+   need[j] nonzero (all columns if need is NULL). Returns GSL_EOF at
+   the end of the file. */
+
+static int
+load_block (gsl_ntuple_blocked * ntuple, const int need[])
+{
+  size_t j, m, nread;
+
+  ntuple->nbuf = 0;
+  ntuple->pos = 0;
+
+  nread = fread (&m, sizeof (size_t), 1, ntuple->file);
+
+  if (nread == 0 && feof (ntuple->file))
+    {
+      return GSL_EOF;
+    }
+
+  if (nread != 1 || m == 0 || m > ntuple->block)
+    {
+      GSL_ERROR ("failed to read ntuple block from file", GSL_EFAILED);
+    }
+
+  if (ntuple->layout == GSL_NTUPLE_ROWS)
+    {
+      nread = fread (ntuple->buffer, ntuple->size, m, ntuple->file);
+
+      if (nread != m)
+        {
+          GSL_ERROR ("failed to read ntuple block from file", GSL_EFAILED);
+        }
+    }
+  else
+    {
+      for (j = 0; j < ntuple->ncols; j++)
+        {
+          char *c = ntuple->buffer + ntuple->block * ntuple->colstart[j];
+
+          if (need == 0 || need[j])
+            {
+              nread = fread (c, ntuple->colsize[j], m, ntuple->file);
+
+              if (nread != m)
+                {
+                  GSL_ERROR ("failed to read ntuple block from file",
+                             GSL_EFAILED);
+                }
+            }
+          else if (fseek (ntuple->file, (long) (m * ntuple->colsize[j]),
+                          SEEK_CUR) != 0)
+            {
+              GSL_ERROR ("failed to skip ntuple column in file",
+                         GSL_EFAILED);
+            }
+        }
+    }
+
+  ntuple->nbuf = m;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_ntuple_blocked_write (gsl_ntuple_blocked * ntuple)
+{
+  const char *data = (const char *) ntuple->ntuple_data;
+  size_t j;
+
+  if (!ntuple->writing)
+    {
+      GSL_ERROR ("ntuple file is not open for writing", GSL_EINVAL);
+    }
+
+  if (ntuple->layout == GSL_NTUPLE_ROWS)
+    {
+      memcpy (ntuple->buffer + ntuple->nbuf * ntuple->size, data,
+              ntuple->size);
+    }
+  else
+    {
+      for (j = 0; j < ntuple->ncols; j++)
+        {
+          char *c = ntuple->buffer + ntuple->block * ntuple->colstart[j];
+          memcpy (c + ntuple->nbuf * ntuple->colsize[j],
+                  data + ntuple->offset[j], ntuple->colsize[j]);
+        }
+    }
+
+  ntuple->nbuf++;
+
+  if (ntuple->nbuf == ntuple->block)
+    {
+      return flush_block (ntuple);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_ntuple_blocked_read (gsl_ntuple_blocked * ntuple)
+{
+  char *data = (char *) ntuple->ntuple_data;
+  size_t j;
+
+  if (ntuple->writing)
+    {
+      GSL_ERROR ("ntuple file is not open for reading", GSL_EINVAL);
+    }
+
+  if (ntuple->pos == ntuple->nbuf)
+    {
+      int status = load_block (ntuple, 0);
+
+      if (status)
+        {
+          return status;
+        }
+    }
+
+  if (ntuple->layout == GSL_NTUPLE_ROWS)
+    {
+      memcpy (data, ntuple->buffer + ntuple->pos * ntuple->size,
+              ntuple->size);
+    }
+  else
+    {
+      for (j = 0; j < ntuple->ncols; j++)
+        {
+          const char *c = ntuple->buffer + ntuple->block * ntuple->colstart[j];
+          memcpy (data + ntuple->offset[j], c + ntuple->pos * ntuple->colsize[j],
+                  ntuple->colsize[j]);
+        }
+    }
+
+  ntuple->pos++;
+
+  return GSL_SUCCESS;
+}
+
+/* describe rows pos .. nbuf - 1 of the buffer as a chunk */
+
+static void
+set_chunk (gsl_ntuple_blocked * ntuple, gsl_ntuple_chunk * chunk,
+           const int need[])
+{
+  size_t j;
+
+  for (j = 0; j < ntuple->ncols; j++)
+    {
+      if (ntuple->layout == GSL_NTUPLE_ROWS)
+        {
+          ntuple->stride[j] = ntuple->size;
+          ntuple->col[j] = ntuple->buffer + ntuple->offset[j];
+        }
+      else
+        {
+          ntuple->stride[j] = ntuple->colsize[j];
+          ntuple->col[j] = ntuple->buffer + ntuple->block * ntuple->colstart[j];
+        }
+
+      if (need != 0 && !need[j] && ntuple->layout == GSL_NTUPLE_COLUMNS)
+        {
+          ntuple->col[j] = 0;
+        }
+      else
+        {
+          ntuple->col[j] += ntuple->pos * ntuple->stride[j];
+        }
+    }
+
+  chunk->n = ntuple->nbuf - ntuple->pos;
+  chunk->ncols = ntuple->ncols;
+  chunk->col = ntuple->col;
+  chunk->stride = ntuple->stride;
+}
+
+int
+gsl_ntuple_blocked_project (gsl_histogram * h, gsl_ntuple_blocked * ntuple,
+                            gsl_ntuple_value_array_fn * value_func,
+                            gsl_ntuple_select_array_fn * select_func,
+                            const size_t cols[], size_t ncols)
+{
+  const size_t block = ntuple->block;
+  double *values;
+  int *selected, *need = 0;
+  int status = GSL_SUCCESS;
+  size_t i, j;
+
+  if (ntuple->writing)
+    {
+      GSL_ERROR ("ntuple file is not open for reading", GSL_EINVAL);
+    }
+
+  values = (double *) malloc (block * sizeof (double));
+  selected = (int *) malloc (block * sizeof (int));
+
+  if (cols != 0)
+    {
+      need = (int *) calloc (ntuple->ncols, sizeof (int));
+    }
+
+  if (values == 0 || selected == 0 || (cols != 0 && need == 0))
+    {
+      free (values);
+      free (selected);
+      free (need);
+      GSL_ERROR ("failed to allocate space for projection", GSL_ENOMEM);
+    }
+
+  for (j = 0; cols != 0 && j < ncols; j++)
+    {
+      if (cols[j] >= ntuple->ncols)
+        {
+          free (values);
+          free (selected);
+          free (need);
+          GSL_ERROR ("column index lies outside valid range of 0 .. ncols - 1",
+                     GSL_EINVAL);
+        }
+
+      need[cols[j]] = 1;
+    }
+
+  for (;;)
+    {
+      gsl_ntuple_chunk chunk;
+      size_t n = 0;
+
+      /* rows left in the buffer by gsl_ntuple_blocked_read have all
+         their columns */
+
+      if (ntuple->pos == ntuple->nbuf)
+        {
+          status = load_block (ntuple, need);
+
+          if (status)
+            {
+              break;
+            }
+
+          set_chunk (ntuple, &chunk, need);
+        }
+      else
+        {
+          set_chunk (ntuple, &chunk, 0);
+        }
+
+      if (select_func != 0)
+        {
+          (*(select_func->function)) (&chunk, selected, select_func->params);
+        }
+
+      (*(value_func->function)) (&chunk, values, value_func->params);
+
+      for (i = 0; i < chunk.n; i++)
+        {
+          if (select_func == 0 || selected[i])
+            {
+              values[n++] = values[i];
+            }
+        }
+
+      gsl_histogram_increment_array (h, values, 1, n);
+
+      /* the buffer may hold only some of the columns, so it cannot be
+         used for reading */
+
+      ntuple->pos = ntuple->nbuf = 0;
+    }
+
+  free (values);
+  free (selected);
+  free (need);
+
+  return (status == GSL_EOF) ? GSL_SUCCESS : status;
+}
+
+int
+gsl_ntuple_blocked_close (gsl_ntuple_blocked * ntuple)
+{
+  int status = GSL_SUCCESS;
+
+  if (ntuple->writing)
+    {
+      status = flush_block (ntuple);
+    }
+
+  if (fclose (ntuple->file) != 0)
+    {
+      blocked_free (ntuple);
+      GSL_ERROR ("failed to close ntuple file", GSL_EFAILED);
+    }
+
+  blocked_free (ntuple);
+
+  return status;
+}
@@ -71,8 +71,79 @@ int gsl_ntuple_project (gsl_histogram * h, gsl_ntuple * ntuple,
                         gsl_ntuple_value_fn *value_func,
                         gsl_ntuple_select_fn *select_func);
 
+int gsl_ntuple_nrows (gsl_ntuple * ntuple, size_t * nrows);
+
+int gsl_ntuple_project_range (gsl_histogram * h, gsl_ntuple * ntuple,
+                              gsl_ntuple_value_fn *value_func,
+                              gsl_ntuple_select_fn *select_func,
+                              size_t first, size_t n);
+
 int gsl_ntuple_close (gsl_ntuple * ntuple);
 
+/* blocked ntuple files, with rows or columns stored in blocks */
+
+enum
+{
+  GSL_NTUPLE_ROWS = 0,
+  GSL_NTUPLE_COLUMNS = 1
+};
+
+typedef struct {
+    FILE * file;
+    void * ntuple_data;
+    size_t size;
+    int layout;
+    int writing;
+    size_t ncols;
+    size_t * offset;            /* offset of each column in a row */
+    size_t * colsize;           /* size of each column in bytes */
+    size_t * colstart;          /* start of each column in a block */
+    size_t block;               /* number of rows in a full block */
+    char * buffer;              /* the current block */
+    size_t nbuf;                /* number of rows in the buffer */
+    size_t pos;                 /* next row of the buffer to read */
+    const char ** col;          /* workspace for chunks */
+    size_t * stride;
+} gsl_ntuple_blocked;
+
+typedef struct {
+  size_t n;                     /* number of rows */
+  size_t ncols;
+  const char * const * col;     /* first value of each column, or NULL */
+  const size_t * stride;        /* bytes between values of each column */
+} gsl_ntuple_chunk;
+
+typedef struct {
+  void (* function) (const gsl_ntuple_chunk * chunk, int selected[],
+                     void * params);
+  void * params;
+} gsl_ntuple_select_array_fn;
+
+typedef struct {
+  void (* function) (const gsl_ntuple_chunk * chunk, double values[],
+                     void * params);
+  void * params;
+} gsl_ntuple_value_array_fn;
+
+gsl_ntuple_blocked *
+gsl_ntuple_blocked_create (char * filename, void * ntuple_data, size_t size,
+                           const size_t offset[], const size_t colsize[],
+                           size_t ncols, int layout);
+
+gsl_ntuple_blocked *
+gsl_ntuple_blocked_open (char * filename, void * ntuple_data, size_t size);
+
+int gsl_ntuple_blocked_write (gsl_ntuple_blocked * ntuple);
+int gsl_ntuple_blocked_read (gsl_ntuple_blocked * ntuple);
+
+int gsl_ntuple_blocked_project (gsl_histogram * h,
+                                gsl_ntuple_blocked * ntuple,
+                                gsl_ntuple_value_array_fn * value_func,
+                                gsl_ntuple_select_array_fn * select_func,
+                                const size_t cols[], size_t ncols);
+
+int gsl_ntuple_blocked_close (gsl_ntuple_blocked * ntuple);
+
 __END_DECLS
 
 #endif /* __GSL_NTUPLE_H__ */
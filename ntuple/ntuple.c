@@ -21,6 +21,7 @@
 
 #include <config.h>
 #include <errno.h>
+#include <limits.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_ntuple.h>
 
@@ -148,14 +149,14 @@ gsl_ntuple_read (gsl_ntuple * ntuple)
 
 #define EVAL(f,x) ((*((f)->function))(x,(f)->params))
 
-int
-gsl_ntuple_project (gsl_histogram * h, gsl_ntuple * ntuple,
-                    gsl_ntuple_value_fn * value_func, 
-                    gsl_ntuple_select_fn * select_func)
+static int
+project_rows (gsl_histogram * h, gsl_ntuple * ntuple,
+              gsl_ntuple_value_fn * value_func,
+              gsl_ntuple_select_fn * select_func, size_t n)
 {
   size_t nread;
 
-  do
+  for (; n > 0; n--)
     {
       nread = fread (ntuple->ntuple_data, ntuple->size,
                      1, ntuple->file);
@@ -175,11 +176,74 @@ gsl_ntuple_project (gsl_histogram * h, gsl_ntuple * ntuple,
           gsl_histogram_increment (h, EVAL(value_func, ntuple->ntuple_data));
         }
     }
-  while (1);
 
   return GSL_SUCCESS;
 }
 
+int
+gsl_ntuple_project (gsl_histogram * h, gsl_ntuple * ntuple,
+                    gsl_ntuple_value_fn * value_func, 
+                    gsl_ntuple_select_fn * select_func)
+{
+  return project_rows (h, ntuple, value_func, select_func, (size_t) -1);
+}
+
+/* 
+ * gsl_ntuple_nrows:
+ * count the rows in the ntuple file from its length, leaving the
+ * file position unchanged
+ */
+
+int
+gsl_ntuple_nrows (gsl_ntuple * ntuple, size_t * nrows)
+{
+  long pos = ftell (ntuple->file);
+  long end;
+
+  if (pos < 0 || fseek (ntuple->file, 0L, SEEK_END) != 0)
+    {
+      GSL_ERROR ("failed to find length of ntuple file", GSL_EFAILED);
+    }
+
+  end = ftell (ntuple->file);
+
+  if (fseek (ntuple->file, pos, SEEK_SET) != 0 || end < 0)
+    {
+      GSL_ERROR ("failed to find length of ntuple file", GSL_EFAILED);
+    }
+
+  *nrows = (size_t) end / ntuple->size;
+
+  return GSL_SUCCESS;
+}
+
+/* 
+ * gsl_ntuple_project_range:
+ * as gsl_ntuple_project, for the n rows starting at row first, so
+ * that separate ranges of a file can be histogrammed independently
+ * (e.g. by several threads, each with its own ntuple and histogram)
+ */
+
+int
+gsl_ntuple_project_range (gsl_histogram * h, gsl_ntuple * ntuple,
+                          gsl_ntuple_value_fn * value_func, 
+                          gsl_ntuple_select_fn * select_func,
+                          size_t first, size_t n)
+{
+  if (first > (size_t) LONG_MAX / ntuple->size)
+    {
+      GSL_ERROR ("ntuple row offset too large for file position",
+                 GSL_EOVRFLW);
+    }
+
+  if (fseek (ntuple->file, (long) (first * ntuple->size), SEEK_SET) != 0)
+    {
+      GSL_ERROR ("failed to seek to ntuple row", GSL_EFAILED);
+    }
+
+  return project_rows (h, ntuple, value_func, select_func, n);
+}
+
 
 /* 
  * gsl_ntuple_close:
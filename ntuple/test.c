@@ -1,4 +1,5 @@
 #include <config.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <gsl/gsl_ntuple.h>
@@ -14,6 +15,13 @@ struct data
 };
 int sel_func (void *ntuple_data, void * params);
 double val_func (void *ntuple_data, void * params);
+void sel_array_func (const gsl_ntuple_chunk * chunk, int selected[],
+                     void * params);
+void val_array_func (const gsl_ntuple_chunk * chunk, double values[],
+                     void * params);
+void test_blocked (int layout, const char * desc);
+
+#define NB 20000
 
 int
 main (void)
@@ -136,9 +144,210 @@ main (void)
     gsl_histogram_free (h);
   }
 
+  {
+    const size_t first[4] = { 0, 300, 700, 2000 };
+    const size_t n[4] = { 300, 400, 1000, 10 };
+    gsl_ntuple *ntuple = gsl_ntuple_open ("test.dat", &ntuple_row, 
+                                          sizeof (ntuple_row));
+    gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0., 1.);
+    gsl_histogram *g = gsl_histogram_calloc_uniform (100, 0., 1.);
+    size_t nrows = 0;
+    int status = 0;
+
+    gsl_ntuple_nrows (ntuple, &nrows);
+
+    gsl_test (nrows != 1000, "counting ntuple rows");
+
+    /* the last two ranges extend past the end of the file */
+
+    for (i = 3; i >= 0; i--)
+      {
+        gsl_histogram_reset (g);
+        gsl_ntuple_project_range (g, ntuple, &V, &S, first[i], n[i]);
+        gsl_histogram_add (h, g);
+      }
+
+    gsl_ntuple_close (ntuple);
+
+    for (i = 0; i < 100; i++)
+      {
+        if (h->bin[i] != f[i])
+          {
+            status = 1;
+          }
+      }
+
+    gsl_test (status, "histogramming ntuple ranges");
+
+    gsl_histogram_free (g);
+    gsl_histogram_free (h);
+  }
+
+  test_blocked (GSL_NTUPLE_ROWS, "rows");
+  test_blocked (GSL_NTUPLE_COLUMNS, "columns");
+
   exit (gsl_test_summary());
 }
 
+void
+test_blocked (int layout, const char * desc)
+{
+  const size_t offset[4] = { offsetof (struct data, num),
+                             offsetof (struct data, x),
+                             offsetof (struct data, y),
+                             offsetof (struct data, z) };
+  const size_t colsize[4] = { sizeof (int), sizeof (double),
+                              sizeof (double), sizeof (double) };
+  const size_t cols[3] = { 1, 2, 3 };
+  struct data ntuple_row;
+  gsl_ntuple_select_array_fn S;
+  gsl_ntuple_value_array_fn V;
+  gsl_histogram *f = gsl_histogram_calloc_uniform (100, 0., 1.);
+  double scale = 1.5;
+  int i;
+
+  memset (&ntuple_row, 0, sizeof (struct data));
+
+  S.function = &sel_array_func;
+  S.params = &scale;
+
+  V.function = &val_array_func;
+  V.params = &scale;
+
+  {
+    gsl_ntuple_blocked *ntuple =
+      gsl_ntuple_blocked_create ("test.dat", &ntuple_row, sizeof (ntuple_row),
+                                 offset, colsize, 4, layout);
+    int status = 0;
+
+    for (i = 0; i < NB; i++)
+      {
+        ntuple_row.x = 1.0 / (i + 1.5);
+        ntuple_row.y = ntuple_row.x * ntuple_row.x;
+        ntuple_row.z = ntuple_row.x * ntuple_row.y;
+        ntuple_row.num = i;
+
+        if (sel_func (&ntuple_row, &scale))
+          {
+            gsl_histogram_increment (f, val_func (&ntuple_row, &scale));
+          }
+
+        if (gsl_ntuple_blocked_write (ntuple) != GSL_SUCCESS)
+          {
+            status = 1;
+          }
+      }
+
+    gsl_test (ntuple->block >= NB, "blocked ntuple uses several blocks");
+
+    if (gsl_ntuple_blocked_close (ntuple) != GSL_SUCCESS)
+      {
+        status = 1;
+      }
+
+    gsl_test (status, "writing blocked ntuples, %s", desc);
+  }
+
+  {
+    gsl_ntuple_blocked *ntuple =
+      gsl_ntuple_blocked_open ("test.dat", &ntuple_row, sizeof (ntuple_row));
+    int status = 0;
+
+    for (i = 0; i < NB; i++)
+      {
+        double xi = 1.0 / (i + 1.5);
+
+        status |= (gsl_ntuple_blocked_read (ntuple) != GSL_SUCCESS);
+        status |= (ntuple_row.num != i);
+        status |= (ntuple_row.x != xi);
+        status |= (ntuple_row.y != xi * xi);
+        status |= (ntuple_row.z != xi * (xi * xi));
+      }
+
+    status |= (gsl_ntuple_blocked_read (ntuple) != GSL_EOF);
+
+    gsl_ntuple_blocked_close (ntuple);
+
+    gsl_test (status, "reading blocked ntuples, %s", desc);
+  }
+
+  {
+    int status = 0, k;
+
+    for (k = 0; k < 2; k++)
+      {
+        gsl_ntuple_blocked *ntuple =
+          gsl_ntuple_blocked_open ("test.dat", &ntuple_row,
+                                   sizeof (ntuple_row));
+        gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0., 1.);
+
+        gsl_ntuple_blocked_project (h, ntuple, &V, &S,
+                                    (k == 0) ? NULL : cols, 3);
+
+        gsl_ntuple_blocked_close (ntuple);
+
+        for (i = 0; i < 100; i++)
+          {
+            if (h->bin[i] != f->bin[i])
+              {
+                status = 1;
+              }
+          }
+
+        gsl_histogram_free (h);
+      }
+
+    gsl_test (status, "histogramming blocked ntuples, %s", desc);
+  }
+
+  /* project the rows remaining after a partial read, without a
+     selection function */
+
+  {
+    gsl_ntuple_blocked *ntuple =
+      gsl_ntuple_blocked_open ("test.dat", &ntuple_row, sizeof (ntuple_row));
+    gsl_histogram *h = gsl_histogram_calloc_uniform (100, 0., 1.);
+    gsl_histogram *g = gsl_histogram_calloc_uniform (100, 0., 1.);
+    int status = 0;
+
+    for (i = 0; i < 5; i++)
+      {
+        gsl_ntuple_blocked_read (ntuple);
+      }
+
+    gsl_ntuple_blocked_project (h, ntuple, &V, NULL, cols, 3);
+
+    gsl_ntuple_blocked_close (ntuple);
+
+    for (i = 5; i < NB; i++)
+      {
+        ntuple_row.x = 1.0 / (i + 1.5);
+        ntuple_row.y = ntuple_row.x * ntuple_row.x;
+        ntuple_row.z = ntuple_row.x * ntuple_row.y;
+
+        if (val_func (&ntuple_row, &scale) < 1.0)
+          {
+            gsl_histogram_increment (g, val_func (&ntuple_row, &scale));
+          }
+      }
+
+    for (i = 0; i < 100; i++)
+      {
+        if (h->bin[i] != g->bin[i])
+          {
+            status = 1;
+          }
+      }
+
+    gsl_test (status, "histogramming blocked ntuples after reading, %s", desc);
+
+    gsl_histogram_free (g);
+    gsl_histogram_free (h);
+  }
+
+  gsl_histogram_free (f);
+}
+
 int
 sel_func (void *ntuple_data, void * params)
 {
@@ -164,3 +373,32 @@ val_func (void *ntuple_data, void * params)
 
   return (x + y + z) * scale;
 }
+
+void
+sel_array_func (const gsl_ntuple_chunk * chunk, int selected[], void * params)
+{
+  double scale = *(double *)params;
+  size_t i;
+
+  for (i = 0; i < chunk->n; i++)
+    {
+      const double *x = (const double *) (chunk->col[1] + i * chunk->stride[1]);
+      selected[i] = (*x * scale < 0.1);
+    }
+}
+
+void
+val_array_func (const gsl_ntuple_chunk * chunk, double values[],
+                void * params)
+{
+  double scale = *(double *)params;
+  size_t i;
+
+  for (i = 0; i < chunk->n; i++)
+    {
+      const double *x = (const double *) (chunk->col[1] + i * chunk->stride[1]);
+      const double *y = (const double *) (chunk->col[2] + i * chunk->stride[2]);
+      const double *z = (const double *) (chunk->col[3] + i * chunk->stride[3]);
+      values[i] = (*x + *y + *z) * scale;
+    }
+}
@@ -7,6 +7,7 @@
 #include <gsl/gsl_types.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_inline.h>
+#include <gsl/gsl_rng.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -32,6 +33,9 @@ typedef struct
   size_t (*state_size) (unsigned int dimension);
   int (*init_state) (void * state, unsigned int dimension);
   int (*get) (void * state, unsigned int dimension, double x[]);
+  int (*get_array) (void * state, unsigned int dimension, double x[], size_t n);
+  int (*skip) (void * state, unsigned int dimension, unsigned long int n);
+  int (*scramble) (void * state, unsigned int dimension, const gsl_rng * r);
 }
 gsl_qrng_type;
 
@@ -93,6 +97,20 @@ size_t gsl_qrng_size (const gsl_qrng * q);
 void * gsl_qrng_state (const gsl_qrng * q);
 
 
+/* Retrieve the next n vectors in sequence, stored one after
+ * another in x[], which must have room for n * dimension values.
+ */
+int gsl_qrng_get_array (const gsl_qrng * q, double x[], size_t n);
+
+
+/* Move forward n vectors in the sequence. */
+int gsl_qrng_skip (const gsl_qrng * q, unsigned long int n);
+
+
+/* Randomize the sequence using random numbers from r. */
+int gsl_qrng_scramble (gsl_qrng * q, const gsl_rng * r);
+
+
 /* Retrieve next vector in sequence. */
 INLINE_DECL int gsl_qrng_get (const gsl_qrng * q, double x[]);
 
@@ -109,6 +109,76 @@ gsl_qrng_state (const gsl_qrng * q)
 }
 
 
+/* Bulk generation and skipping. Generators may supply get_array and
+   skip functions, otherwise the points are generated one at a time.
+   In both cases the sequence is identical to repeated calls of
+   gsl_qrng_get. */
+
+int
+gsl_qrng_get_array (const gsl_qrng * q, double x[], size_t n)
+{
+  if (q->type->get_array)
+    {
+      return (q->type->get_array) (q->state, q->dimension, x, n);
+    }
+  else
+    {
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        {
+          int status = (q->type->get) (q->state, q->dimension,
+                                       x + i * q->dimension);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_qrng_skip (const gsl_qrng * q, unsigned long int n)
+{
+  if (q->type->skip)
+    {
+      return (q->type->skip) (q->state, q->dimension, n);
+    }
+  else
+    {
+      double * x = (double *) malloc (q->dimension * sizeof (double));
+      unsigned long int i;
+      int status = GSL_SUCCESS;
+
+      if (x == 0)
+        {
+          GSL_ERROR ("failed to allocate space for point", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < n && status == GSL_SUCCESS; i++)
+        status = (q->type->get) (q->state, q->dimension, x);
+
+      free (x);
+
+      return status;
+    }
+}
+
+/* Scrambling replaces the sequence by a randomized version with the
+   same low discrepancy properties, for use in randomized quasi-Monte
+   Carlo. Only generators with a scramble function support this. */
+
+int
+gsl_qrng_scramble (gsl_qrng * q, const gsl_rng * r)
+{
+  if (q->type->scramble == 0)
+    {
+      GSL_ERROR ("generator does not support scrambling", GSL_EUNSUP);
+    }
+
+  return (q->type->scramble) (q->state, q->dimension, r);
+}
+
 void
 gsl_qrng_free (gsl_qrng * q)
 {
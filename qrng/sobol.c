@@ -4,21 +4,47 @@
  * See
  *   [Bratley+Fox, TOMS 14, 88 (1988)]
  *   [Antonov+Saleev, USSR Comput. Maths. Math. Phys. 19, 252 (1980)]
+ *
+ * Dimensions beyond the Bratley+Fox table use the remaining primitive
+ * polynomials over GF(2) of degree up to 18, in order of increasing
+ * degree, with the initial direction numbers of
+ * [Joe+Kuo, SIAM J. Sci. Comput. 30, 2635 (2008)], see sobol_joe_kuo.h.
+ *
+ * Scrambling is the linear matrix scrambling with a random digital
+ * shift of [Matousek, J. Complexity 14, 527 (1998)], applied to the
+ * direction numbers so that the Gray code recursion is unchanged.
  */
 #include <config.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
 #include <gsl/gsl_qrng.h>
 
+#include "sobol_joe_kuo.h"
 
-/* maximum allowed space dimension */
-#define SOBOL_MAX_DIMENSION 40
+/* maximum allowed space dimension,
+ * SOBOL_TABLE_DIMENSION + SOBOL_JK_DIMENSION
+ */
+#define SOBOL_MAX_DIMENSION 21201
+
+/* number of dimensions with tabulated initial values */
+#define SOBOL_TABLE_DIMENSION 40
+
+/* maximum degree of the primitive polynomials */
+#define SOBOL_MAX_DEGREE 18
 
 /* bit count; assumes sizeof(int) >= 32-bit */
 #define SOBOL_BIT_COUNT 30
 
+/* number of points available, 2^SOBOL_BIT_COUNT - 1 */
+#define SOBOL_MAX_COUNT ((1UL << SOBOL_BIT_COUNT) - 1)
+
 /* prototypes for generator type functions */
 static size_t sobol_state_size(unsigned int dimension);
 static int sobol_init(void * state, unsigned int dimension);
 static int sobol_get(void * state, unsigned int dimension, double * v);
+static int sobol_get_array(void * state, unsigned int dimension, double * v, size_t n);
+static int sobol_skip(void * state, unsigned int dimension, unsigned long int n);
+static int sobol_scramble(void * state, unsigned int dimension, const gsl_rng * r);
 
 /* global Sobol generator type object */
 static const gsl_qrng_type sobol_type = 
@@ -27,14 +53,17 @@ static const gsl_qrng_type sobol_type =
   SOBOL_MAX_DIMENSION,
   sobol_state_size,
   sobol_init,
-  sobol_get
+  sobol_get,
+  sobol_get_array,
+  sobol_skip,
+  sobol_scramble
 };
 const gsl_qrng_type * gsl_qrng_sobol = &sobol_type;
 
 
 /* primitive polynomials in binary encoding
  */
-static const int primitive_polynomials[SOBOL_MAX_DIMENSION] = 
+static const int primitive_polynomials[SOBOL_TABLE_DIMENSION] = 
 {
   1,     3,   7,  11,  13,  19,  25,  37,  59,  47,
   61,   55,  41,  67,  97,  91, 109, 103, 115, 131,
@@ -43,7 +72,7 @@ static const int primitive_polynomials[SOBOL_MAX_DIMENSION] =
 };
 
 /* degrees of the primitive polynomials */
-static const int degree_table[SOBOL_MAX_DIMENSION] = 
+static const int degree_table[SOBOL_TABLE_DIMENSION] = 
 {
   0, 1, 2, 3, 3, 4, 4, 5, 5, 5,
   5, 5, 5, 6, 6, 6, 6, 6, 6, 7,
@@ -55,7 +84,7 @@ static const int degree_table[SOBOL_MAX_DIMENSION] =
 /* initial values for direction tables, following
  * Bratley+Fox, taken from [Sobol+Levitan, preprint 1976]
  */
-static const int v_init[8][SOBOL_MAX_DIMENSION] =
+static const int v_init[8][SOBOL_TABLE_DIMENSION] =
 {
   {
     0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -110,72 +139,124 @@ static const int v_init[8][SOBOL_MAX_DIMENSION] =
 
 /* Sobol generator state.
  *   sequence_count       = number of calls with this generator
- *   last_numerator_vec   = last generated numerator vector
  *   last_denominator_inv = 1/denominator for last numerator vector
- *   v_direction          = direction number table
+ *
+ * followed by the arrays
+ *   last_numerator_vec   = last generated numerator vector
+ *   shift                = digital shift of each dimension
+ *   v_direction          = direction number table, v_direction[j][i_dim]
+ *                          at offset j*dimension + i_dim
+ *
+ * The arrays are located by offset rather than by pointer so that
+ * the state can be copied with memcpy.
  */
 typedef struct
 {
-  unsigned int  sequence_count;
-  double        last_denominator_inv;
-  int           last_numerator_vec[SOBOL_MAX_DIMENSION];
-  int           v_direction[SOBOL_BIT_COUNT][SOBOL_MAX_DIMENSION];
+  unsigned long int sequence_count;
+  double            last_denominator_inv;
 } sobol_state_t;
 
-/* NOTE: I fixed the size for the preliminary implementation.
-   This could/should be relaxed, as an optimization.
- */
+#define SOBOL_NUMERATOR(s) ((unsigned int *) ((char *) (s) + sizeof(sobol_state_t)))
+#define SOBOL_SHIFT(s,d) (SOBOL_NUMERATOR(s) + (d))
+#define SOBOL_DIRECTION(s,d) (SOBOL_NUMERATOR(s) + 2*(d))
 
 static size_t sobol_state_size(unsigned int dimension)
 {
-  return sizeof(sobol_state_t);
+  return sizeof(sobol_state_t)
+    + (SOBOL_BIT_COUNT + 2) * (size_t) dimension * sizeof(unsigned int);
+}
+
+
+/* Reset the numerators to the point with the given sequence count,
+ * which is the sum of the direction numbers selected by the bits of
+ * the Gray code of the count.
+ */
+static void sobol_set_count(void * state, unsigned int dimension,
+                            unsigned long int count)
+{
+  sobol_state_t * s_state = (sobol_state_t *) state;
+  unsigned int * num = SOBOL_NUMERATOR(state);
+  const unsigned int * shift = SOBOL_SHIFT(state, dimension);
+  const unsigned int * v = SOBOL_DIRECTION(state, dimension);
+  const unsigned long int gray = count ^ (count >> 1);
+  unsigned int i_dim;
+  int j;
+
+  for(i_dim=0; i_dim<dimension; i_dim++) num[i_dim] = shift[i_dim];
+
+  for(j=0; j<SOBOL_BIT_COUNT; j++) {
+    if((gray >> j) & 1) {
+      const unsigned int * v_j = v + (size_t) j * dimension;
+      for(i_dim=0; i_dim<dimension; i_dim++) num[i_dim] ^= v_j[i_dim];
+    }
+  }
+
+  s_state->sequence_count = count;
 }
 
 
 static int sobol_init(void * state, unsigned int dimension)
 {
   sobol_state_t * s_state = (sobol_state_t *) state;
+  unsigned int * shift = SOBOL_SHIFT(state, dimension);
+  unsigned int * v_direction = SOBOL_DIRECTION(state, dimension);
+  const unsigned int * m_init = sobol_jk_minit;
   unsigned int i_dim;
   int j, k;
-  int ell;
+  unsigned int ell;
 
   if(dimension < 1 || dimension > SOBOL_MAX_DIMENSION) {
     return GSL_EINVAL;
   }
 
+#define V(j,i) v_direction[(size_t) (j) * dimension + (i)]
+
   /* Initialize direction table in dimension 0. */
-  for(k=0; k<SOBOL_BIT_COUNT; k++) s_state->v_direction[k][0] = 1;
+  for(k=0; k<SOBOL_BIT_COUNT; k++) V(k,0) = 1;
 
   /* Initialize in remaining dimensions. */
   for(i_dim=1; i_dim<dimension; i_dim++) {
 
-    const int poly_index = i_dim;
-    const int degree_i = degree_table[poly_index];
-    int includ[8];
+    int degree_i;
+    int includ[SOBOL_MAX_DEGREE];
+    unsigned long int p_i;
+
+    if(i_dim < SOBOL_TABLE_DIMENSION) {
+      degree_i = degree_table[i_dim];
+      p_i = primitive_polynomials[i_dim];
+
+      /* Leading elements for dimension i come from v_init[][]. */
+      for(j=0; j<degree_i; j++) V(j,i_dim) = v_init[j][i_dim];
+    }
+    else {
+      p_i = sobol_jk_poly[i_dim - SOBOL_TABLE_DIMENSION];
+      for(degree_i = 0; (p_i >> (degree_i + 1)) != 0; degree_i++) ;
+
+      /* Leading elements come from the Joe+Kuo table, which
+       * lists them for one polynomial after another.
+       */
+      for(j=0; j<degree_i; j++) V(j,i_dim) = *m_init++;
+    }
 
     /* Expand the polynomial bit pattern to separate
      * components of the logical array includ[].
      */
-    int p_i = primitive_polynomials[poly_index];
     for(k = degree_i-1; k >= 0; k--) {
       includ[k] = ((p_i % 2) == 1);
       p_i /= 2;
     }
 
-    /* Leading elements for dimension i come from v_init[][]. */
-    for(j=0; j<degree_i; j++) s_state->v_direction[j][i_dim] = v_init[j][i_dim];
-
     /* Calculate remaining elements for this dimension,
      * as explained in Bratley+Fox, section 2.
      */
     for(j=degree_i; j<SOBOL_BIT_COUNT; j++) {
-      int newv = s_state->v_direction[j-degree_i][i_dim];
+      unsigned int newv = V(j-degree_i,i_dim);
       ell = 1;
       for(k=0; k<degree_i; k++) {
         ell *= 2;
-        if(includ[k]) newv ^= (ell * s_state->v_direction[j-k-1][i_dim]);
+        if(includ[k]) newv ^= (ell * V(j-k-1,i_dim));
       }
-      s_state->v_direction[j][i_dim] = newv;
+      V(j,i_dim) = newv;
     }
   }
 
@@ -184,48 +265,142 @@ static int sobol_init(void * state, unsigned int dimension)
   for(j=SOBOL_BIT_COUNT-1-1; j>=0; j--) {
     ell *= 2;
     for(i_dim=0; i_dim<dimension; i_dim++) {
-      s_state->v_direction[j][i_dim] *= ell;
+      V(j,i_dim) *= ell;
     }
   }
 
+#undef V
+
   /* 1/(common denominator of the elements in v_direction) */
   s_state->last_denominator_inv = 1.0 /(2.0 * ell);
 
   /* final setup */
-  s_state->sequence_count = 0;
-  for(i_dim=0; i_dim<dimension; i_dim++) s_state->last_numerator_vec[i_dim] = 0;
+  for(i_dim=0; i_dim<dimension; i_dim++) shift[i_dim] = 0;
+  sobol_set_count(state, dimension, 0);
 
   return GSL_SUCCESS;
 }
 
 
 static int sobol_get(void * state, unsigned int dimension, double * v)
+{
+  return sobol_get_array(state, dimension, v, 1);
+}
+
+
+static int sobol_get_array(void * state, unsigned int dimension, double * v, size_t n)
 {
   sobol_state_t * s_state = (sobol_state_t *) state;
+  unsigned int * num = SOBOL_NUMERATOR(state);
+  const unsigned int * v_direction = SOBOL_DIRECTION(state, dimension);
+  const double inv = s_state->last_denominator_inv;
+  size_t m;
+
+  for(m=0; m<n; m++, v += dimension) {
+    const unsigned int * direction;
+    unsigned int i_dimension;
+
+    /* Find the position of the least-significant zero in count. */
+    int ell = 0;
+    unsigned long int c = s_state->sequence_count;
+
+    /* Check for exhaustion. */
+    if(c >= SOBOL_MAX_COUNT) return GSL_EFAILED; /* FIXME: good return code here */
+
+    while(c & 1) {
+      ++ell;
+      c >>= 1;
+    }
 
-  unsigned int i_dimension;
+    direction = v_direction + (size_t) ell * dimension;
 
-  /* Find the position of the least-significant zero in count. */
-  int ell = 0;
-  int c = s_state->sequence_count;
-  while(1) {
-    ++ell;
-    if((c % 2) == 1) c /= 2;
-    else break;
+    for(i_dimension=0; i_dimension<dimension; i_dimension++) {
+      const unsigned int new_numerator_i = num[i_dimension] ^ direction[i_dimension];
+      num[i_dimension] = new_numerator_i;
+      v[i_dimension] = new_numerator_i * inv;
+    }
+
+    s_state->sequence_count++;
+  }
+
+  return GSL_SUCCESS;
+}
+
+
+static int sobol_skip(void * state, unsigned int dimension, unsigned long int n)
+{
+  sobol_state_t * s_state = (sobol_state_t *) state;
+
+  if(n > SOBOL_MAX_COUNT - s_state->sequence_count) {
+    s_state->sequence_count = SOBOL_MAX_COUNT;
+    return GSL_EFAILED;
+  }
+
+  sobol_set_count(state, dimension, s_state->sequence_count + n);
+
+  return GSL_SUCCESS;
+}
+
+
+/* random integer with the given number of bits */
+static unsigned int random_bits(const gsl_rng * r, int bits)
+{
+  unsigned int x = 0;
+
+  while(bits > 0) {
+    const int b = (bits < 8) ? bits : 8;
+    x = (x << b) | (unsigned int) gsl_rng_uniform_int(r, 1UL << b);
+    bits -= b;
   }
 
-  /* Check for exhaustion. */
-  if(ell > SOBOL_BIT_COUNT) return GSL_EFAILED; /* FIXME: good return code here */
+  return x;
+}
+
+
+/* Replace the direction numbers v by L v, where L is a random
+ * nonsingular lower triangular matrix in the ordering of the binary
+ * digits, most significant first, and add a random digital shift.
+ * Bit b of the result is the parity of x & row[b], where row[b] has
+ * bit b set and random bits in the more significant positions.
+ */
+static int sobol_scramble(void * state, unsigned int dimension, const gsl_rng * r)
+{
+  sobol_state_t * s_state = (sobol_state_t *) state;
+  unsigned int * shift = SOBOL_SHIFT(state, dimension);
+  unsigned int * v_direction = SOBOL_DIRECTION(state, dimension);
+  unsigned int i_dim;
+  int b, j;
+
+  for(i_dim=0; i_dim<dimension; i_dim++) {
+    unsigned int row[SOBOL_BIT_COUNT];
+
+    for(b=0; b<SOBOL_BIT_COUNT; b++) {
+      const int upper = SOBOL_BIT_COUNT - 1 - b;
+      row[b] = (upper > 0) ? (random_bits(r, upper) << (b + 1)) : 0;
+      row[b] |= 1U << b;
+    }
+
+    for(j=0; j<SOBOL_BIT_COUNT; j++) {
+      unsigned int * vj = v_direction + (size_t) j * dimension + i_dim;
+      unsigned int y = 0;
+
+      for(b=0; b<SOBOL_BIT_COUNT; b++) {
+        unsigned int t = *vj & row[b];
+        t ^= t >> 16;
+        t ^= t >> 8;
+        t ^= t >> 4;
+        t ^= t >> 2;
+        t ^= t >> 1;
+        y |= (t & 1) << b;
+      }
+
+      *vj = y;
+    }
 
-  for(i_dimension=0; i_dimension<dimension; i_dimension++) {
-    const int direction_i     = s_state->v_direction[ell-1][i_dimension];
-    const int old_numerator_i = s_state->last_numerator_vec[i_dimension];
-    const int new_numerator_i = old_numerator_i ^ direction_i;
-    s_state->last_numerator_vec[i_dimension] = new_numerator_i;
-    v[i_dimension] = new_numerator_i * s_state->last_denominator_inv;
+    shift[i_dim] = random_bits(r, SOBOL_BIT_COUNT);
   }
 
-  s_state->sequence_count++;
+  sobol_set_count(state, dimension, s_state->sequence_count);
 
   return GSL_SUCCESS;
 }
@@ -4,6 +4,8 @@
 #include <stdlib.h>
 #include <gsl/gsl_ieee_utils.h>
 
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
 #include <gsl/gsl_qrng.h>
 #include <gsl/gsl_test.h>
 #include <math.h>
@@ -51,6 +53,176 @@ void test_sobol(void)
   gsl_test (status, "Sobol d=3 (reinitialized)");
 }
 
+/* Check that the first 2^m - 1 points fall into distinct intervals
+ * of width 2^-m in each of the first ndim coordinates, as they do for
+ * any (t,s)-sequence in base 2, scrambled or not.
+ */
+static int
+check_sobol_intervals(const gsl_qrng * g, unsigned int ndim, int m)
+{
+  const unsigned int dim = g->dimension;
+  const size_t n = (1UL << m) - 1;
+  double * x = malloc(n * dim * sizeof(double));
+  char * seen = malloc(n + 1);
+  unsigned int i;
+  size_t k;
+  int status = 0;
+
+  status += gsl_qrng_get_array(g, x, n);
+
+  for(i=0; i<ndim; i++) {
+    for(k=0; k<=n; k++) seen[k] = 0;
+
+    for(k=0; k<n; k++) {
+      const double v = x[k * dim + i];
+      size_t bin = (size_t) (v * (n + 1));
+      status += (v < 0.0 || v >= 1.0 || seen[bin]);
+      seen[bin] = 1;
+    }
+  }
+
+  free(seen);
+  free(x);
+
+  return status;
+}
+
+void test_sobol_extended(void)
+{
+  const size_t n = 100;
+  const unsigned int dims[3] = { 3, 41, 1000 };
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_mt19937);
+  double * x = malloc(n * 1000 * sizeof(double));
+  double * y = malloc(1000 * sizeof(double));
+  int t;
+
+  for(t=0; t<3; t++) {
+    const unsigned int d = dims[t];
+    int pass;
+
+    for(pass=0; pass<2; pass++) {
+      gsl_qrng * g = gsl_qrng_alloc(gsl_qrng_sobol, d);
+      gsl_qrng * h, * h0;
+      size_t k;
+      unsigned int i;
+      int status = 0;
+
+      if(pass == 1) gsl_qrng_scramble(g, r);
+      h = gsl_qrng_clone(g);
+      h0 = gsl_qrng_clone(g);
+
+      /* bulk generation matches repeated calls */
+      status += gsl_qrng_get_array(g, x, n);
+
+      for(k=0; k<n; k++) {
+        gsl_qrng_get(h, y);
+        for(i=0; i<d; i++) status += (x[k * d + i] != y[i]);
+      }
+
+      gsl_test(status, "Sobol d=%u%s get_array", d, pass ? " scrambled" : "");
+
+      /* skipping matches discarding points */
+      status = 0;
+      gsl_qrng_skip(g, 1000);
+      for(k=0; k<1000; k++) gsl_qrng_get(h, y);
+      gsl_qrng_skip(h, 0);
+
+      for(k=0; k<3; k++) {
+        gsl_qrng_get(g, x);
+        gsl_qrng_get(h, y);
+        for(i=0; i<d; i++) status += (x[i] != y[i]);
+      }
+
+      gsl_test(status, "Sobol d=%u%s skip", d, pass ? " scrambled" : "");
+
+      /* h0 is still at the start of the (scrambled) sequence */
+      gsl_test(check_sobol_intervals(h0, d, 10), "Sobol d=%u%s intervals",
+               d, pass ? " scrambled" : "");
+
+      gsl_qrng_free(h0);
+      gsl_qrng_free(h);
+      gsl_qrng_free(g);
+    }
+  }
+
+  {
+    /* maximum dimension, last coordinates use degree 18 polynomials */
+    gsl_qrng * g = gsl_qrng_alloc(gsl_qrng_sobol, 21201);
+    gsl_test(check_sobol_intervals(g, 21201, 6), "Sobol d=21201 intervals");
+    gsl_qrng_free(g);
+  }
+
+  {
+    /* first points in Joe+Kuo dimensions with polynomials 301 and
+     * 65533, and in the last dimension the point with Gray code 2^j
+     * after skipping 2^(j+1) - 2 points, which is m_{j+1} / 2^(j+1)
+     * for the published initial numbers of polynomial 524263
+     */
+    static const double x40[8] =
+      { 0.5, 0.25, 0.75, 0.875, 0.375, 0.625, 0.125, 0.5625 };
+    static const double x3666[8] =
+      { 0.5, 0.25, 0.75, 0.625, 0.125, 0.875, 0.375, 0.8125 };
+    static const unsigned int m21200[18] =
+      { 1, 1, 7, 11, 15, 7, 37, 239, 337, 245, 1557, 3681, 7357, 9639,
+        27367, 26869, 114603, 86317 };
+    gsl_qrng * g = gsl_qrng_alloc(gsl_qrng_sobol, 21201);
+    double * v = malloc(21201 * sizeof(double));
+    int status = 0;
+
+    for(t=0; t<8; t++) {
+      gsl_qrng_get(g, v);
+      status += (v[40] != x40[t] || v[3666] != x3666[t]);
+    }
+
+    for(t=0; t<18; t++) {
+      gsl_qrng_init(g);
+      gsl_qrng_skip(g, (2UL << t) - 2);
+      gsl_qrng_get(g, v);
+      status += (v[21200] != ldexp(m21200[t], -(t + 1)));
+    }
+
+    free(v);
+    gsl_qrng_free(g);
+
+    gsl_test(status, "Sobol d=21201 Joe-Kuo direction numbers");
+  }
+
+  {
+    /* exhaustion after 2^30 - 1 points */
+    gsl_qrng * g = gsl_qrng_alloc(gsl_qrng_sobol, 2);
+    int status = 0;
+
+    status += (gsl_qrng_skip(g, (1UL << 30) - 2) != GSL_SUCCESS);
+    gsl_qrng_get(g, x);
+    status += (x[0] != ldexp(1.0, -30) || x[1] <= 0.0 || x[1] >= 1.0);
+    status += (gsl_qrng_get(g, x) != GSL_EFAILED);
+    gsl_qrng_init(g);
+    status += (gsl_qrng_skip(g, 1UL << 30) != GSL_EFAILED);
+    gsl_qrng_free(g);
+
+    gsl_test(status, "Sobol d=2 exhaustion");
+  }
+
+  {
+    gsl_qrng * g = gsl_qrng_alloc(gsl_qrng_halton, 2);
+    gsl_error_handler_t * old = gsl_set_error_handler_off();
+    int status = (gsl_qrng_scramble(g, r) != GSL_EUNSUP);
+
+    gsl_qrng_get(g, x);
+    gsl_qrng_skip(g, 1);
+    gsl_qrng_get(g, y);
+    status += fabs(x[0] - 0.5) > 1e-15 || fabs(y[0] - 0.75) > 1e-15;
+    gsl_set_error_handler(old);
+    gsl_qrng_free(g);
+
+    gsl_test(status, "Halton d=2 skip and scramble");
+  }
+
+  free(y);
+  free(x);
+  gsl_rng_free(r);
+}
+
 void test_halton(void)
 {
 	int status = 0;
@@ -239,6 +411,7 @@ int main()
   gsl_ieee_env_setup ();
 
   test_sobol();
+  test_sobol_extended();
 	test_halton();
 	test_reversehalton();
   test_nied2();
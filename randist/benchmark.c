@@ -0,0 +1,140 @@
+/* randist/benchmark.c
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+/* Compare the rates of the scalar and array samplers, in variates per
+   second */
+
+#define N  1000000
+#define NBLOCK 1000
+
+double dsum;
+
+static double
+scalar_gaussian (const gsl_rng * r)
+{
+  return gsl_ran_gaussian_ziggurat (r, 1.0);
+}
+
+static double
+scalar_exponential (const gsl_rng * r)
+{
+  return gsl_ran_exponential (r, 1.0);
+}
+
+static double
+scalar_flat (const gsl_rng * r)
+{
+  return gsl_ran_flat (r, 0.0, 1.0);
+}
+
+static void
+array_gaussian (const gsl_rng * r, double * x, size_t n)
+{
+  gsl_ran_gaussian_array (r, 1.0, x, n);
+}
+
+static void
+array_exponential (const gsl_rng * r, double * x, size_t n)
+{
+  gsl_ran_exponential_array (r, 1.0, x, n);
+}
+
+static void
+array_flat (const gsl_rng * r, double * x, size_t n)
+{
+  gsl_ran_flat_array (r, 0.0, 1.0, x, n);
+}
+
+void benchmark (const gsl_rng_type * T, const char * name,
+                double (*f) (const gsl_rng *),
+                void (*fa) (const gsl_rng *, double *, size_t));
+
+void run (const gsl_rng_type * T);
+
+int
+main (void)
+{
+  run (gsl_rng_mt19937);
+  run (gsl_rng_taus2);
+  run (gsl_rng_philox4x32);
+
+  return 0;
+}
+
+void
+run (const gsl_rng_type * T)
+{
+  benchmark (T, "gaussian", &scalar_gaussian, &array_gaussian);
+  benchmark (T, "exponential", &scalar_exponential, &array_exponential);
+  benchmark (T, "flat", &scalar_flat, &array_flat);
+}
+
+void
+benchmark (const gsl_rng_type * T, const char * name,
+           double (*f) (const gsl_rng *),
+           void (*fa) (const gsl_rng *, double *, size_t))
+{
+  int start, end;
+  int d = 0, da = 0;
+  double t1, t2;
+  double buf[NBLOCK];
+
+  gsl_rng *r = gsl_rng_alloc (T);
+
+  start = clock ();
+  do
+    {
+      int j;
+      for (j = 0; j < N; j++)
+        dsum += f (r);
+
+      d += N;
+      end = clock ();
+    }
+  while (end < start + CLOCKS_PER_SEC/10);
+
+  t1 = (end - start) / (double) CLOCKS_PER_SEC;
+
+  start = clock ();
+  do
+    {
+      int j, k;
+      for (j = 0; j < N; j += NBLOCK)
+        {
+          fa (r, buf, NBLOCK);
+          for (k = 0; k < NBLOCK; k++)
+            dsum += buf[k];
+        }
+
+      da += N;
+      end = clock ();
+    }
+  while (end < start + CLOCKS_PER_SEC/10);
+
+  t2 = (end - start) / (double) CLOCKS_PER_SEC;
+
+  printf ("%6.0f k variates/sec, %6.0f k variates/sec (array), %s, %s\n",
+          d / t1 / 1000.0, da / t2 / 1000.0, name, gsl_rng_name (r));
+
+  gsl_rng_free (r);
+}
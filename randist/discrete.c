@@ -404,3 +404,195 @@ gsl_ran_discrete_pdf(size_t k, const gsl_ran_discrete_t *g)
     }
     return p/K;
 }
+
+/*** Begin dynamic discrete distribution ***/
+
+/* The Walker tables must be rebuilt from scratch whenever one of the
+ * probabilities changes.  When the weights change often, it is
+ * cheaper to keep them in the leaves of a complete binary tree whose
+ * internal nodes hold the sums of their two children.  Changing a
+ * weight updates the log2(K) sums on the path to the root, and an
+ * event is chosen by drawing u uniformly in [0,total) and descending
+ * from the root, going left if u is less than the sum of the left
+ * subtree and otherwise subtracting that sum and going right.
+
+ * The tree is stored in an array of 2*M doubles, where M is the
+ * smallest power of two not less than K.  Node i has children 2i and
+ * 2i+1, the root is node 1 and the leaves are M..M+K-1; the remaining
+ * leaves are zero.  Each sum is recomputed from its two children
+ * rather than updated by the change in weight, so rounding errors do
+ * not accumulate however many updates are made, and a subtree with
+ * zero weight is never entered.
+ */
+
+gsl_ran_discrete_dynamic_t *
+gsl_ran_discrete_dynamic_alloc(size_t Kevents, const double *ProbArray)
+{
+    size_t k, M;
+    gsl_ran_discrete_dynamic_t *g;
+
+    if (Kevents < 1) {
+      GSL_ERROR_VAL ("number of events must be a positive integer",
+                        GSL_EINVAL, 0);
+    }
+
+    if (ProbArray != NULL) {
+      for (k=0; k<Kevents; ++k) {
+        if (!(ProbArray[k] >= 0)) {
+          GSL_ERROR_VAL ("probabilities must be non-negative",
+                            GSL_EINVAL, 0) ;
+        }
+      }
+    }
+
+    for (M=1; M<Kevents; M *= 2)
+      ;
+
+    g = (gsl_ran_discrete_dynamic_t *)malloc(sizeof(gsl_ran_discrete_dynamic_t));
+
+    if (g == NULL) {
+      GSL_ERROR_VAL ("failed to allocate space for struct", GSL_ENOMEM, 0);
+    }
+
+    g->tree = (double *)malloc(sizeof(double)*2*M);
+
+    if (g->tree == NULL) {
+      free(g);
+      GSL_ERROR_VAL ("failed to allocate space for tree", GSL_ENOMEM, 0);
+    }
+
+    g->K = Kevents;
+    g->M = M;
+
+    for (k=0; k<M; ++k) {
+        g->tree[M+k] = (ProbArray != NULL && k < Kevents) ? ProbArray[k] : 0.0;
+    }
+
+    for (k=M-1; k>0; --k) {
+        g->tree[k] = g->tree[2*k] + g->tree[2*k+1];
+    }
+
+    g->tree[0] = 0.0;           /* unused */
+
+    return g;
+}
+
+void
+gsl_ran_discrete_dynamic_free(gsl_ran_discrete_dynamic_t *g)
+{
+    RETURN_IF_NULL (g);
+    free((char *)(g->tree));
+    free((char *)g);
+}
+
+int
+gsl_ran_discrete_dynamic_set(gsl_ran_discrete_dynamic_t *g, size_t k, double w)
+{
+    double *const tree = g->tree;
+    size_t i;
+
+    if (k >= g->K) {
+      GSL_ERROR ("index out of range", GSL_EINVAL);
+    }
+
+    if (!(w >= 0)) {
+      GSL_ERROR ("probabilities must be non-negative", GSL_EINVAL);
+    }
+
+    i = g->M + k;
+    tree[i] = w;
+
+    for (i /= 2; i > 0; i /= 2) {
+        tree[i] = tree[2*i] + tree[2*i+1];
+    }
+
+    return GSL_SUCCESS;
+}
+
+double
+gsl_ran_discrete_dynamic_get(const gsl_ran_discrete_dynamic_t *g, size_t k)
+{
+    if (k >= g->K) {
+      GSL_ERROR_VAL ("index out of range", GSL_EINVAL, 0);
+    }
+
+    return g->tree[g->M + k];
+}
+
+double
+gsl_ran_discrete_dynamic_total(const gsl_ran_discrete_dynamic_t *g)
+{
+    return g->tree[1];
+}
+
+/* choose the leaf for a point u*total, with u in [0,1) */
+
+static inline size_t
+discrete_dynamic_search(const gsl_ran_discrete_dynamic_t *g, double u)
+{
+    const double *const tree = g->tree;
+    const size_t M = g->M;
+    size_t i = 1;
+
+    u *= tree[1];
+
+    while (i < M) {
+        const double left = tree[2*i];
+        i *= 2;
+        if (u >= left && tree[i+1] > 0) {
+            u -= left;
+            i += 1;
+        }
+    }
+
+    return i - M;
+}
+
+size_t
+gsl_ran_discrete_dynamic(const gsl_rng *r, const gsl_ran_discrete_dynamic_t *g)
+{
+    if (g->tree[1] == 0) {
+      GSL_ERROR_VAL ("sum of probabilities is zero", GSL_EDOM, 0);
+    }
+
+    return discrete_dynamic_search(g, gsl_rng_uniform(r));
+}
+
+/* The uniforms for the whole array are obtained from the bulk
+   generator, giving the same results as n calls of
+   gsl_ran_discrete_dynamic */
+
+#define DYNAMIC_BLOCK 256
+
+void
+gsl_ran_discrete_dynamic_array(const gsl_rng *r,
+                               const gsl_ran_discrete_dynamic_t *g,
+                               size_t *x, size_t n)
+{
+    double u[DYNAMIC_BLOCK];
+    size_t i, done = 0;
+
+    if (g->tree[1] == 0) {
+      GSL_ERROR_VOID ("sum of probabilities is zero", GSL_EDOM);
+    }
+
+    while (done < n) {
+        const size_t nb = (n - done < DYNAMIC_BLOCK) ? n - done : DYNAMIC_BLOCK;
+
+        gsl_rng_uniform_array(r, u, nb);
+
+        for (i=0; i<nb; ++i) {
+            x[done+i] = discrete_dynamic_search(g, u[i]);
+        }
+
+        done += nb;
+    }
+}
+
+double
+gsl_ran_discrete_dynamic_pdf(size_t k, const gsl_ran_discrete_dynamic_t *g)
+{
+    if (k >= g->K || g->tree[1] == 0) return 0;
+
+    return g->tree[g->M + k] / g->tree[1];
+}
@@ -39,6 +39,20 @@ gsl_ran_flat (const gsl_rng * r, const double a, const double b)
   return a * (1 - u) + b * u;
 }
 
+/* The array version gives the same values as n calls of gsl_ran_flat */
+
+void
+gsl_ran_flat_array (const gsl_rng * r, const double a, const double b,
+                    double * x, const size_t n)
+{
+  size_t i;
+
+  gsl_rng_uniform_array (r, x, n);
+
+  for (i = 0; i < n; i++)
+    x[i] = a * (1 - x[i]) + b * x[i];
+}
+
 double
 gsl_ran_flat_pdf (double x, const double a, const double b)
 {
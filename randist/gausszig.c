@@ -163,12 +163,42 @@ static const double wtab[128] = {
 };
 
 
+/* Test a point x = j * wtab[i] which has failed the quick acceptance
+   test j < ktab[i], by sampling from the wedge of step i or from the
+   tail of the base strip. The point is replaced by the tail sample in
+   the latter case. Returns 1 if the point is accepted. */
+
+static int
+zig_accept (const gsl_rng * r, const unsigned long int i, double *x)
+{
+  double y;
+
+  if (i < 127)
+    {
+      double y0, y1, U1;
+      y0 = ytab[i];
+      y1 = ytab[i + 1];
+      U1 = gsl_rng_uniform (r);
+      y = y1 + (y0 - y1) * U1;
+    }
+  else
+    {
+      double U1, U2;
+      U1 = 1.0 - gsl_rng_uniform (r);
+      U2 = gsl_rng_uniform (r);
+      *x = PARAM_R - log (U1) / PARAM_R;
+      y = exp (-PARAM_R * (*x - 0.5 * PARAM_R)) * U2;
+    }
+
+  return (y < exp (-0.5 * (*x) * (*x)));
+}
+
 double
 gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma)
 {
   unsigned long int i, j;
   int sign;
-  double x, y;
+  double x;
 
   const unsigned long int range = r->type->max - r->type->min;
   const unsigned long int offset = r->type->min;
@@ -202,26 +232,72 @@ gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma)
       if (j < ktab[i])
         break;
 
-      if (i < 127)
-        {
-          double y0, y1, U1;
-          y0 = ytab[i];
-          y1 = ytab[i + 1];
-          U1 = gsl_rng_uniform (r);
-          y = y1 + (y0 - y1) * U1;
-        }
-      else
-        {
-          double U1, U2;
-          U1 = 1.0 - gsl_rng_uniform (r);
-          U2 = gsl_rng_uniform (r);
-          x = PARAM_R - log (U1) / PARAM_R;
-          y = exp (-PARAM_R * (x - 0.5 * PARAM_R)) * U2;
-        }
-
-      if (y < exp (-0.5 * x * x))
+      if (zig_accept (r, i, &x))
         break;
     }
 
   return sign * sigma * x;
 }
+
+/* Fill an array with gaussian variates. The step and position of each
+   point are taken from a block of integers obtained with
+   gsl_rng_get_array, so the quick acceptance test, which succeeds for
+   about 99% of points, needs no further calls to the generator and no
+   unpredictable branch for the sign. The remaining points go through
+   the usual wedge and tail tests, and are replaced by a call of
+   gsl_ran_gaussian_ziggurat if they are rejected there, so each
+   element has exactly the distribution of the scalar function. The
+   order in which numbers are consumed from the generator differs from
+   n successive scalar calls. */
+
+#define ZIG_BLOCK 256
+
+void
+gsl_ran_gaussian_array (const gsl_rng * r, const double sigma,
+                        double * x, const size_t n)
+{
+  const unsigned long int range = r->type->max - r->type->min;
+  const unsigned long int offset = r->type->min;
+  unsigned long int k[ZIG_BLOCK];
+  size_t m, done = 0;
+
+  if (range < 0xFFFFFFFF)
+    {
+      /* generators with fewer than 32 bits use the scalar method */
+
+      for (m = 0; m < n; m++)
+        x[m] = gsl_ran_gaussian_ziggurat (r, sigma);
+
+      return;
+    }
+
+  while (done < n)
+    {
+      const size_t nb = (n - done < ZIG_BLOCK) ? n - done : ZIG_BLOCK;
+      double *const xb = x + done;
+
+      gsl_rng_get_array (r, k, nb);
+
+      for (m = 0; m < nb; m++)
+        {
+          const unsigned long int km = k[m] - offset;
+          const unsigned long int i = km & 0x7F;
+          const unsigned long int j = (km >> 8) & 0xFFFFFF;
+          const int sign = (int) ((km >> 6) & 0x2) - 1;   /* bit 7 */
+          double xm = j * wtab[i];
+
+          if (j >= ktab[i])
+            {
+              if (!zig_accept (r, i, &xm))
+                {
+                  xb[m] = gsl_ran_gaussian_ziggurat (r, sigma);
+                  continue;
+                }
+            }
+
+          xb[m] = sign * sigma * xm;
+        }
+
+      done += nb;
+    }
+}
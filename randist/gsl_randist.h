@@ -19,6 +19,7 @@
 
 #ifndef __GSL_RANDIST_H__
 #define __GSL_RANDIST_H__
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
@@ -48,6 +49,7 @@ double gsl_ran_binomial_pdf (const unsigned int k, const double p, const unsigne
 
 double gsl_ran_exponential (const gsl_rng * r, const double mu);
 double gsl_ran_exponential_pdf (const double x, const double mu);
+void gsl_ran_exponential_array (const gsl_rng * r, const double mu, double * x, const size_t n);
 
 double gsl_ran_exppow (const gsl_rng * r, const double a, const double b);
 double gsl_ran_exppow_pdf (const double x, const double a, const double b);
@@ -70,6 +72,7 @@ double gsl_ran_fdist_pdf (const double x, const double nu1, const double nu2);
 
 double gsl_ran_flat (const gsl_rng * r, const double a, const double b);
 double gsl_ran_flat_pdf (double x, const double a, const double b);
+void gsl_ran_flat_array (const gsl_rng * r, const double a, const double b, double * x, const size_t n);
 
 double gsl_ran_gamma (const gsl_rng * r, const double a, const double b);
 double gsl_ran_gamma_int (const gsl_rng * r, const unsigned int a);
@@ -81,6 +84,7 @@ double gsl_ran_gaussian (const gsl_rng * r, const double sigma);
 double gsl_ran_gaussian_ratio_method (const gsl_rng * r, const double sigma);
 double gsl_ran_gaussian_ziggurat (const gsl_rng * r, const double sigma);
 double gsl_ran_gaussian_pdf (const double x, const double sigma);
+void gsl_ran_gaussian_array (const gsl_rng * r, const double sigma, double * x, const size_t n);
 
 double gsl_ran_ugaussian (const gsl_rng * r);
 double gsl_ran_ugaussian_ratio_method (const gsl_rng * r);
@@ -96,11 +100,17 @@ void gsl_ran_bivariate_gaussian (const gsl_rng * r, double sigma_x, double sigma
 double gsl_ran_bivariate_gaussian_pdf (const double x, const double y, const double sigma_x, const double sigma_y, const double rho);
 
 int gsl_ran_multivariate_gaussian (const gsl_rng * r, const gsl_vector * mu, const gsl_matrix * L, gsl_vector * result);
+int gsl_ran_multivariate_gaussian_array (const gsl_rng * r, const gsl_vector * mu, const gsl_matrix * L, gsl_matrix * X);
 int gsl_ran_multivariate_gaussian_log_pdf (const gsl_vector * x,
                                            const gsl_vector * mu,
                                            const gsl_matrix * L,
                                            double * result,
                                            gsl_vector * work);
+int gsl_ran_multivariate_gaussian_log_pdf_array (const gsl_matrix * X,
+                                                 const gsl_vector * mu,
+                                                 const gsl_matrix * L,
+                                                 gsl_vector * result,
+                                                 gsl_matrix * work);
 int gsl_ran_multivariate_gaussian_pdf (const gsl_vector * x,
                                        const gsl_vector * mu,
                                        const gsl_matrix * L,
@@ -195,6 +205,34 @@ void gsl_ran_discrete_free(gsl_ran_discrete_t *g);
 size_t gsl_ran_discrete (const gsl_rng *r, const gsl_ran_discrete_t *g);
 double gsl_ran_discrete_pdf (size_t k, const gsl_ran_discrete_t *g);
 
+typedef struct {                /* struct for dynamic weights */
+    size_t K;                   /* number of events */
+    size_t M;                   /* number of leaves, power of two >= K */
+    double *tree;               /* partial sums, leaves at M..M+K-1 */
+} gsl_ran_discrete_dynamic_t;
+
+gsl_ran_discrete_dynamic_t * gsl_ran_discrete_dynamic_alloc (size_t K, const double *P);
+void gsl_ran_discrete_dynamic_free (gsl_ran_discrete_dynamic_t *g);
+int gsl_ran_discrete_dynamic_set (gsl_ran_discrete_dynamic_t *g, size_t k, double w);
+double gsl_ran_discrete_dynamic_get (const gsl_ran_discrete_dynamic_t *g, size_t k);
+double gsl_ran_discrete_dynamic_total (const gsl_ran_discrete_dynamic_t *g);
+size_t gsl_ran_discrete_dynamic (const gsl_rng *r, const gsl_ran_discrete_dynamic_t *g);
+void gsl_ran_discrete_dynamic_array (const gsl_rng *r, const gsl_ran_discrete_dynamic_t *g, size_t *x, size_t n);
+double gsl_ran_discrete_dynamic_pdf (size_t k, const gsl_ran_discrete_dynamic_t *g);
+
+typedef struct {                /* struct for numerical inversion of a cdf */
+    size_t n;                   /* number of intervals */
+    double *u;                  /* normalized cdf at the n+1 knots */
+    double *c;                  /* cubic coefficients, 4 per interval */
+    size_t *guide;              /* guide table, first interval above j/n */
+} gsl_ran_invcdf_t;
+
+gsl_ran_invcdf_t * gsl_ran_invcdf_alloc (const gsl_function * cdf, const gsl_function * pdf, const double a, const double b, const double u_resolution);
+void gsl_ran_invcdf_free (gsl_ran_invcdf_t * g);
+double gsl_ran_invcdf (const gsl_rng * r, const gsl_ran_invcdf_t * g);
+void gsl_ran_invcdf_array (const gsl_rng * r, const gsl_ran_invcdf_t * g, double * x, const size_t n);
+double gsl_ran_invcdf_Pinv (const double P, const gsl_ran_invcdf_t * g);
+
 
 __END_DECLS
 
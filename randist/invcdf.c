@@ -0,0 +1,374 @@
+/* randist/invcdf.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Sampling from a continuous distribution by fast numerical inversion
+   of its cumulative distribution function.
+
+   The inverse cdf x = F^{-1}(u) is approximated on each interval
+   [u_i, u_{i+1}] = [F(x_i), F(x_{i+1})] by the cubic Hermite
+   polynomial matching x and dx/du = 1/f(x) at both ends. Starting
+   from an equidistant grid in x, intervals are split in half until
+   the polynomial is monotonic and the u-error |F(x(u)) - u| at the
+   check points t = 1/4, 1/2, 3/4 of each interval is below the
+   requested resolution. Intervals carrying less probability than the
+   resolution are accepted with linear interpolation.
+
+   A guide table indexed by u locates the interval of a uniform
+   variate in constant expected time, so a variate costs one uniform
+   number, a table lookup and the evaluation of a cubic.
+
+   See: W. Hormann and J. Leydold, "Continuous random variate
+   generation by fast numerical inversion", ACM Trans. Model. Comput.
+   Simul. 13, 347-362 (2003). */
+
+#include <config.h>
+#include <math.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#define INVCDF_INITIAL_INTERVALS 16
+#define INVCDF_MAX_INTERVALS 100000
+#define INVCDF_MAX_DEPTH 1100
+
+typedef struct
+{
+  double x, u, f;
+}
+knot_t;
+
+static double
+eval_cubic (const double *c, const double t)
+{
+  return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+/* coefficients of the Hermite polynomial on t in [0,1] for the knots
+   p and q, with slopes taken from the pdf when available and usable,
+   otherwise from the secant */
+
+static void
+hermite_coeffs (const knot_t * p, const knot_t * q, int linear, double *c)
+{
+  const double dx = q->x - p->x;
+  const double du = q->u - p->u;
+  double m0 = dx, m1 = dx;
+
+  if (!linear)
+    {
+      if (p->f > 0.0 && gsl_finite (du / p->f))
+        m0 = du / p->f;
+      if (q->f > 0.0 && gsl_finite (du / q->f))
+        m1 = du / q->f;
+    }
+
+  c[0] = p->x;
+  c[1] = m0;
+  c[2] = 3.0 * dx - 2.0 * m0 - m1;
+  c[3] = -2.0 * dx + m0 + m1;
+}
+
+/* sufficient condition for monotonicity of the cubic, from
+   F. N. Fritsch and R. E. Carlson, SIAM J. Numer. Anal. 17, 238 (1980) */
+
+static int
+is_monotone (const double *c, const double dx)
+{
+  const double a = c[1] / dx;
+  const double b = (c[1] + 2.0 * c[2] + 3.0 * c[3]) / dx;
+
+  return (a >= 0.0 && b >= 0.0 && a * a + b * b <= 9.0);
+}
+
+static int
+check_interval (const gsl_function * cdf, const knot_t * p, const knot_t * q,
+                const double *c, const double tol)
+{
+  static const double t[3] = { 0.25, 0.5, 0.75 };
+  const double du = q->u - p->u;
+  size_t k;
+
+  if (!is_monotone (c, q->x - p->x))
+    return 0;
+
+  for (k = 0; k < 3; k++)
+    {
+      double x = eval_cubic (c, t[k]);
+      double err = GSL_FN_EVAL (cdf, x) - (p->u + t[k] * du);
+
+      if (!(fabs (err) <= tol))
+        return 0;
+    }
+
+  return 1;
+}
+
+static void
+eval_knot (const gsl_function * cdf, const gsl_function * pdf, double x,
+           knot_t * k)
+{
+  k->x = x;
+  k->u = GSL_FN_EVAL (cdf, x);
+  k->f = (pdf != NULL) ? GSL_FN_EVAL (pdf, x) : 0.0;
+}
+
+gsl_ran_invcdf_t *
+gsl_ran_invcdf_alloc (const gsl_function * cdf, const gsl_function * pdf,
+                      const double a, const double b,
+                      const double u_resolution)
+{
+  gsl_ran_invcdf_t *g;
+  knot_t left, *stack;
+  size_t n_stack, n = 0, n_alloc = 4 * INVCDF_INITIAL_INTERVALS;
+  double *u, *c, umin, umax, tol;
+  size_t i, j;
+
+  if (!(a < b) || !gsl_finite (a) || !gsl_finite (b))
+    {
+      GSL_ERROR_NULL ("domain must be a finite interval a < b", GSL_EDOM);
+    }
+
+  if (!(u_resolution > 0.0))
+    {
+      GSL_ERROR_NULL ("u-resolution must be positive", GSL_EDOM);
+    }
+
+  umin = GSL_FN_EVAL (cdf, a);
+  umax = GSL_FN_EVAL (cdf, b);
+
+  if (!(umax > umin))
+    {
+      GSL_ERROR_NULL ("cdf must increase over the domain", GSL_EDOM);
+    }
+
+  tol = u_resolution * (umax - umin);
+
+  /* the stack holds the right end points of the intervals still to
+     be checked, with the nearest one on top. Each split adds one
+     point, and an interval can only be halved about 1100 times before
+     its width falls below the precision of x. */
+
+  stack = (knot_t *) malloc ((INVCDF_INITIAL_INTERVALS + INVCDF_MAX_DEPTH) * sizeof (knot_t));
+  u = (double *) malloc ((n_alloc + 1) * sizeof (double));
+  c = (double *) malloc (4 * n_alloc * sizeof (double));
+
+  if (stack == 0 || u == 0 || c == 0)
+    {
+      free (stack);
+      free (u);
+      free (c);
+      GSL_ERROR_NULL ("failed to allocate space for tables", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < INVCDF_INITIAL_INTERVALS; i++)
+    {
+      double x = b - (b - a) * i / (double) INVCDF_INITIAL_INTERVALS;
+      eval_knot (cdf, pdf, x, &stack[i]);
+    }
+
+  stack[0].u = umax;
+  n_stack = INVCDF_INITIAL_INTERVALS;
+
+  eval_knot (cdf, pdf, a, &left);
+  left.u = umin;
+  u[0] = 0.0;
+
+  while (n_stack > 0)
+    {
+      knot_t *right = &stack[n_stack - 1];
+      const double du = right->u - left.u;
+      double coeffs[4];
+      int accept;
+
+      if (du < 0.0)
+        {
+          free (stack);
+          free (u);
+          free (c);
+          GSL_ERROR_NULL ("cdf is not monotonic", GSL_EDOM);
+        }
+
+      if (du <= tol)
+        {
+          hermite_coeffs (&left, right, 1, coeffs);
+          accept = 1;
+        }
+      else
+        {
+          double xm = 0.5 * (left.x + right->x);
+
+          hermite_coeffs (&left, right, pdf == NULL, coeffs);
+          accept = check_interval (cdf, &left, right, coeffs, tol);
+
+          if (!accept && (xm <= left.x || xm >= right->x
+                          || n_stack == INVCDF_INITIAL_INTERVALS + INVCDF_MAX_DEPTH))
+            {
+              /* the interval cannot be split any further */
+              hermite_coeffs (&left, right, 1, coeffs);
+              accept = 1;
+            }
+          else if (!accept)
+            {
+              eval_knot (cdf, pdf, xm, &stack[n_stack]);
+              n_stack++;
+              continue;
+            }
+        }
+
+      /* intervals of zero probability are never sampled, drop them */
+
+      if (du > 0.0)
+        {
+          if (n == n_alloc)
+            {
+              double *u2, *c2;
+
+              if (2 * n_alloc > INVCDF_MAX_INTERVALS)
+                {
+                  free (stack);
+                  free (u);
+                  free (c);
+                  GSL_ERROR_NULL ("maximum number of intervals exceeded, "
+                                  "increase u-resolution", GSL_EMAXITER);
+                }
+
+              u2 = (double *) realloc (u, (2 * n_alloc + 1) * sizeof (double));
+              if (u2 != 0)
+                u = u2;
+
+              c2 = (double *) realloc (c, 8 * n_alloc * sizeof (double));
+              if (c2 != 0)
+                c = c2;
+
+              if (u2 == 0 || c2 == 0)
+                {
+                  free (stack);
+                  free (u);
+                  free (c);
+                  GSL_ERROR_NULL ("failed to allocate space for tables",
+                                  GSL_ENOMEM);
+                }
+
+              n_alloc *= 2;
+            }
+
+          for (j = 0; j < 4; j++)
+            c[4 * n + j] = coeffs[j];
+
+          n++;
+          u[n] = (right->u - umin) / (umax - umin);
+        }
+
+      left = *right;
+      n_stack--;
+    }
+
+  free (stack);
+
+  u[n] = 1.0;
+
+  g = (gsl_ran_invcdf_t *) malloc (sizeof (gsl_ran_invcdf_t));
+
+  if (g == 0)
+    {
+      free (u);
+      free (c);
+      GSL_ERROR_NULL ("failed to allocate space for struct", GSL_ENOMEM);
+    }
+
+  g->n = n;
+  g->u = u;
+  g->c = c;
+  g->guide = (size_t *) malloc (n * sizeof (size_t));
+
+  if (g->guide == 0)
+    {
+      gsl_ran_invcdf_free (g);
+      GSL_ERROR_NULL ("failed to allocate space for guide table", GSL_ENOMEM);
+    }
+
+  /* guide[j] is the first interval ending above j/n */
+
+  for (i = 0, j = 0; j < n; j++)
+    {
+      const double uj = j / (double) n;
+
+      while (i < n - 1 && u[i + 1] <= uj)
+        i++;
+
+      g->guide[j] = i;
+    }
+
+  return g;
+}
+
+void
+gsl_ran_invcdf_free (gsl_ran_invcdf_t * g)
+{
+  RETURN_IF_NULL (g);
+  free (g->u);
+  free (g->c);
+  free (g->guide);
+  free (g);
+}
+
+static inline double
+invcdf_eval (const gsl_ran_invcdf_t * g, const double P)
+{
+  const size_t n = g->n;
+  size_t j = (size_t) (P * n);
+  size_t i;
+
+  if (j >= n)
+    j = n - 1;
+
+  i = g->guide[j];
+
+  while (i < n - 1 && P >= g->u[i + 1])
+    i++;
+
+  return eval_cubic (g->c + 4 * i, (P - g->u[i]) / (g->u[i + 1] - g->u[i]));
+}
+
+double
+gsl_ran_invcdf (const gsl_rng * r, const gsl_ran_invcdf_t * g)
+{
+  return invcdf_eval (g, gsl_rng_uniform (r));
+}
+
+void
+gsl_ran_invcdf_array (const gsl_rng * r, const gsl_ran_invcdf_t * g,
+                      double * x, const size_t n)
+{
+  size_t i;
+
+  gsl_rng_uniform_array (r, x, n);
+
+  for (i = 0; i < n; i++)
+    x[i] = invcdf_eval (g, x[i]);
+}
+
+double
+gsl_ran_invcdf_Pinv (const double P, const gsl_ran_invcdf_t * g)
+{
+  if (!(P >= 0.0 && P <= 1.0))
+    return GSL_NAN;
+
+  return invcdf_eval (g, P);
+}
@@ -75,6 +75,67 @@ gsl_ran_multivariate_gaussian (const gsl_rng * r,
     }
 }
 
+/* Generate a set of random vectors from a multivariate Gaussian
+ * distribution. The rows of X are filled with independent standard
+ * normal variates Z, using the array sampler, and transformed all at
+ * once as X = Z L^T + mu with a single triangular matrix-matrix product
+ * (dtrmm), instead of one dtrmv per vector.
+ *
+ * mu      mean vector (dimension d)
+ * L       matrix resulting from the Cholesky decomposition of
+ *         variance-covariance matrix Sigma = L L^T (dimension d x d)
+ * X       output matrix, one sample per row (dimension n x d)
+ */
+int
+gsl_ran_multivariate_gaussian_array (const gsl_rng * r,
+                                     const gsl_vector * mu,
+                                     const gsl_matrix * L,
+                                     gsl_matrix * X)
+{
+  const size_t M = L->size1;
+  const size_t N = L->size2;
+
+  if (M != N)
+    {
+      GSL_ERROR("requires square matrix", GSL_ENOTSQR);
+    }
+  else if (mu->size != M)
+    {
+      GSL_ERROR("incompatible dimension of mean vector with variance-covariance matrix", GSL_EBADLEN);
+    }
+  else if (X->size2 != M)
+    {
+      GSL_ERROR("incompatible dimension of result matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = X->size1;
+      size_t i;
+
+      if (X->tda == M)
+        {
+          gsl_ran_gaussian_array(r, 1.0, X->data, n * M);
+        }
+      else
+        {
+          for (i = 0; i < n; ++i)
+            gsl_ran_gaussian_array(r, 1.0, X->data + i * X->tda, M);
+        }
+
+      /* compute: X = Z L^T */
+      gsl_blas_dtrmm(CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                     1.0, L, X);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_vector_view xi = gsl_matrix_row(X, i);
+          gsl_vector_add(&xi.vector, mu);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
 /* Compute the log of the probability density function at a given quantile
  * vector for a multivariate Gaussian distribution using the Cholesky
  * decomposition of the variance-covariance matrix.
@@ -146,6 +207,91 @@ gsl_ran_multivariate_gaussian_log_pdf (const gsl_vector * x,
     }
 }
 
+/* Compute the log of the probability density function at a set of
+ * quantile vectors, reusing the Cholesky factor for all of them. The
+ * triangular solves for all the points are done together with a single
+ * dtrsm.
+ *
+ * X       matrix of quantiles, one per row (dimension n x d)
+ * mu      mean vector (dimension d)
+ * L       matrix resulting from the Cholesky decomposition of
+ *         variance-covariance matrix Sigma = L L^T (dimension d x d)
+ * result  output of the log densities (dimension n)
+ * work    matrix used for intermediate computations (dimension n x d)
+ */
+int
+gsl_ran_multivariate_gaussian_log_pdf_array (const gsl_matrix * X,
+                                             const gsl_vector * mu,
+                                             const gsl_matrix * L,
+                                             gsl_vector * result,
+                                             gsl_matrix * work)
+{
+  const size_t M = L->size1;
+  const size_t N = L->size2;
+
+  if (M != N)
+    {
+      GSL_ERROR("requires square matrix", GSL_ENOTSQR);
+    }
+  else if (mu->size != M)
+    {
+      GSL_ERROR("incompatible dimension of mean vector with variance-covariance matrix", GSL_EBADLEN);
+    }
+  else if (X->size2 != M)
+    {
+      GSL_ERROR("incompatible dimension of quantile matrix", GSL_EBADLEN);
+    }
+  else if (result->size != X->size1)
+    {
+      GSL_ERROR("incompatible dimension of result vector", GSL_EBADLEN);
+    }
+  else if (work->size1 != X->size1 || work->size2 != M)
+    {
+      GSL_ERROR("incompatible dimension of work matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = X->size1;
+      size_t i;
+      double logSqrtDetSigma; /* log [ sqrt(|Sigma|) ] */
+      double c;
+
+      /* compute: work = X - mu, by rows */
+      gsl_matrix_memcpy(work, X);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_vector_view wi = gsl_matrix_row(work, i);
+          gsl_vector_sub(&wi.vector, mu);
+        }
+
+      /* compute: work = (X - mu) L^{-T}, so row i is L^{-1} (x_i - mu) */
+      gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                     1.0, L, work);
+
+      /* compute: log [ sqrt(|Sigma|) ] = sum_i log L_{ii} */
+      logSqrtDetSigma = 0.0;
+      for (i = 0; i < M; ++i)
+        {
+          double Lii = gsl_matrix_get(L, i, i);
+          logSqrtDetSigma += log(Lii);
+        }
+
+      c = - logSqrtDetSigma - 0.5*M*log(2.0*M_PI);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_vector_const_view wi = gsl_matrix_const_row(work, i);
+          double quadForm;    /* (x_i - mu)' Sigma^{-1} (x_i - mu) */
+
+          gsl_blas_ddot(&wi.vector, &wi.vector, &quadForm);
+          gsl_vector_set(result, i, -0.5*quadForm + c);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
 int
 gsl_ran_multivariate_gaussian_pdf (const gsl_vector * x,
                                    const gsl_vector * mu,
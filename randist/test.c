@@ -47,6 +47,7 @@ void testDiscretePDF (double (*f) (void), double (*pdf) (unsigned int),
 
 void test_shuffle (void);
 void test_choose (void);
+void test_array_samplers (void);
 double test_beta (void);
 double test_beta_pdf (double x);
 double test_bernoulli (void);
@@ -91,10 +92,17 @@ double test_discrete2 (void);
 double test_discrete2_pdf (unsigned int n);
 double test_discrete3 (void);
 double test_discrete3_pdf (unsigned int n);
+double test_discrete_dynamic (void);
+double test_discrete_dynamic_pdf (unsigned int n);
+double test_discrete_dynamic_array (void);
+double test_discrete_dynamic_array_pdf (unsigned int n);
+void test_discrete_dynamic_updates (void);
 double test_erlang (void);
 double test_erlang_pdf (double x);
 double test_exponential (void);
 double test_exponential_pdf (double x);
+double test_exponential_array (void);
+double test_exponential_array_pdf (double x);
 double test_exppow0 (void);
 double test_exppow0_pdf (double x);
 double test_exppow1 (void);
@@ -113,6 +121,8 @@ double test_fdist_large (void);
 double test_fdist_large_pdf (double x);
 double test_flat (void);
 double test_flat_pdf (double x);
+double test_flat_array (void);
+double test_flat_array_pdf (double x);
 double test_gamma (void);
 double test_gamma_pdf (double x);
 double test_gamma1 (void);
@@ -143,6 +153,8 @@ double test_gaussian_ratio_method (void);
 double test_gaussian_ratio_method_pdf (double x);
 double test_gaussian_ziggurat (void);
 double test_gaussian_ziggurat_pdf (double x);
+double test_gaussian_array (void);
+double test_gaussian_array_pdf (double x);
 double test_gaussian_tail (void);
 double test_gaussian_tail_pdf (double x);
 double test_gaussian_tail1 (void);
@@ -166,6 +178,8 @@ double test_bivariate_gaussian4_pdf (double x);
 void test_multivariate_gaussian_log_pdf (void);
 void test_multivariate_gaussian_pdf (void);
 void test_multivariate_gaussian (void);
+void test_multivariate_gaussian_log_pdf_array (void);
+void test_multivariate_gaussian_array (void);
 double test_gumbel1 (void);
 double test_gumbel1_pdf (double x);
 double test_gumbel2 (void);
@@ -186,6 +200,11 @@ double test_hypergeometric5 (void);
 double test_hypergeometric5_pdf (unsigned int x);
 double test_hypergeometric6 (void);
 double test_hypergeometric6_pdf (unsigned int x);
+double test_invcdf (void);
+double test_invcdf_pdf (double x);
+double test_invcdf_array (void);
+double test_invcdf_array_pdf (double x);
+void test_invcdf_accuracy (void);
 double test_landau (void);
 double test_landau_pdf (double x);
 double test_levy1 (void);
@@ -259,6 +278,8 @@ gsl_rng *r_global;
 static gsl_ran_discrete_t *g1 = NULL;
 static gsl_ran_discrete_t *g2 = NULL;
 static gsl_ran_discrete_t *g3 = NULL;
+static gsl_ran_discrete_dynamic_t *g4 = NULL;
+static gsl_ran_invcdf_t *g5 = NULL;
 
 int
 main (void)
@@ -273,6 +294,7 @@ main (void)
 
   test_shuffle ();
   test_choose ();
+  test_array_samplers ();
 
   testMoments (FUNC (ugaussian), 0.0, 100.0, 0.5);
   testMoments (FUNC (ugaussian), -1.0, 1.0, 0.6826895);
@@ -344,6 +366,8 @@ main (void)
   test_multivariate_gaussian_log_pdf ();
   test_multivariate_gaussian_pdf ();
   test_multivariate_gaussian ();
+  test_multivariate_gaussian_log_pdf_array ();
+  test_multivariate_gaussian_array ();
 
   testPDF (FUNC2 (gumbel1));
   testPDF (FUNC2 (gumbel2));
@@ -404,14 +428,88 @@ main (void)
   testDiscretePDF (FUNC2 (negative_binomial));
   testDiscretePDF (FUNC2 (pascal));
 
+  testPDF (FUNC2 (exponential_array));
+  testPDF (FUNC2 (flat_array));
+  testPDF (FUNC2 (gaussian_array));
+
+  testDiscretePDF (FUNC2 (discrete_dynamic));
+  testDiscretePDF (FUNC2 (discrete_dynamic_array));
+  test_discrete_dynamic_updates ();
+
+  testPDF (FUNC2 (invcdf));
+  testPDF (FUNC2 (invcdf_array));
+  test_invcdf_accuracy ();
+
   gsl_rng_free (r_global);
   gsl_ran_discrete_free (g1);
   gsl_ran_discrete_free (g2);
   gsl_ran_discrete_free (g3);
+  gsl_ran_discrete_dynamic_free (g4);
+  gsl_ran_invcdf_free (g5);
 
   exit (gsl_test_summary ());
 }
 
+/* The flat and exponential array samplers must reproduce the scalar
+   functions exactly. The gaussian sampler consumes numbers in a
+   different order, so check its tails against the exact probabilities
+   instead, including generators with fewer than 32 bits which use the
+   scalar method. */
+
+void
+test_array_samplers (void)
+{
+  const size_t n = 1001;
+  double *x = (double *) malloc (n * sizeof (double));
+  gsl_rng *r1 = gsl_rng_alloc (gsl_rng_mt19937);
+  gsl_rng *r2 = gsl_rng_alloc (gsl_rng_mt19937);
+  size_t i, k;
+  int status;
+
+  status = 0;
+  gsl_ran_flat_array (r1, -1.5, 2.5, x, n);
+  for (i = 0; i < n; i++)
+    status |= (x[i] != gsl_ran_flat (r2, -1.5, 2.5));
+  gsl_test (status, "gsl_ran_flat_array, agreement with gsl_ran_flat");
+
+  status = 0;
+  gsl_ran_exponential_array (r1, 0.7, x, n);
+  for (i = 0; i < n; i++)
+    status |= (x[i] != gsl_ran_exponential (r2, 0.7));
+  gsl_test (status, "gsl_ran_exponential_array, agreement with gsl_ran_exponential");
+
+  for (k = 0; k < 2; k++)
+    {
+      const gsl_rng_type *T = (k == 0) ? gsl_rng_taus2 : gsl_rng_ranlxs0;
+      gsl_rng *r = gsl_rng_alloc (T);
+      const size_t m = 100 * n;
+      double count = 0, p, expected, sigma;
+
+      for (i = 0; i < m; i += n)
+        {
+          size_t j;
+
+          gsl_ran_gaussian_array (r, 1.0, x, n);
+
+          for (j = 0; j < n; j++)
+            count += (fabs (x[j]) > 2.5);
+        }
+
+      p = 2 * gsl_cdf_ugaussian_Q (2.5);
+      expected = p * m;
+      sigma = fabs (count - expected) / sqrt (expected * (1 - p));
+      gsl_test (sigma > 5, "gsl_ran_gaussian_array, %s, tail probability "
+                "(%g observed vs %g expected)", gsl_rng_name (r),
+                count / m, p);
+
+      gsl_rng_free (r);
+    }
+
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+  free (x);
+}
+
 void
 test_shuffle (void)
 {
@@ -1209,6 +1307,133 @@ test_discrete3_pdf (unsigned int n)
   return gsl_ran_discrete_pdf ((size_t) n, g3);
 }
 
+/* dynamic distribution with 13 events, set up with some updates
+   including weights set to zero */
+
+static void
+setup_discrete_dynamic (void)
+{
+  if (g4 == NULL)
+    {
+      double P[13];
+      size_t i;
+
+      for (i = 0; i < 13; ++i)
+        P[i] = 1.0 + i;
+
+      g4 = gsl_ran_discrete_dynamic_alloc (13, P);
+
+      gsl_ran_discrete_dynamic_set (g4, 0, 0.0);
+      gsl_ran_discrete_dynamic_set (g4, 5, 20.0);
+      gsl_ran_discrete_dynamic_set (g4, 12, 0.0);
+      gsl_ran_discrete_dynamic_set (g4, 7, 0.5);
+      gsl_ran_discrete_dynamic_set (g4, 5, 11.0);
+    }
+}
+
+double
+test_discrete_dynamic (void)
+{
+  setup_discrete_dynamic ();
+  return gsl_ran_discrete_dynamic (r_global, g4);
+}
+
+double
+test_discrete_dynamic_pdf (unsigned int n)
+{
+  return gsl_ran_discrete_dynamic_pdf ((size_t) n, g4);
+}
+
+double
+test_discrete_dynamic_array (void)
+{
+  static size_t buf[999];
+  static size_t pos = 999;
+
+  setup_discrete_dynamic ();
+
+  if (pos == 999)
+    {
+      gsl_ran_discrete_dynamic_array (r_global, g4, buf, 999);
+      pos = 0;
+    }
+
+  return buf[pos++];
+}
+
+double
+test_discrete_dynamic_array_pdf (unsigned int n)
+{
+  return gsl_ran_discrete_dynamic_pdf ((size_t) n, g4);
+}
+
+void
+test_discrete_dynamic_updates (void)
+{
+  const size_t K = 1000, n = 1001;
+  gsl_ran_discrete_dynamic_t *g = gsl_ran_discrete_dynamic_alloc (K, NULL);
+  gsl_rng *r1 = gsl_rng_alloc (gsl_rng_mt19937);
+  gsl_rng *r2 = gsl_rng_alloc (gsl_rng_mt19937);
+  size_t *x = (size_t *) malloc (n * sizeof (size_t));
+  double sum = 0;
+  size_t i;
+  int status = 0;
+
+  /* many random updates, then set the weights to known values */
+
+  for (i = 0; i < 100000; i++)
+    {
+      size_t k = gsl_rng_uniform_int (r1, K);
+      gsl_ran_discrete_dynamic_set (g, k, gsl_rng_uniform (r1) * 1e6);
+    }
+
+  for (i = 0; i < K; i++)
+    {
+      gsl_ran_discrete_dynamic_set (g, i, (i % 3 == 0) ? 0.0 : 0.25);
+      sum += (i % 3 == 0) ? 0.0 : 0.25;
+    }
+
+  gsl_test (gsl_ran_discrete_dynamic_total (g) != sum,
+            "gsl_ran_discrete_dynamic, total after updates (%g observed vs %g expected)",
+            gsl_ran_discrete_dynamic_total (g), sum);
+
+  gsl_test (gsl_ran_discrete_dynamic_get (g, 4) != 0.25,
+            "gsl_ran_discrete_dynamic, get weight");
+
+  /* the array sampler matches the scalar one and never returns an
+     event with zero weight */
+
+  gsl_rng_memcpy (r2, r1);
+  gsl_ran_discrete_dynamic_array (r1, g, x, n);
+
+  for (i = 0; i < n; i++)
+    {
+      status |= (x[i] != gsl_ran_discrete_dynamic (r2, g));
+      status |= (x[i] % 3 == 0);
+    }
+
+  gsl_test (status, "gsl_ran_discrete_dynamic_array, agreement with scalar sampler");
+
+  /* invalid weights are rejected */
+
+  {
+    gsl_error_handler_t *h = gsl_set_error_handler_off ();
+
+    status = (gsl_ran_discrete_dynamic_set (g, 0, -1.0) != GSL_EINVAL);
+    status |= (gsl_ran_discrete_dynamic_set (g, K, 1.0) != GSL_EINVAL);
+    status |= (gsl_ran_discrete_dynamic_get (g, 0) != 0.0);
+
+    gsl_set_error_handler (h);
+  }
+
+  gsl_test (status, "gsl_ran_discrete_dynamic_set, invalid arguments");
+
+  free (x);
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+  gsl_ran_discrete_dynamic_free (g);
+}
+
 
 double
 test_erlang (void)
@@ -1234,6 +1459,32 @@ test_exponential_pdf (double x)
   return gsl_ran_exponential_pdf (x, 2.0);
 }
 
+/* The array samplers are tested one value at a time, drawing from a
+   buffer which is refilled with an odd block size */
+
+#define ARRAY_BUF 999
+
+double
+test_exponential_array (void)
+{
+  static double buf[ARRAY_BUF];
+  static size_t pos = ARRAY_BUF;
+
+  if (pos == ARRAY_BUF)
+    {
+      gsl_ran_exponential_array (r_global, 2.0, buf, ARRAY_BUF);
+      pos = 0;
+    }
+
+  return buf[pos++];
+}
+
+double
+test_exponential_array_pdf (double x)
+{
+  return gsl_ran_exponential_pdf (x, 2.0);
+}
+
 double
 test_exppow0 (void)
 {
@@ -1345,6 +1596,27 @@ test_flat_pdf (double x)
   return gsl_ran_flat_pdf (x, 3.0, 4.0);
 }
 
+double
+test_flat_array (void)
+{
+  static double buf[ARRAY_BUF];
+  static size_t pos = ARRAY_BUF;
+
+  if (pos == ARRAY_BUF)
+    {
+      gsl_ran_flat_array (r_global, 3.0, 4.0, buf, ARRAY_BUF);
+      pos = 0;
+    }
+
+  return buf[pos++];
+}
+
+double
+test_flat_array_pdf (double x)
+{
+  return gsl_ran_flat_pdf (x, 3.0, 4.0);
+}
+
 double
 test_gamma (void)
 {
@@ -1545,6 +1817,27 @@ test_gaussian_ziggurat_pdf (double x)
   return gsl_ran_gaussian_pdf (x, 3.12);
 }
 
+double
+test_gaussian_array (void)
+{
+  static double buf[ARRAY_BUF];
+  static size_t pos = ARRAY_BUF;
+
+  if (pos == ARRAY_BUF)
+    {
+      gsl_ran_gaussian_array (r_global, 3.12, buf, ARRAY_BUF);
+      pos = 0;
+    }
+
+  return buf[pos++];
+}
+
+double
+test_gaussian_array_pdf (double x)
+{
+  return gsl_ran_gaussian_pdf (x, 3.12);
+}
+
 double
 test_gaussian_tail (void)
 {
@@ -1852,6 +2145,139 @@ test_multivariate_gaussian (void)
   gsl_vector_free(tmp);
 }
 
+/* Compare the batched log density with the one point version, for
+ * random points and a random covariance matrix, with a padded work
+ * matrix to exercise the row stride.
+ */
+void
+test_multivariate_gaussian_log_pdf_array (void)
+{
+  const size_t d = MULTI_DIM, n = 50;
+  size_t i, j;
+  double max_err = 0;
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_vector * mu = gsl_vector_alloc(d);
+  gsl_matrix * A = gsl_matrix_alloc(d, d);
+  gsl_matrix * L = gsl_matrix_alloc(d, d);
+  gsl_matrix * X = gsl_matrix_alloc(n, d);
+  gsl_matrix * work_big = gsl_matrix_alloc(n, d + 3);
+  gsl_matrix_view work = gsl_matrix_submatrix(work_big, 0, 1, n, d);
+  gsl_vector * result = gsl_vector_alloc(n);
+  gsl_vector * work1 = gsl_vector_alloc(d);
+
+  for (i = 0; i < d; ++i)
+    {
+      gsl_vector_set(mu, i, gsl_ran_flat(r, -1.0, 1.0));
+      for (j = 0; j < d; ++j)
+        gsl_matrix_set(A, i, j, gsl_ran_flat(r, -1.0, 1.0));
+    }
+
+  /* L L^T = A A^T + d I */
+  gsl_matrix_set_identity(L);
+  gsl_blas_dsyrk(CblasLower, CblasNoTrans, 1.0, A, (double) d, L);
+  gsl_linalg_cholesky_decomp1(L);
+
+  for (i = 0; i < n; ++i)
+    for (j = 0; j < d; ++j)
+      gsl_matrix_set(X, i, j, gsl_ran_flat(r, -3.0, 3.0));
+
+  gsl_ran_multivariate_gaussian_log_pdf_array(X, mu, L, result, &work.matrix);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_vector_const_view xi = gsl_matrix_const_row(X, i);
+      double expected, err;
+
+      gsl_ran_multivariate_gaussian_log_pdf(&xi.vector, mu, L, &expected, work1);
+      err = fabs(gsl_vector_get(result, i) - expected) / fabs(expected);
+      if (err > max_err)
+        max_err = err;
+    }
+
+  gsl_test(max_err > 1.0e-12,
+           "gsl_ran_multivariate_gaussian_log_pdf_array, max relative error %g",
+           max_err);
+
+  gsl_rng_free(r);
+  gsl_vector_free(mu);
+  gsl_matrix_free(A);
+  gsl_matrix_free(L);
+  gsl_matrix_free(X);
+  gsl_matrix_free(work_big);
+  gsl_vector_free(result);
+  gsl_vector_free(work1);
+}
+
+/* Draw N random vectors at once, and check the sample mean with
+ * Hotelling's test as above and the sample covariance elementwise.
+ * A separate generator is used so that the result does not depend on
+ * the other tests.
+ */
+void
+test_multivariate_gaussian_array (void)
+{
+  size_t d = 2, i, j;
+  int status = 0;
+  double T2 = 0, threshold = 0, alpha = 0.05;
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_vector * mu = gsl_vector_calloc(d);
+  gsl_matrix * Sigma = gsl_matrix_calloc(d, d);
+  gsl_matrix * L = gsl_matrix_calloc(d, d);
+  gsl_matrix * samples = gsl_matrix_calloc(N, d);
+  gsl_vector * mu_hat = gsl_vector_calloc(d);
+  gsl_matrix * Sigma_hat = gsl_matrix_calloc(d, d);
+  gsl_vector * mu_hat_ctr = gsl_vector_calloc(d);
+  gsl_matrix * Sigma_hat_inv = gsl_matrix_calloc(d, d);
+  gsl_vector * tmp = gsl_vector_calloc(d);
+
+  gsl_vector_set(mu, 0, 1);
+  gsl_vector_set(mu, 1, 2);
+  gsl_matrix_set(Sigma, 0, 0, 4);
+  gsl_matrix_set(Sigma, 1, 1, 3);
+  gsl_matrix_set(Sigma, 0, 1, 2);
+  gsl_matrix_set(Sigma, 1, 0, 2);
+
+  gsl_matrix_memcpy(L, Sigma);
+  gsl_linalg_cholesky_decomp1(L);
+  gsl_ran_multivariate_gaussian_array(r, mu, L, samples);
+
+  gsl_ran_multivariate_gaussian_mean (samples, mu_hat);
+  gsl_ran_multivariate_gaussian_vcov (samples, Sigma_hat);
+
+  gsl_vector_memcpy(mu_hat_ctr, mu_hat);
+  gsl_vector_sub(mu_hat_ctr, mu);
+  gsl_matrix_memcpy(Sigma_hat_inv, Sigma_hat);
+  gsl_linalg_cholesky_decomp1(Sigma_hat_inv);
+  gsl_linalg_cholesky_invert(Sigma_hat_inv);
+  gsl_blas_dgemv(CblasNoTrans, 1, Sigma_hat_inv, mu_hat_ctr, 0, tmp);
+  gsl_blas_ddot(mu_hat_ctr, tmp, &T2);
+  T2 *= N;
+
+  threshold = (N-1) * d / (double)(N-d) * gsl_cdf_fdist_Pinv(1-alpha, d, N-d);
+  status = (T2 > threshold);
+  gsl_test(status,
+           "test gsl_ran_multivariate_gaussian_array: T2 %f < %f",
+           T2, threshold);
+
+  /* the standard error of each covariance estimate is below 0.03 */
+  status = 0;
+  for (i = 0; i < d; ++i)
+    for (j = 0; j < d; ++j)
+      status |= (fabs(gsl_matrix_get(Sigma_hat, i, j) - gsl_matrix_get(Sigma, i, j)) > 0.15);
+
+  gsl_test(status, "test gsl_ran_multivariate_gaussian_array: covariance");
+
+  gsl_rng_free(r);
+  gsl_vector_free(mu);
+  gsl_matrix_free(Sigma);
+  gsl_matrix_free(L);
+  gsl_matrix_free(samples);
+  gsl_vector_free(mu_hat);
+  gsl_matrix_free(Sigma_hat);
+  gsl_vector_free(mu_hat_ctr);
+  gsl_matrix_free(Sigma_hat_inv);
+  gsl_vector_free(tmp);
+}
 
 double
 test_geometric (void)
@@ -1951,6 +2377,198 @@ test_hypergeometric6_pdf (unsigned int n)
   return gsl_ran_hypergeometric_pdf (n, 2, 10, 3);
 }
 
+/* numerical inversion of the gamma distribution with a = 2.5, b = 1.7,
+   truncated to [0, 80] */
+
+static double
+invcdf_gamma_P (double x, void *params)
+{
+  (void) params;
+  return gsl_cdf_gamma_P (x, 2.5, 1.7);
+}
+
+static double
+invcdf_gamma_pdf (double x, void *params)
+{
+  (void) params;
+  return gsl_ran_gamma_pdf (x, 2.5, 1.7);
+}
+
+static void
+setup_invcdf (void)
+{
+  if (g5 == NULL)
+    {
+      gsl_function F, f;
+
+      F.function = &invcdf_gamma_P;
+      F.params = 0;
+      f.function = &invcdf_gamma_pdf;
+      f.params = 0;
+
+      g5 = gsl_ran_invcdf_alloc (&F, &f, 0.0, 80.0, 1e-12);
+    }
+}
+
+double
+test_invcdf (void)
+{
+  setup_invcdf ();
+  return gsl_ran_invcdf (r_global, g5);
+}
+
+double
+test_invcdf_pdf (double x)
+{
+  return gsl_ran_gamma_pdf (x, 2.5, 1.7);
+}
+
+double
+test_invcdf_array (void)
+{
+  static double buf[999];
+  static size_t pos = 999;
+
+  setup_invcdf ();
+
+  if (pos == 999)
+    {
+      gsl_ran_invcdf_array (r_global, g5, buf, 999);
+      pos = 0;
+    }
+
+  return buf[pos++];
+}
+
+double
+test_invcdf_array_pdf (double x)
+{
+  return gsl_ran_gamma_pdf (x, 2.5, 1.7);
+}
+
+static double
+invcdf_beta_P (double x, void *params)
+{
+  (void) params;
+  return gsl_cdf_beta_P (x, 2.0, 3.0);
+}
+
+static double
+invcdf_beta_pdf (double x, void *params)
+{
+  (void) params;
+  return gsl_ran_beta_pdf (x, 2.0, 3.0);
+}
+
+static double
+invcdf_gaussian_P (double x, void *params)
+{
+  double sigma = *(double *) params;
+  return gsl_cdf_gaussian_P (x, sigma);
+}
+
+/* check the u-error |F(x(u)) - u| on a fine grid of u, which may be
+   slightly larger than the resolution between the check points */
+
+static double
+invcdf_u_error (const gsl_ran_invcdf_t * g, const gsl_function * F,
+                double umin, double umax)
+{
+  double err = 0.0;
+  size_t i;
+
+  for (i = 0; i <= 10000; i++)
+    {
+      double u = i / 10000.0;
+      double x = gsl_ran_invcdf_Pinv (u, g);
+      double e = fabs ((GSL_FN_EVAL (F, x) - umin) / (umax - umin) - u);
+
+      if (e > err)
+        err = e;
+    }
+
+  return err;
+}
+
+void
+test_invcdf_accuracy (void)
+{
+  const size_t n = 1001;
+  double *x = (double *) malloc (n * sizeof (double));
+  gsl_rng *r1 = gsl_rng_alloc (gsl_rng_mt19937);
+  gsl_rng *r2 = gsl_rng_alloc (gsl_rng_mt19937);
+  gsl_ran_invcdf_t *g;
+  gsl_function F, f;
+  double sigma = 2.0, err;
+  size_t i;
+  int status = 0;
+
+  setup_invcdf ();
+
+  /* the array sampler matches the scalar one */
+
+  gsl_ran_invcdf_array (r1, g5, x, n);
+
+  for (i = 0; i < n; i++)
+    status |= (x[i] != gsl_ran_invcdf (r2, g5));
+
+  gsl_test (status, "gsl_ran_invcdf_array, agreement with gsl_ran_invcdf");
+
+  F.function = &invcdf_gamma_P;
+  F.params = 0;
+  err = invcdf_u_error (g5, &F, 0.0, gsl_cdf_gamma_P (80.0, 2.5, 1.7));
+  gsl_test (err > 1e-11, "gsl_ran_invcdf, gamma u-error %g", err);
+
+  gsl_test_rel (gsl_ran_invcdf_Pinv (0.3, g5), gsl_cdf_gamma_Pinv (0.3, 2.5, 1.7),
+                1e-9, "gsl_ran_invcdf_Pinv, gamma P=0.3");
+
+  /* beta distribution, where the pdf vanishes at both ends */
+
+  F.function = &invcdf_beta_P;
+  f.function = &invcdf_beta_pdf;
+  f.params = 0;
+  g = gsl_ran_invcdf_alloc (&F, &f, 0.0, 1.0, 1e-10);
+  err = invcdf_u_error (g, &F, 0.0, 1.0);
+  gsl_test (err > 1e-9, "gsl_ran_invcdf, beta u-error %g", err);
+  gsl_test_abs (gsl_ran_invcdf_Pinv (0.0, g), 0.0, 1e-15, "gsl_ran_invcdf_Pinv, beta P=0");
+  gsl_test_abs (gsl_ran_invcdf_Pinv (1.0, g), 1.0, 1e-15, "gsl_ran_invcdf_Pinv, beta P=1");
+  gsl_ran_invcdf_free (g);
+
+  /* truncated gaussian without a pdf, using linear interpolation */
+
+  F.function = &invcdf_gaussian_P;
+  F.params = &sigma;
+  g = gsl_ran_invcdf_alloc (&F, NULL, -1.0, 3.0, 1e-6);
+  err = invcdf_u_error (g, &F, gsl_cdf_gaussian_P (-1.0, sigma),
+                        gsl_cdf_gaussian_P (3.0, sigma));
+  gsl_test (err > 1e-5, "gsl_ran_invcdf, truncated gaussian u-error %g", err);
+
+  for (i = 0; i < n; i++)
+    {
+      double y = gsl_ran_invcdf (r1, g);
+      status |= (y < -1.0 || y > 3.0);
+    }
+
+  gsl_test (status, "gsl_ran_invcdf, truncated gaussian range");
+  gsl_ran_invcdf_free (g);
+
+  {
+    gsl_error_handler_t *h = gsl_set_error_handler_off ();
+
+    status = (gsl_ran_invcdf_alloc (&F, NULL, 1.0, 1.0, 1e-6) != NULL);
+    status |= (gsl_ran_invcdf_alloc (&F, NULL, -1.0, 1.0, 0.0) != NULL);
+    status |= !gsl_isnan (gsl_ran_invcdf_Pinv (1.5, g5));
+
+    gsl_set_error_handler (h);
+  }
+
+  gsl_test (status, "gsl_ran_invcdf_alloc, invalid arguments");
+
+  free (x);
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
 
 
 
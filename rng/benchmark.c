@@ -26,6 +26,7 @@
 void benchmark (const gsl_rng_type * T);
 
 #define N  1000000
+#define NBLOCK 1000
 int isum;
 double dsum;
 
@@ -99,8 +100,10 @@ void
 benchmark (const gsl_rng_type * T)
 {
   int start, end;
-  int i = 0, d = 0 ;
-  double t1, t2;
+  int i = 0, d = 0, ia = 0, da = 0;
+  double t1, t2, t3, t4;
+  unsigned long int kbuf[NBLOCK];
+  double ubuf[NBLOCK];
 
   gsl_rng *r = gsl_rng_alloc (T);
 
@@ -132,9 +135,46 @@ benchmark (const gsl_rng_type * T)
 
   t2 = (end - start) / (double) CLOCKS_PER_SEC;
 
+  start = clock ();
+  do
+    {
+      int j, k;
+      for (j = 0; j < N; j += NBLOCK)
+        {
+          gsl_rng_get_array (r, kbuf, NBLOCK);
+          for (k = 0; k < NBLOCK; k++)
+            isum += kbuf[k];
+        }
+
+      ia += N;
+      end = clock ();
+    }
+  while (end < start + CLOCKS_PER_SEC/10);
+
+  t3 = (end - start) / (double) CLOCKS_PER_SEC;
+
+  start = clock ();
+  do
+    {
+      int j, k;
+      for (j = 0; j < N; j += NBLOCK)
+        {
+          gsl_rng_uniform_array (r, ubuf, NBLOCK);
+          for (k = 0; k < NBLOCK; k++)
+            dsum += ubuf[k];
+        }
+
+      da += N;
+      end = clock ();
+    }
+  while (end < start + CLOCKS_PER_SEC/10);
+
+  t4 = (end - start) / (double) CLOCKS_PER_SEC;
 
-  printf ("%6.0f k ints/sec, %6.0f k doubles/sec, %s\n",
-          i / t1 / 1000.0, d / t2 / 1000.0, gsl_rng_name (r));
+  printf ("%6.0f k ints/sec, %6.0f k doubles/sec, "
+          "%6.0f k ints/sec (array), %6.0f k doubles/sec (array), %s\n",
+          i / t1 / 1000.0, d / t2 / 1000.0,
+          ia / t3 / 1000.0, da / t4 / 1000.0, gsl_rng_name (r));
 
   gsl_rng_free (r);
 }
@@ -86,7 +86,11 @@ static const gsl_rng_type ran_type = {
   sizeof (ran_state_t),
   &ran_set,
   &ran_get,
-  &ran_get_double
+  &ran_get_double,
+  0,                            /* get_array */
+  0,                            /* get_double_array */
+  0,                            /* skip */
+  0                             /* skip_streams */
 };
 
 const gsl_rng_type *gsl_rng_borosh13 = &ran_type;
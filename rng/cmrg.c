@@ -74,6 +74,8 @@
 static inline unsigned long int cmrg_get (void *vstate);
 static double cmrg_get_double (void *vstate);
 static void cmrg_set (void *state, unsigned long int s);
+static void cmrg_skip (void *vstate, unsigned long int n);
+static void cmrg_skip_streams (void *vstate, unsigned long int k);
 
 static const long int m1 = 2147483647, m2 = 2145483479;
 
@@ -149,6 +151,70 @@ cmrg_get_double (void *vstate)
 }
 
 
+/* Skipping ahead uses the companion matrices of the two component
+   recurrences, with the negative coefficients a3 and b3 reduced
+   modulo m1 and m2, raised to the required power. */
+
+#include "matmod.c"
+
+static const unsigned long int cmrg_A1[9] = {
+  0, 63308, 2147483647 - 183326,
+  1, 0, 0,
+  0, 1, 0
+};
+
+static const unsigned long int cmrg_A2[9] = {
+  86098, 0, 2145483479 - 539608,
+  1, 0, 0,
+  0, 1, 0
+};
+
+static const unsigned long int cmrg_sqrtm1 = 46341;  /* ceil(sqrt(m1)) */
+static const unsigned long int cmrg_sqrtm2 = 46320;  /* ceil(sqrt(m2)) */
+
+static void
+cmrg_apply (cmrg_state_t * state, const unsigned long int *B1,
+            const unsigned long int *B2)
+{
+  unsigned long int v[3];
+
+  v[0] = state->x1;
+  v[1] = state->x2;
+  v[2] = state->x3;
+  matmod_vec (B1, v, 3, m1, cmrg_sqrtm1);
+  state->x1 = v[0];
+  state->x2 = v[1];
+  state->x3 = v[2];
+
+  v[0] = state->y1;
+  v[1] = state->y2;
+  v[2] = state->y3;
+  matmod_vec (B2, v, 3, m2, cmrg_sqrtm2);
+  state->y1 = v[0];
+  state->y2 = v[1];
+  state->y3 = v[2];
+}
+
+static void
+cmrg_skip (void *vstate, unsigned long int n)
+{
+  unsigned long int B1[9], B2[9];
+
+  matmod_pow (cmrg_A1, n, B1, 3, m1, cmrg_sqrtm1);
+  matmod_pow (cmrg_A2, n, B2, 3, m2, cmrg_sqrtm2);
+  cmrg_apply ((cmrg_state_t *) vstate, B1, B2);
+}
+
+static void
+cmrg_skip_streams (void *vstate, unsigned long int k)
+{
+  unsigned long int B1[9], B2[9];
+
+  matmod_pow_streams (cmrg_A1, k, B1, 3, m1, cmrg_sqrtm1);
+  matmod_pow_streams (cmrg_A2, k, B2, 3, m2, cmrg_sqrtm2);
+  cmrg_apply ((cmrg_state_t *) vstate, B1, B2);
+}
+
 static void
 cmrg_set (void *vstate, unsigned long int s)
 {
@@ -192,6 +258,10 @@ static const gsl_rng_type cmrg_type =
  sizeof (cmrg_state_t),
  &cmrg_set,
  &cmrg_get,
- &cmrg_get_double};
+ &cmrg_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ &cmrg_skip,
+ &cmrg_skip_streams};
 
 const gsl_rng_type *gsl_rng_cmrg = &cmrg_type;
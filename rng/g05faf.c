@@ -156,7 +156,11 @@ static const gsl_rng_type g05faf_type =
  sizeof (g05faf_state_t),
  &g05faf_set,
  &g05faf_get,
- &g05faf_get_double
+ &g05faf_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0                              /* skip_streams */
 };
 
 const gsl_rng_type *gsl_rng_g05faf = &g05faf_type;
@@ -155,7 +155,11 @@ static const gsl_rng_type gfsr4_type =
  sizeof (gfsr4_state_t),
  &gfsr4_set,
  &gfsr4_get,
- &gfsr4_get_double};
+ &gfsr4_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_gfsr4 = &gfsr4_type;
 
@@ -45,6 +45,10 @@ typedef struct
     void (*set) (void *state, unsigned long int seed);
     unsigned long int (*get) (void *state);
     double (*get_double) (void *state);
+    void (*get_array) (void *state, unsigned long int * x, size_t n);
+    void (*get_double_array) (void *state, double * x, size_t n);
+    void (*skip) (void *state, unsigned long int n);
+    void (*skip_streams) (void *state, unsigned long int k);
   }
 gsl_rng_type;
 
@@ -75,6 +79,7 @@ GSL_VAR const gsl_rng_type *gsl_rng_mrg;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937_1999;
 GSL_VAR const gsl_rng_type *gsl_rng_mt19937_1998;
+GSL_VAR const gsl_rng_type *gsl_rng_philox4x32;
 GSL_VAR const gsl_rng_type *gsl_rng_r250;
 GSL_VAR const gsl_rng_type *gsl_rng_ran0;
 GSL_VAR const gsl_rng_type *gsl_rng_ran1;
@@ -114,6 +119,7 @@ GSL_VAR const gsl_rng_type *gsl_rng_slatec;
 GSL_VAR const gsl_rng_type *gsl_rng_taus;
 GSL_VAR const gsl_rng_type *gsl_rng_taus2;
 GSL_VAR const gsl_rng_type *gsl_rng_taus113;
+GSL_VAR const gsl_rng_type *gsl_rng_threefry4x64;
 GSL_VAR const gsl_rng_type *gsl_rng_transputer;
 GSL_VAR const gsl_rng_type *gsl_rng_tt800;
 GSL_VAR const gsl_rng_type *gsl_rng_uni;
@@ -148,6 +154,13 @@ void gsl_rng_print_state (const gsl_rng * r);
 
 const gsl_rng_type * gsl_rng_env_setup (void);
 
+void gsl_rng_get_array (const gsl_rng * r, unsigned long int * x, size_t n);
+void gsl_rng_uniform_array (const gsl_rng * r, double * x, size_t n);
+void gsl_rng_uniform_pos_array (const gsl_rng * r, double * x, size_t n);
+
+int gsl_rng_skip (const gsl_rng * r, unsigned long int n);
+int gsl_rng_set_stream (const gsl_rng * r, unsigned long int seed, unsigned long int stream);
+
 INLINE_DECL unsigned long int gsl_rng_get (const gsl_rng * r);
 INLINE_DECL double gsl_rng_uniform (const gsl_rng * r);
 INLINE_DECL double gsl_rng_uniform_pos (const gsl_rng * r);
@@ -0,0 +1,127 @@
+/* rng/matmod.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Matrix arithmetic modulo m for skipping ahead in multiple recursive
+   generators. A generator of order d with state vector v satisfies
+   v_{n+1} = A v_n mod m, so v_{n+k} = A^k v_n mod m, and A^k can be
+   computed with O(log k) matrix products. Matrices are d x d, stored
+   in row-major order, with entries in [0, m) and m < 2^31. */
+
+#include "schrage.c"
+
+#define MATMOD_MAX 5
+
+/* C = A B mod m */
+static void
+matmod_mul (const unsigned long int *A, const unsigned long int *B,
+            unsigned long int *C, const size_t d,
+            const unsigned long int m, const unsigned long int sqrtm)
+{
+  unsigned long int T[MATMOD_MAX * MATMOD_MAX];
+  size_t i, j, k;
+
+  for (i = 0; i < d; i++)
+    {
+      for (j = 0; j < d; j++)
+        {
+          unsigned long int t = 0;
+
+          for (k = 0; k < d; k++)
+            {
+              t += schrage_mult (A[i * d + k], B[k * d + j], m, sqrtm);
+              if (t >= m)
+                t -= m;
+            }
+
+          T[i * d + j] = t;
+        }
+    }
+
+  for (i = 0; i < d * d; i++)
+    C[i] = T[i];
+}
+
+/* B = A^n mod m */
+static void
+matmod_pow (const unsigned long int *A, unsigned long int n,
+            unsigned long int *B, const size_t d,
+            const unsigned long int m, const unsigned long int sqrtm)
+{
+  unsigned long int P[MATMOD_MAX * MATMOD_MAX];
+  size_t i;
+
+  for (i = 0; i < d * d; i++)
+    {
+      P[i] = A[i];
+      B[i] = (i % (d + 1) == 0) ? 1 : 0;
+    }
+
+  while (n > 0)
+    {
+      if (n & 1)
+        matmod_mul (B, P, B, d, m, sqrtm);
+
+      n >>= 1;
+
+      if (n > 0)
+        matmod_mul (P, P, P, d, m, sqrtm);
+    }
+}
+
+/* B = A^(2^64 k) mod m */
+static void
+matmod_pow_streams (const unsigned long int *A, unsigned long int k,
+                    unsigned long int *B, const size_t d,
+                    const unsigned long int m, const unsigned long int sqrtm)
+{
+  unsigned long int P[MATMOD_MAX * MATMOD_MAX];
+  size_t i;
+
+  for (i = 0; i < d * d; i++)
+    P[i] = A[i];
+
+  for (i = 0; i < 64; i++)
+    matmod_mul (P, P, P, d, m, sqrtm);
+
+  matmod_pow (P, k, B, d, m, sqrtm);
+}
+
+/* v = A v mod m */
+static void
+matmod_vec (const unsigned long int *A, unsigned long int *v, const size_t d,
+            const unsigned long int m, const unsigned long int sqrtm)
+{
+  unsigned long int w[MATMOD_MAX];
+  size_t i, k;
+
+  for (i = 0; i < d; i++)
+    {
+      unsigned long int t = 0;
+
+      for (k = 0; k < d; k++)
+        {
+          t += schrage_mult (A[i * d + k], v[k], m, sqrtm);
+          if (t >= m)
+            t -= m;
+        }
+
+      w[i] = t;
+    }
+
+  for (i = 0; i < d; i++)
+    v[i] = w[i];
+}
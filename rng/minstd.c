@@ -104,6 +104,10 @@ static const gsl_rng_type minstd_type =
  sizeof (minstd_state_t),
  &minstd_set,
  &minstd_get,
- &minstd_get_double};
+ &minstd_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_minstd = &minstd_type;
@@ -53,6 +53,8 @@
 static inline unsigned long int mrg_get (void *vstate);
 static double mrg_get_double (void *vstate);
 static void mrg_set (void *state, unsigned long int s);
+static void mrg_skip (void *vstate, unsigned long int n);
+static void mrg_skip_streams (void *vstate, unsigned long int k);
 
 static const long int m = 2147483647;
 static const long int a1 = 107374182, q1 = 20, r1 = 7;
@@ -101,6 +103,62 @@ mrg_get_double (void *vstate)
 }
 
 
+/* Skipping ahead uses the companion matrix of the recurrence,
+
+   (x1, x2, x3, x4, x5)_{n+1} = A (x1, x2, x3, x4, x5)_n mod m
+
+   raised to the required power. */
+
+#include "matmod.c"
+
+static const unsigned long int mrg_A[25] = {
+  107374182, 0, 0, 0, 104480,
+  1, 0, 0, 0, 0,
+  0, 1, 0, 0, 0,
+  0, 0, 1, 0, 0,
+  0, 0, 0, 1, 0
+};
+
+static const unsigned long int mrg_sqrtm = 46341;  /* ceil(sqrt(m)) */
+
+static void
+mrg_apply (mrg_state_t * state, const unsigned long int *B)
+{
+  unsigned long int v[5];
+
+  v[0] = state->x1;
+  v[1] = state->x2;
+  v[2] = state->x3;
+  v[3] = state->x4;
+  v[4] = state->x5;
+
+  matmod_vec (B, v, 5, m, mrg_sqrtm);
+
+  state->x1 = v[0];
+  state->x2 = v[1];
+  state->x3 = v[2];
+  state->x4 = v[3];
+  state->x5 = v[4];
+}
+
+static void
+mrg_skip (void *vstate, unsigned long int n)
+{
+  unsigned long int B[25];
+
+  matmod_pow (mrg_A, n, B, 5, m, mrg_sqrtm);
+  mrg_apply ((mrg_state_t *) vstate, B);
+}
+
+static void
+mrg_skip_streams (void *vstate, unsigned long int k)
+{
+  unsigned long int B[25];
+
+  matmod_pow_streams (mrg_A, k, B, 5, m, mrg_sqrtm);
+  mrg_apply ((mrg_state_t *) vstate, B);
+}
+
 static void
 mrg_set (void *vstate, unsigned long int s)
 {
@@ -144,6 +202,10 @@ static const gsl_rng_type mrg_type =
  sizeof (mrg_state_t),
  &mrg_set,
  &mrg_get,
- &mrg_get_double};
+ &mrg_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ &mrg_skip,
+ &mrg_skip_streams};
 
 const gsl_rng_type *gsl_rng_mrg = &mrg_type;
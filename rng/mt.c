@@ -53,11 +53,16 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_rng.h>
 
 static inline unsigned long int mt_get (void *vstate);
 static double mt_get_double (void *vstate);
 static void mt_set (void *state, unsigned long int s);
+static void mt_get_array (void *vstate, unsigned long int * x, size_t n);
+static void mt_get_double_array (void *vstate, double * x, size_t n);
+static void mt_skip (void *vstate, unsigned long int n);
+static void mt_skip_streams (void *vstate, unsigned long int k);
 
 #define N 624   /* Period parameters */
 #define M 397
@@ -75,50 +80,128 @@ typedef struct
   }
 mt_state_t;
 
+#define MAGIC(y) (((y)&0x1) ? 0x9908b0dfUL : 0)
+
+/* generate N words at one time */
+
+static inline void
+mt_refill (mt_state_t * state)
+{
+  unsigned long int *const mt = state->mt;
+  int kk;
+
+  for (kk = 0; kk < N - M; kk++)
+    {
+      unsigned long y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
+      mt[kk] = mt[kk + M] ^ (y >> 1) ^ MAGIC(y);
+    }
+  for (; kk < N - 1; kk++)
+    {
+      unsigned long y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
+      mt[kk] = mt[kk + (M - N)] ^ (y >> 1) ^ MAGIC(y);
+    }
+
+  {
+    unsigned long y = (mt[N - 1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
+    mt[N - 1] = mt[M - 1] ^ (y >> 1) ^ MAGIC(y);
+  }
+
+  state->mti = 0;
+}
+
+#define TEMPER(k) do { \
+  (k) ^= ((k) >> 11); \
+  (k) ^= ((k) << 7) & 0x9d2c5680UL; \
+  (k) ^= ((k) << 15) & 0xefc60000UL; \
+  (k) ^= ((k) >> 18); } while (0)
+
 static inline unsigned long
 mt_get (void *vstate)
 {
   mt_state_t *state = (mt_state_t *) vstate;
 
   unsigned long k ;
-  unsigned long int *const mt = state->mt;
-
-#define MAGIC(y) (((y)&0x1) ? 0x9908b0dfUL : 0)
 
   if (state->mti >= N)
-    {   /* generate N words at one time */
-      int kk;
+    mt_refill (state);
 
-      for (kk = 0; kk < N - M; kk++)
-        {
-          unsigned long y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
-          mt[kk] = mt[kk + M] ^ (y >> 1) ^ MAGIC(y);
-        }
-      for (; kk < N - 1; kk++)
+  /* Tempering */
+  
+  k = state->mt[state->mti];
+  TEMPER(k);
+
+  state->mti++;
+
+  return k;
+}
+
+/* The bulk functions temper whole runs of the state vector at once,
+   avoiding the per-number call and the refill test. The tempering
+   loops have no dependencies between iterations and can be
+   vectorized by the compiler. */
+
+static void
+mt_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  mt_state_t *state = (mt_state_t *) vstate;
+
+  while (n > 0)
+    {
+      const unsigned long int *mt;
+      size_t i, m;
+
+      if (state->mti >= N)
+        mt_refill (state);
+
+      mt = state->mt + state->mti;
+      m = N - state->mti;
+
+      if (m > n)
+        m = n;
+
+      for (i = 0; i < m; i++)
         {
-          unsigned long y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
-          mt[kk] = mt[kk + (M - N)] ^ (y >> 1) ^ MAGIC(y);
+          unsigned long k = mt[i];
+          TEMPER(k);
+          x[i] = k;
         }
 
-      {
-        unsigned long y = (mt[N - 1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
-        mt[N - 1] = mt[M - 1] ^ (y >> 1) ^ MAGIC(y);
-      }
-
-      state->mti = 0;
+      state->mti += m;
+      x += m;
+      n -= m;
     }
+}
 
-  /* Tempering */
-  
-  k = mt[state->mti];
-  k ^= (k >> 11);
-  k ^= (k << 7) & 0x9d2c5680UL;
-  k ^= (k << 15) & 0xefc60000UL;
-  k ^= (k >> 18);
+static void
+mt_get_double_array (void *vstate, double * x, size_t n)
+{
+  mt_state_t *state = (mt_state_t *) vstate;
 
-  state->mti++;
+  while (n > 0)
+    {
+      const unsigned long int *mt;
+      size_t i, m;
 
-  return k;
+      if (state->mti >= N)
+        mt_refill (state);
+
+      mt = state->mt + state->mti;
+      m = N - state->mti;
+
+      if (m > n)
+        m = n;
+
+      for (i = 0; i < m; i++)
+        {
+          unsigned long k = mt[i];
+          TEMPER(k);
+          x[i] = k / 4294967296.0;
+        }
+
+      state->mti += m;
+      x += m;
+      n -= m;
+    }
 }
 
 static double
@@ -127,6 +210,440 @@ mt_get_double (void * vstate)
   return mt_get (vstate) / 4294967296.0 ;
 }
 
+/* Skipping ahead
+
+   The recurrence is linear over GF(2), so advancing the state by e
+   steps is the same as evaluating g(T) s, where T is the one-step
+   transition, s is the state and g(x) = x^e mod P(x) for the
+   characteristic polynomial P(x) of T, of degree 19937.
+
+   P(x) is found by the Berlekamp-Massey algorithm from 2 x 19937 bits
+   of output, g(x) is computed by repeated squaring and g(T) s is
+   evaluated by Horner's rule, giving a cost which is essentially
+   independent of e.  The polynomial arithmetic is carried out modulo
+   x^31 P(x), which has degree 32 N, so that reductions can be done a
+   whole word at a time, with a final reduction modulo P(x) at the
+   end.
+
+   The state is handled as a window of N consecutive words of the
+   sequence, held in a circular buffer, so that one step of T costs a
+   single application of the recurrence.
+
+   See: H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and
+   P. L'Ecuyer, "Efficient jump ahead for F2-linear random number
+   generators", INFORMS Journal on Computing, Vol. 20, No. 3 (2008),
+   Pages 385-390 */
+
+#define MT_DEGREE 19937               /* degree of P(x) */
+#define MT_PWORDS (N + 1)             /* words for degree 32 N */
+#define MT_SEQWORDS ((2 * MT_DEGREE) / 32 + MT_PWORDS + 2)
+
+/* below this distance it is faster to run the generator forward */
+
+#define MT_SKIP_JUMP (1UL << 25)
+
+typedef struct
+  {
+    unsigned long int P[MT_PWORDS];     /* characteristic polynomial */
+    unsigned long int Q[N];             /* x^31 P(x) - x^(32 N) */
+    unsigned long int R[8][16][N];      /* t x^(32 N + 4 b) mod x^31 P(x) */
+    unsigned long int spread[256];      /* bits of a byte spread out */
+    unsigned long int g[N];             /* jump polynomial */
+    unsigned long int sq[2 * N];        /* square of jump polynomial */
+    unsigned long int seq[MT_SEQWORDS]; /* reversed output bits */
+    unsigned long int C[MT_PWORDS], B[MT_PWORDS], T[MT_PWORDS];
+    unsigned long int w[N], s[N];       /* windows for Horner's rule */
+  }
+mt_jump_t;
+
+/* dst = dst + x^shift src, truncated to ndst words */
+
+static void
+mt_poly_add_shift (unsigned long int *dst, const size_t ndst,
+                   const unsigned long int *src, const size_t nsrc,
+                   const size_t shift)
+{
+  const size_t ws = shift / 32;
+  const unsigned int bs = shift % 32;
+  size_t i;
+
+  for (i = 0; i < nsrc && i + ws < ndst; i++)
+    {
+      dst[i + ws] ^= (src[i] << bs) & 0xffffffffUL;
+
+      if (bs > 0 && i + ws + 1 < ndst)
+        dst[i + ws + 1] ^= src[i] >> (32 - bs);
+    }
+}
+
+/* find the characteristic polynomial with the Berlekamp-Massey
+   algorithm, applied to the least significant bits of the output */
+
+static int
+mt_charpoly (mt_jump_t * j)
+{
+  const size_t len = 2 * MT_DEGREE;
+  unsigned long int *const C = j->C, *const B = j->B, *const T = j->T;
+  unsigned long int *const seq = j->seq;
+  size_t n, i, L = 0, m = 1;
+  mt_state_t state;
+
+  for (i = 0; i < MT_SEQWORDS; i++)
+    seq[i] = 0;
+
+  mt_set (&state, 4357);
+
+  for (n = 0; n < len; n++)
+    {
+      if (state.mti >= N)
+        mt_refill (&state);
+
+      if (state.mt[state.mti++] & 0x1)
+        {
+          const size_t k = len - 1 - n;
+          seq[k / 32] |= 1UL << (k % 32);
+        }
+    }
+
+  for (i = 0; i < MT_PWORDS; i++)
+    {
+      C[i] = 0;
+      B[i] = 0;
+    }
+
+  C[0] = 1;
+  B[0] = 1;
+
+  for (n = 0; n < len; n++)
+    {
+      /* discrepancy d = sum_{i=0}^{L} C_i s_{n-i}, where s_{n-i} is
+         bit (len - 1 - n + i) of the reversed sequence */
+
+      const size_t o = len - 1 - n;
+      const unsigned int r = o % 32;
+      unsigned long int d = 0;
+
+      for (i = 0; i <= L / 32; i++)
+        {
+          const size_t q = o / 32 + i;
+          unsigned long int x = seq[q] >> r;
+
+          if (r > 0)
+            x |= (seq[q + 1] << (32 - r)) & 0xffffffffUL;
+
+          d ^= C[i] & x;
+        }
+
+      d ^= d >> 16;
+      d ^= d >> 8;
+      d ^= d >> 4;
+      d ^= d >> 2;
+      d ^= d >> 1;
+
+      if ((d & 0x1) == 0)
+        {
+          m++;
+        }
+      else if (2 * L <= n)
+        {
+          for (i = 0; i < MT_PWORDS; i++)
+            T[i] = C[i];
+
+          mt_poly_add_shift (C, MT_PWORDS, B, MT_PWORDS, m);
+          L = n + 1 - L;
+
+          for (i = 0; i < MT_PWORDS; i++)
+            B[i] = T[i];
+
+          m = 1;
+        }
+      else
+        {
+          mt_poly_add_shift (C, MT_PWORDS, B, MT_PWORDS, m);
+          m++;
+        }
+    }
+
+  if (L != MT_DEGREE)
+    return GSL_ESANITY;
+
+  /* P(x) = x^L C(1/x) */
+
+  for (i = 0; i < MT_PWORDS; i++)
+    j->P[i] = 0;
+
+  for (i = 0; i <= L; i++)
+    {
+      if ((C[i / 32] >> (i % 32)) & 0x1)
+        j->P[(L - i) / 32] |= 1UL << ((L - i) % 32);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* a = x a mod x^31 P(x) */
+
+static void
+mt_poly_mulx (const mt_jump_t * j, unsigned long int *a)
+{
+  const unsigned long int top = a[N - 1] >> 31;
+  size_t i;
+
+  for (i = N - 1; i > 0; i--)
+    a[i] = ((a[i] << 1) | (a[i - 1] >> 31)) & 0xffffffffUL;
+
+  a[0] = (a[0] << 1) & 0xffffffffUL;
+
+  if (top)
+    {
+      for (i = 0; i < N; i++)
+        a[i] ^= j->Q[i];
+    }
+}
+
+/* g = g^2 mod x^31 P(x) */
+
+static void
+mt_poly_square (mt_jump_t * j)
+{
+  unsigned long int *const sq = j->sq;
+  size_t i, w;
+
+  for (i = 0; i < N; i++)
+    {
+      const unsigned long int u = j->g[i];
+      sq[2 * i] = j->spread[u & 0xff] | (j->spread[(u >> 8) & 0xff] << 16);
+      sq[2 * i + 1] = j->spread[(u >> 16) & 0xff] | (j->spread[(u >> 24) & 0xff] << 16);
+    }
+
+  /* reduce from the top, one word at a time */
+
+  for (w = 2 * N - 1; w >= N; w--)
+    {
+      const unsigned long int t = sq[w];
+      unsigned int b;
+
+      if (t == 0)
+        continue;
+
+      for (b = 0; b < 8; b++)
+        {
+          const unsigned long int *const Rb = j->R[b][(t >> (4 * b)) & 0xf];
+          unsigned long int *const dst = sq + (w - N);
+
+          for (i = 0; i < N; i++)
+            dst[i] ^= Rb[i];
+        }
+    }
+
+  for (i = 0; i < N; i++)
+    j->g[i] = sq[i];
+}
+
+/* g = x^(e 2^nsquare) mod P(x) */
+
+static void
+mt_jump_poly (mt_jump_t * j, const unsigned long int e, const size_t nsquare)
+{
+  size_t i, b;
+  int started = 0;
+
+  for (i = 0; i < 256; i++)
+    {
+      unsigned long int s = 0;
+
+      for (b = 0; b < 8; b++)
+        s |= ((i >> b) & 0x1) << (2 * b);
+
+      j->spread[i] = s;
+    }
+
+  for (i = 0; i < N; i++)
+    j->Q[i] = 0;
+
+  mt_poly_add_shift (j->Q, N, j->P, MT_PWORDS, 31);
+
+  /* tables of t x^(32 N + 4 b) mod x^31 P(x) for 4-bit t */
+
+  for (i = 0; i < N; i++)
+    j->R[0][1][i] = j->Q[i];
+
+  for (b = 0; b < 8; b++)
+    {
+      unsigned int t;
+
+      if (b > 0)
+        {
+          for (i = 0; i < N; i++)
+            j->R[b][1][i] = j->R[b - 1][8][i];
+
+          mt_poly_mulx (j, j->R[b][1]);
+        }
+
+      for (t = 2; t < 16; t <<= 1)
+        {
+          for (i = 0; i < N; i++)
+            j->R[b][t][i] = j->R[b][t >> 1][i];
+
+          mt_poly_mulx (j, j->R[b][t]);
+        }
+
+      for (t = 0; t < 16; t++)
+        {
+          if (t != 0 && (t & (t - 1)) == 0)
+            continue;
+
+          for (i = 0; i < N; i++)
+            j->R[b][t][i] = (t == 0) ? 0 : j->R[b][t & (t - 1)][i] ^ j->R[b][t & (~t + 1)][i];
+        }
+    }
+
+  for (i = 0; i < N; i++)
+    j->g[i] = 0;
+
+  j->g[0] = 1;
+
+  for (b = sizeof (unsigned long int) * 8; b-- > 0;)
+    {
+      if (started)
+        mt_poly_square (j);
+
+      if ((e >> b) & 0x1)
+        {
+          mt_poly_mulx (j, j->g);
+          started = 1;
+        }
+    }
+
+  for (i = 0; i < nsquare; i++)
+    mt_poly_square (j);
+
+  /* final reduction modulo P(x) */
+
+  for (b = 32 * N; b-- > MT_DEGREE;)
+    {
+      if ((j->g[b / 32] >> (b % 32)) & 0x1)
+        mt_poly_add_shift (j->g, N, j->P, MT_PWORDS, b - MT_DEGREE);
+    }
+}
+
+/* advance a window of N words held in a circular buffer by one step */
+
+static inline void
+mt_window_step (unsigned long int *w, size_t * start)
+{
+  const size_t k = *start;
+  const unsigned long y = (w[k] & UPPER_MASK) | (w[(k + 1) % N] & LOWER_MASK);
+
+  w[k] = w[(k + M) % N] ^ (y >> 1) ^ MAGIC(y);
+  *start = (k + 1) % N;
+}
+
+static void
+mt_jump (mt_state_t * state, const unsigned long int e, const size_t nsquare)
+{
+  mt_jump_t *j = (mt_jump_t *) malloc (sizeof (mt_jump_t));
+  size_t i, k, start = 0;
+  int status;
+
+  if (j == 0)
+    {
+      GSL_ERROR_VOID ("failed to allocate space for jump polynomial",
+                      GSL_ENOMEM);
+    }
+
+  status = mt_charpoly (j);
+
+  if (status)
+    {
+      free (j);
+      GSL_ERROR_VOID ("failed to find characteristic polynomial", status);
+    }
+
+  mt_jump_poly (j, e, nsquare);
+
+  /* current window s = (x_k, ..., x_{k+N-1}) */
+
+  if (state->mti >= N)
+    mt_refill (state);
+
+  for (i = 0; i < N; i++)
+    j->w[i] = state->mt[i];
+
+  for (i = 0; i < (size_t) state->mti; i++)
+    mt_window_step (j->w, &start);
+
+  for (i = 0; i < N; i++)
+    j->s[i] = j->w[(start + i) % N];
+
+  for (i = 0; i < N; i++)
+    j->w[i] = 0;
+
+  /* w = g(T) s by Horner's rule */
+
+  start = 0;
+
+  for (k = MT_DEGREE; k-- > 0;)
+    {
+      mt_window_step (j->w, &start);
+
+      if ((j->g[k / 32] >> (k % 32)) & 0x1)
+        {
+          const size_t n1 = N - start;
+
+          for (i = 0; i < n1; i++)
+            j->w[start + i] ^= j->s[i];
+
+          for (; i < N; i++)
+            j->w[i - n1] ^= j->s[i];
+        }
+    }
+
+  for (i = 0; i < N; i++)
+    state->mt[i] = j->w[(start + i) % N];
+
+  state->mti = 0;
+
+  free (j);
+}
+
+static void
+mt_skip (void *vstate, unsigned long int n)
+{
+  mt_state_t *state = (mt_state_t *) vstate;
+
+  if (n >= MT_SKIP_JUMP)
+    {
+      mt_jump (state, n, 0);
+      return;
+    }
+
+  while (n > 0)
+    {
+      unsigned long int m;
+
+      if (state->mti >= N)
+        mt_refill (state);
+
+      m = N - state->mti;
+
+      if (m > n)
+        m = n;
+
+      state->mti += m;
+      n -= m;
+    }
+}
+
+static void
+mt_skip_streams (void *vstate, unsigned long int k)
+{
+  mt_state_t *state = (mt_state_t *) vstate;
+
+  if (k > 0)
+    mt_jump (state, k, 64);
+}
+
 static void
 mt_set (void *vstate, unsigned long int s)
 {
@@ -211,7 +728,11 @@ static const gsl_rng_type mt_type =
  sizeof (mt_state_t),
  &mt_set,
  &mt_get,
- &mt_get_double};
+ &mt_get_double,
+ &mt_get_array,
+ &mt_get_double_array,
+ &mt_skip,
+ &mt_skip_streams};
 
 static const gsl_rng_type mt_1999_type =
 {"mt19937_1999",                /* name */
@@ -220,7 +741,11 @@ static const gsl_rng_type mt_1999_type =
  sizeof (mt_state_t),
  &mt_1999_set,
  &mt_get,
- &mt_get_double};
+ &mt_get_double,
+ &mt_get_array,
+ &mt_get_double_array,
+ &mt_skip,
+ &mt_skip_streams};
 
 static const gsl_rng_type mt_1998_type =
 {"mt19937_1998",                /* name */
@@ -229,7 +754,11 @@ static const gsl_rng_type mt_1998_type =
  sizeof (mt_state_t),
  &mt_1998_set,
  &mt_get,
- &mt_get_double};
+ &mt_get_double,
+ &mt_get_array,
+ &mt_get_double_array,
+ &mt_skip,
+ &mt_skip_streams};
 
 const gsl_rng_type *gsl_rng_mt19937 = &mt_type;
 const gsl_rng_type *gsl_rng_mt19937_1999 = &mt_1999_type;
@@ -0,0 +1,266 @@
+/* rng/philox.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <gsl/gsl_rng.h>
+
+/* This is the Philox4x32-10 counter-based generator. Each block of
+   four 32-bit outputs is obtained by applying a keyed bijection to a
+   128-bit counter,
+
+   (x_{4c}, x_{4c+1}, x_{4c+2}, x_{4c+3}) = philox_k (c)
+
+   where the bijection consists of 10 rounds of
+
+   (c0, c1, c2, c3) -> (hi(M1 c2) ^ c1 ^ k0, lo(M1 c2),
+                        hi(M0 c0) ^ c3 ^ k1, lo(M0 c0))
+
+   with multipliers M0 = 0xD2511F53, M1 = 0xCD9E8D57 and the key
+   (k0, k1) incremented by the Weyl constants (0x9E3779B9, 0xBB67AE85)
+   between rounds.
+
+   The 64-bit key is taken from the seed and the counter is
+   incremented by one for each block, so the state of the generator
+   can be moved to any position in O(1) time. Stream k of a seed
+   starts 2^64 k numbers into the sequence of that seed.
+
+   The period of this generator is 2^130.
+
+   From: J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+   "Parallel random numbers: as easy as 1, 2, 3", Proceedings of the
+   International Conference for High Performance Computing,
+   Networking, Storage and Analysis (SC11), 2011. */
+
+static inline unsigned long int philox_get (void *vstate);
+static double philox_get_double (void *vstate);
+static void philox_set (void *state, unsigned long int s);
+static void philox_get_array (void *vstate, unsigned long int * x, size_t n);
+static void philox_get_double_array (void *vstate, double * x, size_t n);
+static void philox_skip (void *vstate, unsigned long int n);
+static void philox_skip_streams (void *vstate, unsigned long int k);
+
+#define MASK 0xffffffffUL
+
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+
+#define PHILOX_ROUNDS 10
+
+typedef struct
+  {
+    unsigned long int ctr[4];   /* 128-bit counter of current block */
+    unsigned long int key[2];   /* 64-bit key */
+    unsigned long int out[4];   /* current block of output */
+    unsigned int pos;           /* position of next output in block */
+  }
+philox_state_t;
+
+/* compute the 64-bit product a*b of two 32-bit numbers */
+
+static inline void
+mulhilo32 (unsigned long int a, unsigned long int b,
+           unsigned long int *hi, unsigned long int *lo)
+{
+#if ULONG_MAX > 0xffffffffUL
+  unsigned long int p = a * b;
+  *hi = p >> 32;
+  *lo = p & MASK;
+#else
+  unsigned long int al = a & 0xffffUL, ah = a >> 16;
+  unsigned long int bl = b & 0xffffUL, bh = b >> 16;
+  unsigned long int ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+  unsigned long int mid = (ll >> 16) + (lh & 0xffffUL) + (hl & 0xffffUL);
+
+  *lo = ((mid & 0xffffUL) << 16) | (ll & 0xffffUL);
+  *hi = (hh + (lh >> 16) + (hl >> 16) + (mid >> 16)) & MASK;
+#endif
+}
+
+static void
+philox_block (philox_state_t * state)
+{
+  unsigned long int c0 = state->ctr[0], c1 = state->ctr[1];
+  unsigned long int c2 = state->ctr[2], c3 = state->ctr[3];
+  unsigned long int k0 = state->key[0], k1 = state->key[1];
+  int r;
+
+  for (r = 0; r < PHILOX_ROUNDS; r++)
+    {
+      unsigned long int hi0, lo0, hi1, lo1;
+
+      mulhilo32 (PHILOX_M0, c0, &hi0, &lo0);
+      mulhilo32 (PHILOX_M1, c2, &hi1, &lo1);
+
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+
+      k0 = (k0 + PHILOX_W0) & MASK;
+      k1 = (k1 + PHILOX_W1) & MASK;
+    }
+
+  state->out[0] = c0;
+  state->out[1] = c1;
+  state->out[2] = c2;
+  state->out[3] = c3;
+}
+
+/* add the 32-bit value v to word i of the counter, with carry */
+
+static inline void
+philox_ctr_add (philox_state_t * state, int i, unsigned long int v)
+{
+  for (; i < 4 && v != 0; i++)
+    {
+      unsigned long int c = (state->ctr[i] + v) & MASK;
+      v = (c < v) ? 1 : 0;
+      state->ctr[i] = c;
+    }
+}
+
+static inline unsigned long int
+philox_get (void *vstate)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+
+  if (state->pos >= 4)
+    {
+      philox_ctr_add (state, 0, 1);
+      philox_block (state);
+      state->pos = 0;
+    }
+
+  return state->out[state->pos++];
+}
+
+static double
+philox_get_double (void *vstate)
+{
+  return philox_get (vstate) / 4294967296.0;
+}
+
+static void
+philox_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      if (state->pos >= 4)
+        {
+          philox_ctr_add (state, 0, 1);
+          philox_block (state);
+          state->pos = 0;
+        }
+
+      x[i] = state->out[state->pos++];
+    }
+}
+
+static void
+philox_get_double_array (void *vstate, double * x, size_t n)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      if (state->pos >= 4)
+        {
+          philox_ctr_add (state, 0, 1);
+          philox_block (state);
+          state->pos = 0;
+        }
+
+      x[i] = state->out[state->pos++] / 4294967296.0;
+    }
+}
+
+static void
+philox_skip (void *vstate, unsigned long int n)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+
+  /* n = 4 q + r, move forward q blocks and r positions */
+  unsigned long int q = n / 4;
+  unsigned int p = state->pos + (unsigned int) (n % 4);
+
+  if (p >= 4)
+    {
+      q++;
+      p -= 4;
+    }
+
+  if (q > 0)
+    {
+      philox_ctr_add (state, 0, q & MASK);
+      philox_ctr_add (state, 1, (q >> 16) >> 16);
+      philox_block (state);
+    }
+
+  state->pos = p;
+}
+
+static void
+philox_skip_streams (void *vstate, unsigned long int k)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+
+  /* 2^64 k numbers are 2^62 k blocks */
+  philox_ctr_add (state, 1, (k << 30) & MASK);
+  philox_ctr_add (state, 2, (k >> 2) & MASK);
+  philox_ctr_add (state, 3, ((k >> 16) >> 18) & MASK);
+  philox_block (state);
+}
+
+static void
+philox_set (void *vstate, unsigned long int s)
+{
+  philox_state_t *state = (philox_state_t *) vstate;
+
+  state->key[0] = s & MASK;
+  state->key[1] = (s >> 16) >> 16;
+
+  state->ctr[0] = 0;
+  state->ctr[1] = 0;
+  state->ctr[2] = 0;
+  state->ctr[3] = 0;
+
+  philox_block (state);
+  state->pos = 0;
+}
+
+static const gsl_rng_type philox_type =
+{"philox4x32",                  /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (philox_state_t),
+ &philox_set,
+ &philox_get,
+ &philox_get_double,
+ &philox_get_array,
+ &philox_get_double_array,
+ &philox_skip,
+ &philox_skip_streams};
+
+const gsl_rng_type *gsl_rng_philox4x32 = &philox_type;
@@ -125,6 +125,10 @@ static const gsl_rng_type ran1_type =
  sizeof (ran1_state_t),
  &ran1_set,
  &ran1_get,
- &ran1_get_double};
+ &ran1_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_ran1 = &ran1_type;
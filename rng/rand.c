@@ -80,6 +80,10 @@ static const gsl_rng_type rand_type =
  sizeof (rand_state_t),
  &rand_set,
  &rand_get,
- &rand_get_double};
+ &rand_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_rand = &rand_type;
@@ -90,6 +90,10 @@ static const gsl_rng_type randu_type =
  sizeof (randu_state_t),
  &randu_set,
  &randu_get,
- &randu_get_double};
+ &randu_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_randu = &randu_type;
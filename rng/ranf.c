@@ -156,7 +156,11 @@ static const gsl_rng_type ranf_type =
  sizeof (ranf_state_t),
  &ranf_set,
  &ranf_get,
- &ranf_get_double
+ &ranf_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0                              /* skip_streams */
 };
 
 const gsl_rng_type *gsl_rng_ranf = &ranf_type;
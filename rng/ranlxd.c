@@ -34,6 +34,8 @@ static double ranlxd_get_double (void *vstate);
 static void ranlxd_set_lux (void *state, unsigned long int s, unsigned int luxury);
 static void ranlxd1_set (void *state, unsigned long int s);
 static void ranlxd2_set (void *state, unsigned long int s);
+static void ranlxd_get_array (void *vstate, unsigned long int * x, size_t n);
+static void ranlxd_get_double_array (void *vstate, double * x, size_t n);
 
 static const int next[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0};
 
@@ -167,6 +169,57 @@ ranlxd_get_double (void *vstate)
   return state->xdbl[state->ir];
 }
 
+/* The bulk functions keep the position in the state block in local
+   variables and only call increment_state at block boundaries. */
+
+static void
+ranlxd_get_double_array (void *vstate, double * x, size_t n)
+{
+  ranlxd_state_t *state = (ranlxd_state_t *) vstate;
+  unsigned int ir = state->ir;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      ir = next[ir];
+
+      if (ir == state->ir_old)
+        {
+          state->ir = ir;
+          increment_state (state);
+          ir = state->ir;
+        }
+
+      x[i] = state->xdbl[ir];
+    }
+
+  state->ir = ir;
+}
+
+static void
+ranlxd_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  ranlxd_state_t *state = (ranlxd_state_t *) vstate;
+  unsigned int ir = state->ir;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      ir = next[ir];
+
+      if (ir == state->ir_old)
+        {
+          state->ir = ir;
+          increment_state (state);
+          ir = state->ir;
+        }
+
+      x[i] = state->xdbl[ir] * 4294967296.0;     /* 2^32 */
+    }
+
+  state->ir = ir;
+}
+
 static void
 ranlxd_set_lux (void *vstate, unsigned long int s, unsigned int luxury)
 {
@@ -234,7 +287,11 @@ static const gsl_rng_type ranlxd1_type =
  sizeof (ranlxd_state_t),
  &ranlxd1_set,
  &ranlxd_get,
- &ranlxd_get_double};
+ &ranlxd_get_double,
+ &ranlxd_get_array,
+ &ranlxd_get_double_array,
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 static const gsl_rng_type ranlxd2_type =
 {"ranlxd2",                     /* name */
@@ -243,7 +300,11 @@ static const gsl_rng_type ranlxd2_type =
  sizeof (ranlxd_state_t),
  &ranlxd2_set,
  &ranlxd_get,
- &ranlxd_get_double};
+ &ranlxd_get_double,
+ &ranlxd_get_array,
+ &ranlxd_get_double_array,
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_ranlxd1 = &ranlxd1_type;
 const gsl_rng_type *gsl_rng_ranlxd2 = &ranlxd2_type;
@@ -277,7 +277,11 @@ static const gsl_rng_type ranlxs0_type =
  sizeof (ranlxs_state_t),
  &ranlxs0_set,
  &ranlxs_get,
- &ranlxs_get_double};
+ &ranlxs_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 static const gsl_rng_type ranlxs1_type =
 {"ranlxs1",                     /* name */
@@ -286,7 +290,11 @@ static const gsl_rng_type ranlxs1_type =
  sizeof (ranlxs_state_t),
  &ranlxs1_set,
  &ranlxs_get,
- &ranlxs_get_double};
+ &ranlxs_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 static const gsl_rng_type ranlxs2_type =
 {"ranlxs2",                     /* name */
@@ -295,7 +303,11 @@ static const gsl_rng_type ranlxs2_type =
  sizeof (ranlxs_state_t),
  &ranlxs2_set,
  &ranlxs_get,
- &ranlxs_get_double};
+ &ranlxs_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_ranlxs0 = &ranlxs0_type;
 const gsl_rng_type *gsl_rng_ranlxs1 = &ranlxs1_type;
@@ -168,6 +168,10 @@ static const gsl_rng_type ranmar_type =
  sizeof (ranmar_state_t),
  &ranmar_set,
  &ranmar_get,
- &ranmar_get_double};
+ &ranmar_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_ranmar = &ranmar_type;
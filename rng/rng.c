@@ -130,6 +130,120 @@ gsl_rng_state (const gsl_rng * r)
   return r->state;
 }
 
+/* Bulk generation. Generators may supply get_array and
+   get_double_array functions which fill an array in a single call,
+   otherwise the scalar functions are used. In both cases the
+   sequence is identical to repeated calls of gsl_rng_get or
+   gsl_rng_uniform. */
+
+void
+gsl_rng_get_array (const gsl_rng * r, unsigned long int * x, size_t n)
+{
+  if (r->type->get_array)
+    {
+      (r->type->get_array) (r->state, x, n);
+    }
+  else
+    {
+      unsigned long int (*get) (void *) = r->type->get;
+      void *state = r->state;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        x[i] = get (state);
+    }
+}
+
+void
+gsl_rng_uniform_array (const gsl_rng * r, double * x, size_t n)
+{
+  if (r->type->get_double_array)
+    {
+      (r->type->get_double_array) (r->state, x, n);
+    }
+  else
+    {
+      double (*get_double) (void *) = r->type->get_double;
+      void *state = r->state;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        x[i] = get_double (state);
+    }
+}
+
+void
+gsl_rng_uniform_pos_array (const gsl_rng * r, double * x, size_t n)
+{
+  size_t k = 0;
+
+  /* Fill the array and discard any zeros, refilling the tail until
+     the array is full. This consumes the same values in the same
+     order as repeated calls to gsl_rng_uniform_pos. */
+
+  while (k < n)
+    {
+      size_t i, j = k;
+
+      gsl_rng_uniform_array (r, x + k, n - k);
+
+      for (i = k; i < n; i++)
+        {
+          if (x[i] != 0)
+            x[j++] = x[i];
+        }
+
+      k = j;
+    }
+}
+
+/* Skip ahead. Generators may supply a skip function which moves the
+   state forward by n steps in less than O(n) time, otherwise the
+   numbers are generated and discarded. */
+
+int
+gsl_rng_skip (const gsl_rng * r, unsigned long int n)
+{
+  if (r->type->skip)
+    {
+      (r->type->skip) (r->state, n);
+    }
+  else
+    {
+      unsigned long int (*get) (void *) = r->type->get;
+      void *state = r->state;
+      unsigned long int i;
+
+      for (i = 0; i < n; i++)
+        get (state);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Independent streams. Stream k of a seed is the sequence of that
+   seed started 2^64 k steps ahead, so different streams do not
+   overlap unless more than 2^64 numbers are drawn from one of them.
+   Only generators with a skip_streams function support this. */
+
+int
+gsl_rng_set_stream (const gsl_rng * r, unsigned long int seed,
+                    unsigned long int stream)
+{
+  if (r->type->skip_streams == 0)
+    {
+      GSL_ERROR ("generator does not support independent streams",
+                 GSL_EUNSUP);
+    }
+
+  (r->type->set) (r->state, seed);
+
+  if (stream > 0)
+    (r->type->skip_streams) (r->state, stream);
+
+  return GSL_SUCCESS;
+}
+
 void
 gsl_rng_print_state (const gsl_rng * r)
 {
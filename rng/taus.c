@@ -83,6 +83,8 @@
 static inline unsigned long int taus_get (void *vstate);
 static double taus_get_double (void *vstate);
 static void taus_set (void *state, unsigned long int s);
+static void taus_get_array (void *vstate, unsigned long int * x, size_t n);
+static void taus_get_double_array (void *vstate, double * x, size_t n);
 
 typedef struct
   {
@@ -111,6 +113,50 @@ taus_get_double (void *vstate)
   return taus_get (vstate) / 4294967296.0 ;
 }
 
+/* The bulk functions keep the three components in local variables
+   for the whole array instead of loading and storing the state for
+   each number. */
+
+static void
+taus_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  taus_state_t *state = (taus_state_t *) vstate;
+  unsigned long int s1 = state->s1, s2 = state->s2, s3 = state->s3;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      s1 = TAUSWORTHE (s1, 13, 19, 4294967294UL, 12);
+      s2 = TAUSWORTHE (s2, 2, 25, 4294967288UL, 4);
+      s3 = TAUSWORTHE (s3, 3, 11, 4294967280UL, 17);
+      x[i] = s1 ^ s2 ^ s3;
+    }
+
+  state->s1 = s1;
+  state->s2 = s2;
+  state->s3 = s3;
+}
+
+static void
+taus_get_double_array (void *vstate, double * x, size_t n)
+{
+  taus_state_t *state = (taus_state_t *) vstate;
+  unsigned long int s1 = state->s1, s2 = state->s2, s3 = state->s3;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      s1 = TAUSWORTHE (s1, 13, 19, 4294967294UL, 12);
+      s2 = TAUSWORTHE (s2, 2, 25, 4294967288UL, 4);
+      s3 = TAUSWORTHE (s3, 3, 11, 4294967280UL, 17);
+      x[i] = (s1 ^ s2 ^ s3) / 4294967296.0;
+    }
+
+  state->s1 = s1;
+  state->s2 = s2;
+  state->s3 = s3;
+}
+
 static void
 taus_set (void *vstate, unsigned long int s)
 {
@@ -168,7 +214,11 @@ static const gsl_rng_type taus_type =
  sizeof (taus_state_t),
  &taus_set,
  &taus_get,
- &taus_get_double};
+ &taus_get_double,
+ &taus_get_array,
+ &taus_get_double_array,
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_taus = &taus_type;
 
@@ -179,6 +229,10 @@ static const gsl_rng_type taus2_type =
  sizeof (taus_state_t),
  &taus2_set,
  &taus_get,
- &taus_get_double};
+ &taus_get_double,
+ &taus_get_array,
+ &taus_get_double_array,
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_taus2 = &taus2_type;
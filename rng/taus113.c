@@ -65,6 +65,8 @@
 static inline unsigned long int taus113_get (void *vstate);
 static double taus113_get_double (void *vstate);
 static void taus113_set (void *state, unsigned long int s);
+static void taus113_get_array (void *vstate, unsigned long int * x, size_t n);
+static void taus113_get_double_array (void *vstate, double * x, size_t n);
 
 typedef struct
 {
@@ -100,6 +102,59 @@ taus113_get_double (void *vstate)
   return taus113_get (vstate) / 4294967296.0;
 }
 
+/* The four components are independent, so keeping them in local
+   variables for the whole array lets the compiler interleave (or
+   vectorize) the four recurrences without reloading the state. */
+
+#define TAUS113_STEP(z1,z2,z3,z4) do { \
+  unsigned long b1, b2, b3, b4; \
+  b1 = ((((z1 << 6UL) & MASK) ^ z1) >> 13UL); \
+  z1 = ((((z1 & 4294967294UL) << 18UL) & MASK) ^ b1); \
+  b2 = ((((z2 << 2UL) & MASK) ^ z2) >> 27UL); \
+  z2 = ((((z2 & 4294967288UL) << 2UL) & MASK) ^ b2); \
+  b3 = ((((z3 << 13UL) & MASK) ^ z3) >> 21UL); \
+  z3 = ((((z3 & 4294967280UL) << 7UL) & MASK) ^ b3); \
+  b4 = ((((z4 << 3UL) & MASK) ^ z4) >> 12UL); \
+  z4 = ((((z4 & 4294967168UL) << 13UL) & MASK) ^ b4); } while (0)
+
+static void
+taus113_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  taus113_state_t *state = (taus113_state_t *) vstate;
+  unsigned long z1 = state->z1, z2 = state->z2, z3 = state->z3, z4 = state->z4;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      TAUS113_STEP (z1, z2, z3, z4);
+      x[i] = z1 ^ z2 ^ z3 ^ z4;
+    }
+
+  state->z1 = z1;
+  state->z2 = z2;
+  state->z3 = z3;
+  state->z4 = z4;
+}
+
+static void
+taus113_get_double_array (void *vstate, double * x, size_t n)
+{
+  taus113_state_t *state = (taus113_state_t *) vstate;
+  unsigned long z1 = state->z1, z2 = state->z2, z3 = state->z3, z4 = state->z4;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      TAUS113_STEP (z1, z2, z3, z4);
+      x[i] = (z1 ^ z2 ^ z3 ^ z4) / 4294967296.0;
+    }
+
+  state->z1 = z1;
+  state->z2 = z2;
+  state->z3 = z3;
+  state->z4 = z4;
+}
+
 static void
 taus113_set (void *vstate, unsigned long int s)
 {
@@ -143,7 +198,11 @@ static const gsl_rng_type taus113_type = {
   sizeof (taus113_state_t),
   &taus113_set,
   &taus113_get,
-  &taus113_get_double
+  &taus113_get_double,
+  &taus113_get_array,
+  &taus113_get_double_array,
+  0,                            /* skip */
+  0                             /* skip_streams */
 };
 
 const gsl_rng_type *gsl_rng_taus113 = &taus113_type;
@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_ieee_utils.h>
@@ -32,6 +34,9 @@ void generic_rng_test (const gsl_rng_type * T);
 void rng_state_test (const gsl_rng_type * T);
 void rng_parallel_state_test (const gsl_rng_type * T);
 void rng_read_write_test (const gsl_rng_type * T);
+void rng_array_test (const gsl_rng_type * T);
+void rng_skip_test (const gsl_rng_type * T);
+void rng_stream_test (const gsl_rng_type * T);
 int rng_max_test (gsl_rng * r, unsigned long int *kmax, unsigned long int ran_max) ;
 int rng_min_test (gsl_rng * r, unsigned long int *kmin, unsigned long int ran_min, unsigned long int ran_max) ;
 int rng_sum_test (gsl_rng * r, double *sigma);
@@ -181,6 +186,12 @@ main (void)
   rng_test (gsl_rng_ranf, 0, 10000, 2152890433UL);
   rng_test (gsl_rng_ranf, 2, 10000, 339327233);
 
+  /* Known answers for the counter-based generators with key 0 and
+     counter 0, from the Random123 distribution */
+
+  rng_test (gsl_rng_philox4x32, 0, 4, 0x9b00dbd8UL);
+  rng_test (gsl_rng_threefry4x64, 0, 8, 0xee29ec84UL);
+
   /* Test constant relationship between int and double functions */
 
   for (r = rngs ; *r != 0; r++)
@@ -197,6 +208,19 @@ main (void)
   for (r = rngs ; *r != 0; r++)
     rng_read_write_test (*r);
 
+  /* Test bulk generation against the scalar functions */
+
+  for (r = rngs ; *r != 0; r++)
+    rng_array_test (*r);
+
+  /* Test skipping ahead and independent streams */
+
+  for (r = rngs ; *r != 0; r++)
+    rng_skip_test (*r);
+
+  for (r = rngs ; *r != 0; r++)
+    rng_stream_test (*r);
+
   /* generic statistical tests (these are just to make sure that we
      don't get any crazy results back from the generator, i.e. they
      aren't a test of the algorithm, just the implementation) */
@@ -431,6 +455,215 @@ rng_read_write_test (const gsl_rng_type * T)
   gsl_rng_free (r);
 }
 
+void
+rng_array_test (const gsl_rng_type * T)
+{
+  /* block sizes chosen to cross internal buffer boundaries */
+  const size_t sizes[] = { 1, 7, 12, 623, 625, 1000, 3001 };
+  const size_t nsizes = sizeof (sizes) / sizeof (sizes[0]);
+  unsigned long int ka[N], kb[N];
+  double ua[N], ub[N];
+  size_t i, j, k;
+  int status_int = 0, status_double = 0, status_pos = 0;
+
+  gsl_rng *r1 = gsl_rng_alloc (T);
+  gsl_rng *r2 = gsl_rng_alloc (T);
+
+  for (j = 0; j < nsizes; j++)
+    {
+      size_t n = sizes[j];
+
+      gsl_rng_get_array (r1, ka, n);
+      for (i = 0; i < n; i++)
+        kb[i] = gsl_rng_get (r2);
+      for (i = 0; i < n; i++)
+        status_int |= (ka[i] != kb[i]);
+
+      gsl_rng_uniform_array (r1, ua, n);
+      for (i = 0; i < n; i++)
+        ub[i] = gsl_rng_uniform (r2);
+      for (i = 0; i < n; i++)
+        status_double |= (ua[i] != ub[i]);
+
+      gsl_rng_uniform_pos_array (r1, ua, n);
+      for (i = 0; i < n; i++)
+        ub[i] = gsl_rng_uniform_pos (r2);
+      for (i = 0; i < n; i++)
+        status_pos |= (ua[i] != ub[i] || ua[i] == 0);
+    }
+
+  /* interleaved scalar and bulk calls on the same generator */
+  for (k = 0; k < 3; k++)
+    {
+      ka[0] = gsl_rng_get (r1);
+      kb[0] = gsl_rng_get (r2);
+      status_int |= (ka[0] != kb[0]);
+
+      gsl_rng_get_array (r1, ka, N);
+      for (i = 0; i < N; i++)
+        status_int |= (ka[i] != gsl_rng_get (r2));
+    }
+
+  gsl_test (status_int, "%s, bulk integer generation", gsl_rng_name (r1));
+  gsl_test (status_double, "%s, bulk uniform generation", gsl_rng_name (r1));
+  gsl_test (status_pos, "%s, bulk positive uniform generation", gsl_rng_name (r1));
+
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
+void
+rng_skip_test (const gsl_rng_type * T)
+{
+  /* distances chosen to cross internal buffer boundaries */
+  const unsigned long int skips[] = { 0, 1, 3, 7, 623, 624, 625, 10007 };
+  const size_t nskips = sizeof (skips) / sizeof (skips[0]);
+  size_t i, j;
+  int status = 0;
+
+  gsl_rng *r1 = gsl_rng_alloc (T);
+  gsl_rng *r2 = gsl_rng_alloc (T);
+
+  for (j = 0; j < nskips; j++)
+    {
+      unsigned long int k;
+
+      gsl_rng_skip (r1, skips[j]);
+
+      for (k = 0; k < skips[j]; k++)
+        gsl_rng_get (r2);
+
+      for (i = 0; i < 5; i++)
+        status |= (gsl_rng_get (r1) != gsl_rng_get (r2));
+    }
+
+  gsl_test (status, "%s, skip ahead", gsl_rng_name (r1));
+
+  /* long distances, for generators which can skip in less than O(n),
+     checked by splitting the distance in two */
+
+  if (T->skip)
+    {
+      const unsigned long int n1 = (1UL << 26) + 12345;
+      const unsigned long int n2 = 4321;
+
+      status = 0;
+
+      gsl_rng_set (r1, 1);
+      gsl_rng_set (r2, 1);
+
+      for (i = 0; i < 17; i++)
+        gsl_rng_get (r1);
+
+      gsl_rng_memcpy (r2, r1);
+
+      gsl_rng_skip (r1, n1 + n2);
+      gsl_rng_skip (r2, n1);
+      gsl_rng_skip (r2, n2);
+
+      for (i = 0; i < 1000; i++)
+        status |= (gsl_rng_get (r1) != gsl_rng_get (r2));
+
+      gsl_test (status, "%s, long skip ahead", gsl_rng_name (r1));
+
+      /* a long distance against stepping forward, from a state part
+         way through the internal buffer */
+
+      status = 0;
+
+      gsl_rng_set (r1, 1);
+
+      for (i = 0; i < 17; i++)
+        gsl_rng_get (r1);
+
+      gsl_rng_memcpy (r2, r1);
+
+      {
+        const unsigned long int n = (1UL << 25) + 7;
+        unsigned long int k;
+
+        gsl_rng_skip (r1, n);
+
+        for (k = 0; k < n; k++)
+          gsl_rng_get (r2);
+      }
+
+      for (i = 0; i < 1000; i++)
+        status |= (gsl_rng_get (r1) != gsl_rng_get (r2));
+
+      gsl_test (status, "%s, long skip ahead against stepping",
+                gsl_rng_name (r1));
+    }
+
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
+void
+rng_stream_test (const gsl_rng_type * T)
+{
+  gsl_rng *r1 = gsl_rng_alloc (T);
+  gsl_rng *r2 = gsl_rng_alloc (T);
+  const unsigned long int seed = 12345;
+  size_t i;
+  int status = 0;
+
+  if (T->skip_streams == 0)
+    {
+      gsl_error_handler_t *h = gsl_set_error_handler_off ();
+
+      status = (gsl_rng_set_stream (r1, seed, 1) != GSL_EUNSUP);
+      gsl_set_error_handler (h);
+
+      gsl_test (status, "%s, streams unsupported", gsl_rng_name (r1));
+
+      gsl_rng_free (r1);
+      gsl_rng_free (r2);
+      return;
+    }
+
+  /* stream 0 is the ordinary sequence of the seed */
+
+  gsl_rng_set_stream (r1, seed, 0);
+  gsl_rng_set (r2, seed);
+
+  for (i = 0; i < 1000; i++)
+    status |= (gsl_rng_get (r1) != gsl_rng_get (r2));
+
+  gsl_test (status, "%s, stream 0", gsl_rng_name (r1));
+
+  /* stream 1 differs from stream 0 */
+
+  status = 1;
+
+  gsl_rng_set_stream (r1, seed, 1);
+  gsl_rng_set (r2, seed);
+
+  for (i = 0; i < 10; i++)
+    status &= (gsl_rng_get (r1) == gsl_rng_get (r2));
+
+  gsl_test (status, "%s, stream 1 differs from stream 0", gsl_rng_name (r1));
+
+#if ULONG_MAX > 0xffffffffUL
+  /* stream 1 starts 2^64 numbers into the sequence */
+
+  status = 0;
+
+  gsl_rng_set_stream (r1, seed, 1);
+  gsl_rng_set (r2, seed);
+  gsl_rng_skip (r2, 1UL << 63);
+  gsl_rng_skip (r2, 1UL << 63);
+
+  for (i = 0; i < 1000; i++)
+    status |= (gsl_rng_get (r1) != gsl_rng_get (r2));
+
+  gsl_test (status, "%s, stream 1 offset", gsl_rng_name (r1));
+#endif
+
+  gsl_rng_free (r1);
+  gsl_rng_free (r2);
+}
+
 void
 generic_rng_test (const gsl_rng_type * T)
 {
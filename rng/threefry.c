@@ -0,0 +1,326 @@
+/* rng/threefry.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+
+/* This is the Threefry4x64-20 counter-based generator. Each block of
+   four 64-bit words is obtained by applying 20 rounds of the Threefish
+   block cipher (with the key schedule injected every four rounds) to
+   a 256-bit counter under a 256-bit key. Each 64-bit word is returned
+   as two 32-bit numbers, low half first, giving eight outputs per
+   block.
+
+   The seed is used as the first word of the key, the remaining words
+   are zero. The counter is incremented by one for each block, so the
+   state of the generator can be moved to any position in O(1) time.
+   Stream k of a seed starts 2^64 k numbers into the sequence of that
+   seed.
+
+   The 64-bit arithmetic is carried out on pairs of 32-bit words so
+   that the generator gives the same results on all platforms.
+
+   The period of this generator is 2^259.
+
+   From: J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+   "Parallel random numbers: as easy as 1, 2, 3", Proceedings of the
+   International Conference for High Performance Computing,
+   Networking, Storage and Analysis (SC11), 2011. */
+
+static inline unsigned long int threefry_get (void *vstate);
+static double threefry_get_double (void *vstate);
+static void threefry_set (void *state, unsigned long int s);
+static void threefry_get_array (void *vstate, unsigned long int * x, size_t n);
+static void threefry_get_double_array (void *vstate, double * x, size_t n);
+static void threefry_skip (void *vstate, unsigned long int n);
+static void threefry_skip_streams (void *vstate, unsigned long int k);
+
+#define MASK 0xffffffffUL
+
+#define THREEFRY_ROUNDS 20
+
+/* 64-bit words are stored as (lo, hi) pairs of 32-bit values */
+
+typedef struct
+  {
+    unsigned long int lo, hi;
+  }
+threefry_word_t;
+
+typedef struct
+  {
+    threefry_word_t ctr[4];     /* 256-bit counter of current block */
+    threefry_word_t key[4];     /* 256-bit key */
+    unsigned long int out[8];   /* current block of output */
+    unsigned int pos;           /* position of next output in block */
+  }
+threefry_state_t;
+
+/* rotation constants for Threefish-256 */
+static const int R[8][2] = { {14, 16}, {52, 57}, {23, 40}, {5, 37},
+                             {25, 33}, {46, 12}, {58, 22}, {32, 32} };
+
+/* key schedule parity constant 0x1BD11BDAA9FC1A22 */
+static const threefry_word_t parity = { 0xA9FC1A22UL, 0x1BD11BDAUL };
+
+static inline threefry_word_t
+w_add (threefry_word_t a, threefry_word_t b)
+{
+  threefry_word_t c;
+
+  c.lo = (a.lo + b.lo) & MASK;
+  c.hi = (a.hi + b.hi + (c.lo < a.lo)) & MASK;
+
+  return c;
+}
+
+static inline threefry_word_t
+w_xor (threefry_word_t a, threefry_word_t b)
+{
+  threefry_word_t c;
+
+  c.lo = a.lo ^ b.lo;
+  c.hi = a.hi ^ b.hi;
+
+  return c;
+}
+
+static inline threefry_word_t
+w_rotl (threefry_word_t a, int r)
+{
+  threefry_word_t c;
+
+  if (r >= 32)
+    {
+      unsigned long int t = a.lo;
+      a.lo = a.hi;
+      a.hi = t;
+      r -= 32;
+    }
+
+  if (r == 0)
+    return a;
+
+  c.hi = ((a.hi << r) | (a.lo >> (32 - r))) & MASK;
+  c.lo = ((a.lo << r) | (a.hi >> (32 - r))) & MASK;
+
+  return c;
+}
+
+static void
+threefry_block (threefry_state_t * state)
+{
+  threefry_word_t ks[5], x[4];
+  int i, r;
+
+  ks[4] = parity;
+
+  for (i = 0; i < 4; i++)
+    {
+      ks[i] = state->key[i];
+      ks[4] = w_xor (ks[4], ks[i]);
+      x[i] = w_add (state->ctr[i], ks[i]);
+    }
+
+  for (r = 0; r < THREEFRY_ROUNDS; r++)
+    {
+      const int *rot = R[r % 8];
+
+      if (r % 2 == 0)
+        {
+          x[0] = w_add (x[0], x[1]);
+          x[1] = w_xor (w_rotl (x[1], rot[0]), x[0]);
+          x[2] = w_add (x[2], x[3]);
+          x[3] = w_xor (w_rotl (x[3], rot[1]), x[2]);
+        }
+      else
+        {
+          x[0] = w_add (x[0], x[3]);
+          x[3] = w_xor (w_rotl (x[3], rot[0]), x[0]);
+          x[2] = w_add (x[2], x[1]);
+          x[1] = w_xor (w_rotl (x[1], rot[1]), x[2]);
+        }
+
+      if (r % 4 == 3)
+        {
+          /* inject key schedule s = (r + 1) / 4 */
+          const int s = (r + 1) / 4;
+          threefry_word_t sw;
+
+          sw.lo = (unsigned long int) s;
+          sw.hi = 0;
+
+          for (i = 0; i < 4; i++)
+            x[i] = w_add (x[i], ks[(s + i) % 5]);
+
+          x[3] = w_add (x[3], sw);
+        }
+    }
+
+  for (i = 0; i < 4; i++)
+    {
+      state->out[2 * i] = x[i].lo;
+      state->out[2 * i + 1] = x[i].hi;
+    }
+}
+
+/* add the 32-bit value v to 32-bit word i of the counter, with carry */
+
+static inline void
+threefry_ctr_add (threefry_state_t * state, int i, unsigned long int v)
+{
+  for (; i < 8 && v != 0; i++)
+    {
+      unsigned long int *w = (i % 2 == 0) ? &state->ctr[i / 2].lo : &state->ctr[i / 2].hi;
+      unsigned long int c = (*w + v) & MASK;
+      v = (c < v) ? 1 : 0;
+      *w = c;
+    }
+}
+
+static inline unsigned long int
+threefry_get (void *vstate)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+
+  if (state->pos >= 8)
+    {
+      threefry_ctr_add (state, 0, 1);
+      threefry_block (state);
+      state->pos = 0;
+    }
+
+  return state->out[state->pos++];
+}
+
+static double
+threefry_get_double (void *vstate)
+{
+  return threefry_get (vstate) / 4294967296.0;
+}
+
+static void
+threefry_get_array (void *vstate, unsigned long int * x, size_t n)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      if (state->pos >= 8)
+        {
+          threefry_ctr_add (state, 0, 1);
+          threefry_block (state);
+          state->pos = 0;
+        }
+
+      x[i] = state->out[state->pos++];
+    }
+}
+
+static void
+threefry_get_double_array (void *vstate, double * x, size_t n)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      if (state->pos >= 8)
+        {
+          threefry_ctr_add (state, 0, 1);
+          threefry_block (state);
+          state->pos = 0;
+        }
+
+      x[i] = state->out[state->pos++] / 4294967296.0;
+    }
+}
+
+static void
+threefry_skip (void *vstate, unsigned long int n)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+
+  /* n = 8 q + r, move forward q blocks and r positions */
+  unsigned long int q = n / 8;
+  unsigned int p = state->pos + (unsigned int) (n % 8);
+
+  if (p >= 8)
+    {
+      q++;
+      p -= 8;
+    }
+
+  if (q > 0)
+    {
+      threefry_ctr_add (state, 0, q & MASK);
+      threefry_ctr_add (state, 1, (q >> 16) >> 16);
+      threefry_block (state);
+    }
+
+  state->pos = p;
+}
+
+static void
+threefry_skip_streams (void *vstate, unsigned long int k)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+
+  /* 2^64 k numbers are 2^61 k blocks */
+  threefry_ctr_add (state, 1, (k << 29) & MASK);
+  threefry_ctr_add (state, 2, (k >> 3) & MASK);
+  threefry_ctr_add (state, 3, ((k >> 16) >> 19) & MASK);
+  threefry_block (state);
+}
+
+static void
+threefry_set (void *vstate, unsigned long int s)
+{
+  threefry_state_t *state = (threefry_state_t *) vstate;
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      state->key[i].lo = 0;
+      state->key[i].hi = 0;
+      state->ctr[i].lo = 0;
+      state->ctr[i].hi = 0;
+    }
+
+  state->key[0].lo = s & MASK;
+  state->key[0].hi = ((s >> 16) >> 16) & MASK;
+
+  threefry_block (state);
+  state->pos = 0;
+}
+
+static const gsl_rng_type threefry_type =
+{"threefry4x64",                /* name */
+ 0xffffffffUL,                  /* RAND_MAX */
+ 0,                             /* RAND_MIN */
+ sizeof (threefry_state_t),
+ &threefry_set,
+ &threefry_get,
+ &threefry_get_double,
+ &threefry_get_array,
+ &threefry_get_double_array,
+ &threefry_skip,
+ &threefry_skip_streams};
+
+const gsl_rng_type *gsl_rng_threefry4x64 = &threefry_type;
@@ -78,6 +78,10 @@ static const gsl_rng_type transputer_type =
  sizeof (transputer_state_t),
  &transputer_set,
  &transputer_get,
- &transputer_get_double};
+ &transputer_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_transputer = &transputer_type;
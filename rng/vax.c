@@ -78,6 +78,10 @@ static const gsl_rng_type vax_type =
  sizeof (vax_state_t),
  &vax_set,
  &vax_get,
- &vax_get_double};
+ &vax_get_double,
+ 0,                             /* get_array */
+ 0,                             /* get_double_array */
+ 0,                             /* skip */
+ 0};                            /* skip_streams */
 
 const gsl_rng_type *gsl_rng_vax = &vax_type;
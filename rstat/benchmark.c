@@ -0,0 +1,189 @@
+/* rstat/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Update rate and rank error of the quantile estimators on heavy
+   tailed (lognormal) data, as for request latencies. The P^2
+   algorithm needs one workspace for each of the NP quantiles, while a
+   single sketch answers all of them. The rank error is the distance
+   between p and the fraction of the data below the estimate.
+
+   The data are presented in random order, where P^2 does well, and
+   in increasing order, as for a slowly drifting stream, where its
+   markers lag behind the data. The accuracy of the sketch is nearly
+   independent of the order. */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_rstat.h>
+
+#define N 10000000
+
+#define NP 4
+
+static const double p[NP] = { 0.5, 0.9, 0.99, 0.999 };
+
+static double
+seconds (clock_t start, clock_t end)
+{
+  return (end - start) / (double) CLOCKS_PER_SEC;
+}
+
+static double
+rank_error (const double sorted[], const size_t n, const double x, const double pi)
+{
+  size_t lo = 0, hi = n;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (sorted[mid] < x)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return fabs ((double) lo / (double) n - pi);
+}
+
+static void
+print_row (const char *name, const double t, const size_t bytes,
+           const double sorted[], const double q[])
+{
+  size_t i;
+
+  printf ("%-16s %10.2f %8lu", name, N / t / 1e6, (unsigned long) bytes);
+
+  for (i = 0; i < NP; i++)
+    printf (" %10.2e", rank_error (sorted, N, q[i], p[i]));
+
+  printf ("\n");
+}
+
+static void
+time_p2 (const double x[], const double sorted[])
+{
+  gsl_rstat_quantile_workspace *w[NP];
+  double q[NP];
+  clock_t start;
+  double t;
+  size_t i, j;
+
+  for (j = 0; j < NP; j++)
+    w[j] = gsl_rstat_quantile_alloc (p[j]);
+
+  start = clock ();
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < NP; j++)
+        gsl_rstat_quantile_add (x[i], w[j]);
+    }
+
+  t = seconds (start, clock ());
+
+  for (j = 0; j < NP; j++)
+    {
+      q[j] = gsl_rstat_quantile_get (w[j]);
+      gsl_rstat_quantile_free (w[j]);
+    }
+
+  print_row ("P^2", t, NP * sizeof (gsl_rstat_quantile_workspace), sorted, q);
+}
+
+static void
+time_sketch (const double x[], const double sorted[], const double compression)
+{
+  gsl_rstat_sketch_workspace *w = gsl_rstat_sketch_alloc (compression);
+  char name[32];
+  double q[NP];
+  clock_t start;
+  double t;
+  size_t i, bytes;
+  FILE *f;
+
+  start = clock ();
+
+  for (i = 0; i < N; i++)
+    gsl_rstat_sketch_add (x[i], w);
+
+  t = seconds (start, clock ());
+
+  for (i = 0; i < NP; i++)
+    q[i] = gsl_rstat_sketch_quantile (p[i], w);
+
+  /* size of the serialized sketch */
+  f = tmpfile ();
+  gsl_rstat_sketch_fwrite (f, w);
+  bytes = (size_t) ftell (f);
+  fclose (f);
+
+  sprintf (name, "sketch %g", compression);
+  print_row (name, t, bytes, sorted, q);
+
+  gsl_rstat_sketch_free (w);
+}
+
+int
+main (void)
+{
+  gsl_rng *r = gsl_rng_alloc (gsl_rng_default);
+  double *x = (double *) malloc (N * sizeof (double));
+  double *sorted = (double *) malloc (N * sizeof (double));
+  size_t i;
+  int order;
+
+  for (i = 0; i < N; i++)
+    x[i] = gsl_ran_lognormal (r, 0.0, 1.0);
+
+  memcpy (sorted, x, N * sizeof (double));
+  gsl_sort (sorted, 1, N);
+
+  printf ("# %d lognormal values, rate in million updates/sec, "
+          "size in bytes\n", N);
+
+  for (order = 0; order < 2; order++)
+    {
+      const double *data = (order == 0) ? x : sorted;
+
+      printf ("# %s order\n", (order == 0) ? "random" : "increasing");
+      printf ("%-16s %10s %8s", "estimator", "rate", "size");
+
+      for (i = 0; i < NP; i++)
+        printf ("  err p=%-5g", p[i]);
+
+      printf ("\n");
+
+      time_p2 (data, sorted);
+      time_sketch (data, sorted, 50.0);
+      time_sketch (data, sorted, 100.0);
+      time_sketch (data, sorted, 200.0);
+      time_sketch (data, sorted, 1000.0);
+    }
+
+  free (x);
+  free (sorted);
+  gsl_rng_free (r);
+
+  return 0;
+}
@@ -20,6 +20,8 @@
 #ifndef __GSL_RSTAT_H__
 #define __GSL_RSTAT_H__
 
+#include <stdio.h>
+
 #undef __BEGIN_DECLS
 #undef __END_DECLS
 #ifdef __cplusplus
@@ -48,6 +50,34 @@ int gsl_rstat_quantile_reset(gsl_rstat_quantile_workspace *w);
 int gsl_rstat_quantile_add(const double x, gsl_rstat_quantile_workspace *w);
 double gsl_rstat_quantile_get(gsl_rstat_quantile_workspace *w);
 
+typedef struct
+{
+  double compression;   /* compression parameter delta */
+  size_t n;             /* number of data added */
+  double min;           /* minimum value added */
+  double max;           /* maximum value added */
+  size_t ncentroids;    /* number of centroids */
+  size_t max_centroids; /* maximum number of centroids */
+  double *mean;         /* centroid means, in increasing order */
+  double *weight;       /* centroid weights */
+  size_t nbuffer;       /* number of data in buffer */
+  size_t buffer_size;   /* size of buffer */
+  double *buffer;       /* data not yet merged into the centroids */
+  double *work;         /* workspace for merging */
+} gsl_rstat_sketch_workspace;
+
+gsl_rstat_sketch_workspace *gsl_rstat_sketch_alloc(const double compression);
+void gsl_rstat_sketch_free(gsl_rstat_sketch_workspace *w);
+int gsl_rstat_sketch_reset(gsl_rstat_sketch_workspace *w);
+size_t gsl_rstat_sketch_n(const gsl_rstat_sketch_workspace *w);
+int gsl_rstat_sketch_add(const double x, gsl_rstat_sketch_workspace *w);
+int gsl_rstat_sketch_merge(gsl_rstat_sketch_workspace *w,
+                           const gsl_rstat_sketch_workspace *src);
+double gsl_rstat_sketch_quantile(const double p, gsl_rstat_sketch_workspace *w);
+double gsl_rstat_sketch_cdf(const double x, gsl_rstat_sketch_workspace *w);
+int gsl_rstat_sketch_fwrite(FILE *stream, gsl_rstat_sketch_workspace *w);
+int gsl_rstat_sketch_fread(FILE *stream, gsl_rstat_sketch_workspace *w);
+
 typedef struct
 {
   double min;      /* minimum value added */
@@ -57,13 +87,16 @@ typedef struct
   double M3;
   double M4;
   size_t n;        /* number of data points added */
-  gsl_rstat_quantile_workspace *median_workspace_p; /* median workspace */
+  gsl_rstat_sketch_workspace *sketch_workspace_p; /* quantile sketch */
 } gsl_rstat_workspace;
 
 gsl_rstat_workspace *gsl_rstat_alloc(void);
 void gsl_rstat_free(gsl_rstat_workspace *w);
 size_t gsl_rstat_n(const gsl_rstat_workspace *w);
 int gsl_rstat_add(const double x, gsl_rstat_workspace *w);
+int gsl_rstat_add_array(const double x[], const size_t stride, const size_t n,
+                        gsl_rstat_workspace *w);
+int gsl_rstat_merge(gsl_rstat_workspace *w, const gsl_rstat_workspace *src);
 double gsl_rstat_min(const gsl_rstat_workspace *w);
 double gsl_rstat_max(const gsl_rstat_workspace *w);
 double gsl_rstat_mean(const gsl_rstat_workspace *w);
@@ -0,0 +1,525 @@
+/* rstat/rsketch.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_rstat.h>
+
+/*
+ * Mergeable quantile sketch based on the merging t-digest of
+ *
+ * [1] T. Dunning and O. Ertl, "Computing extremely accurate quantiles
+ *     using t-digests", arXiv:1902.04023 (2019)
+ *
+ * The data are summarized by a sorted list of centroids (mean,
+ * weight). New data are collected in a buffer, and when it is full
+ * the buffer is sorted, interleaved with the centroids and merged
+ * greedily from left to right. A centroid spanning the quantiles
+ * [q_left, q_right] is allowed as long as k(q_right) - k(q_left) <= 1
+ * for the scale function
+ *
+ *   k(q) = delta / (2 pi) asin(2q - 1)
+ *
+ * which gives small centroids, and therefore accurate estimates, near
+ * q = 0 and q = 1. At most delta + 2 centroids are kept. Two sketches
+ * are merged by the same procedure applied to the centroids and
+ * buffers of both.
+ *
+ * The binary form written by gsl_rstat_sketch_fwrite() is the header
+ * { compression, n, ncentroids, min, max } followed by the centroid
+ * means and weights, all stored as doubles in native format.
+ */
+
+#define SKETCH_HEADER_SIZE 5
+
+static int sketch_compress(gsl_rstat_sketch_workspace *w);
+static size_t sketch_merge_points(gsl_rstat_sketch_workspace *w, double *mean,
+                                  double *weight, const size_t n,
+                                  const double total);
+
+gsl_rstat_sketch_workspace *
+gsl_rstat_sketch_alloc(const double compression)
+{
+  gsl_rstat_sketch_workspace *w;
+
+  if (!(compression >= 10.0 && compression <= 1.0e6))
+    {
+      GSL_ERROR_NULL ("compression must be between 10 and 10^6", GSL_EDOM);
+    }
+
+  w = calloc(1, sizeof(gsl_rstat_sketch_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->compression = compression;
+  w->max_centroids = (size_t) ceil(compression) + 4;
+  w->buffer_size = 5 * (size_t) ceil(compression);
+
+  w->mean = malloc(w->max_centroids * sizeof(double));
+  w->weight = malloc(w->max_centroids * sizeof(double));
+  w->buffer = malloc(w->buffer_size * sizeof(double));
+  w->work = malloc(2 * (w->max_centroids + w->buffer_size) * sizeof(double));
+
+  if (w->mean == 0 || w->weight == 0 || w->buffer == 0 || w->work == 0)
+    {
+      gsl_rstat_sketch_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for centroids", GSL_ENOMEM);
+    }
+
+  gsl_rstat_sketch_reset(w);
+
+  return w;
+} /* gsl_rstat_sketch_alloc() */
+
+void
+gsl_rstat_sketch_free(gsl_rstat_sketch_workspace *w)
+{
+  RETURN_IF_NULL(w);
+
+  free(w->mean);
+  free(w->weight);
+  free(w->buffer);
+  free(w->work);
+  free(w);
+} /* gsl_rstat_sketch_free() */
+
+int
+gsl_rstat_sketch_reset(gsl_rstat_sketch_workspace *w)
+{
+  w->n = 0;
+  w->min = 0.0;
+  w->max = 0.0;
+  w->ncentroids = 0;
+  w->nbuffer = 0;
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_sketch_reset() */
+
+size_t
+gsl_rstat_sketch_n(const gsl_rstat_sketch_workspace *w)
+{
+  return w->n;
+} /* gsl_rstat_sketch_n() */
+
+int
+gsl_rstat_sketch_add(const double x, gsl_rstat_sketch_workspace *w)
+{
+  if (gsl_isnan(x))
+    {
+      GSL_ERROR ("invalid input argument x", GSL_EINVAL);
+    }
+
+  if (w->n == 0)
+    {
+      w->min = x;
+      w->max = x;
+    }
+  else
+    {
+      if (x < w->min)
+        w->min = x;
+      if (x > w->max)
+        w->max = x;
+    }
+
+  w->buffer[w->nbuffer++] = x;
+  ++(w->n);
+
+  if (w->nbuffer == w->buffer_size)
+    return sketch_compress(w);
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_sketch_add() */
+
+/* merge the data summarized by src into w */
+int
+gsl_rstat_sketch_merge(gsl_rstat_sketch_workspace *w,
+                       const gsl_rstat_sketch_workspace *src)
+{
+  const size_t n = w->ncentroids + w->nbuffer + src->ncentroids + src->nbuffer;
+  double *mean, *weight;
+  size_t i, m = 0;
+
+  if (src->n == 0)
+    return GSL_SUCCESS;
+
+  mean = malloc(2 * n * sizeof(double));
+  if (mean == 0)
+    {
+      GSL_ERROR ("failed to allocate space for merging", GSL_ENOMEM);
+    }
+
+  weight = mean + n;
+
+  for (i = 0; i < w->ncentroids; ++i, ++m)
+    {
+      mean[m] = w->mean[i];
+      weight[m] = w->weight[i];
+    }
+
+  for (i = 0; i < w->nbuffer; ++i, ++m)
+    {
+      mean[m] = w->buffer[i];
+      weight[m] = 1.0;
+    }
+
+  for (i = 0; i < src->ncentroids; ++i, ++m)
+    {
+      mean[m] = src->mean[i];
+      weight[m] = src->weight[i];
+    }
+
+  for (i = 0; i < src->nbuffer; ++i, ++m)
+    {
+      mean[m] = src->buffer[i];
+      weight[m] = 1.0;
+    }
+
+  if (w->n == 0)
+    {
+      w->min = src->min;
+      w->max = src->max;
+    }
+  else
+    {
+      if (src->min < w->min)
+        w->min = src->min;
+      if (src->max > w->max)
+        w->max = src->max;
+    }
+
+  gsl_sort2(mean, 1, weight, 1, n);
+
+  w->n += src->n;
+  w->nbuffer = 0;
+  w->ncentroids = sketch_merge_points(w, mean, weight, n, (double) w->n);
+
+  free(mean);
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_sketch_merge() */
+
+/*
+gsl_rstat_sketch_quantile()
+  Estimate the p-quantile of the data added so far, with the same
+definition as gsl_stats_quantile_from_sorted_data. A centroid of
+weight w_i preceded by a total weight c_i is placed at the (zero
+based) position c_i + (w_i - 1)/2 of the sorted data, the minimum and
+maximum at the positions 0 and n - 1, and the value at position
+p (n - 1) is found by linear interpolation. The result is exact as
+long as every centroid holds a single value.
+*/
+
+double
+gsl_rstat_sketch_quantile(const double p, gsl_rstat_sketch_workspace *w)
+{
+  double pos, left_pos, left_x, c = 0.0;
+  size_t i;
+
+  if (!(p >= 0.0 && p <= 1.0))
+    {
+      GSL_ERROR_VAL ("p must lie in [0,1]", GSL_EDOM, GSL_NAN);
+    }
+
+  if (w->n == 0)
+    return 0.0;
+
+  sketch_compress(w);
+
+  pos = p * (w->n - 1.0);
+  left_pos = 0.0;
+  left_x = w->min;
+
+  for (i = 0; i <= w->ncentroids; ++i)
+    {
+      double right_pos, right_x;
+
+      if (i < w->ncentroids)
+        {
+          right_pos = c + 0.5 * (w->weight[i] - 1.0);
+          right_x = w->mean[i];
+          c += w->weight[i];
+        }
+      else
+        {
+          right_pos = w->n - 1.0;
+          right_x = w->max;
+        }
+
+      if (pos <= right_pos)
+        {
+          if (right_pos > left_pos)
+            return left_x + (right_x - left_x) * (pos - left_pos) / (right_pos - left_pos);
+          else
+            return right_x;
+        }
+
+      left_pos = right_pos;
+      left_x = right_x;
+    }
+
+  return w->max;
+} /* gsl_rstat_sketch_quantile() */
+
+/*
+gsl_rstat_sketch_cdf()
+  Estimate the fraction of the data below x, by inverting the
+piecewise linear interpolation used in gsl_rstat_sketch_quantile(),
+so that gsl_rstat_sketch_cdf(gsl_rstat_sketch_quantile(p)) = p
+wherever the interpolant is strictly increasing.
+*/
+
+double
+gsl_rstat_sketch_cdf(const double x, gsl_rstat_sketch_workspace *w)
+{
+  double left_pos, left_x, c = 0.0;
+  size_t i;
+
+  if (gsl_isnan(x))
+    {
+      GSL_ERROR_VAL ("invalid input argument x", GSL_EINVAL, GSL_NAN);
+    }
+
+  if (w->n == 0)
+    return 0.0;
+
+  if (x < w->min)
+    return 0.0;
+
+  if (x >= w->max)
+    return 1.0;
+
+  sketch_compress(w);
+
+  left_pos = 0.0;
+  left_x = w->min;
+
+  for (i = 0; i < w->ncentroids; ++i)
+    {
+      const double right_pos = c + 0.5 * (w->weight[i] - 1.0);
+      const double right_x = w->mean[i];
+
+      if (x < right_x)
+        return (left_pos + (right_pos - left_pos) * (x - left_x) / (right_x - left_x)) / (w->n - 1.0);
+
+      c += w->weight[i];
+      left_pos = right_pos;
+      left_x = right_x;
+    }
+
+  return (left_pos + (w->n - 1.0 - left_pos) * (x - left_x) / (w->max - left_x)) / (w->n - 1.0);
+} /* gsl_rstat_sketch_cdf() */
+
+/*
+gsl_rstat_sketch_fwrite()
+  Write the sketch to a stream in binary format, after merging the
+buffer into the centroids. The size is (5 + 2 ncentroids) doubles,
+at most about 16 delta bytes.
+*/
+
+int
+gsl_rstat_sketch_fwrite(FILE *stream, gsl_rstat_sketch_workspace *w)
+{
+  double header[SKETCH_HEADER_SIZE];
+  size_t items;
+
+  sketch_compress(w);
+
+  header[0] = w->compression;
+  header[1] = (double) w->n;
+  header[2] = (double) w->ncentroids;
+  header[3] = w->min;
+  header[4] = w->max;
+
+  items = fwrite(header, sizeof(double), SKETCH_HEADER_SIZE, stream);
+  if (items != SKETCH_HEADER_SIZE)
+    {
+      GSL_ERROR ("fwrite failed", GSL_EFAILED);
+    }
+
+  items = fwrite(w->mean, sizeof(double), w->ncentroids, stream);
+  if (items != w->ncentroids)
+    {
+      GSL_ERROR ("fwrite failed", GSL_EFAILED);
+    }
+
+  items = fwrite(w->weight, sizeof(double), w->ncentroids, stream);
+  if (items != w->ncentroids)
+    {
+      GSL_ERROR ("fwrite failed", GSL_EFAILED);
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_sketch_fwrite() */
+
+/*
+gsl_rstat_sketch_fread()
+  Read a sketch written by gsl_rstat_sketch_fwrite() into w, replacing
+its contents. The workspace keeps its own compression parameter, and
+must have room for the centroids of the stored sketch.
+*/
+
+int
+gsl_rstat_sketch_fread(FILE *stream, gsl_rstat_sketch_workspace *w)
+{
+  double header[SKETCH_HEADER_SIZE];
+  size_t items, ncentroids;
+
+  items = fread(header, sizeof(double), SKETCH_HEADER_SIZE, stream);
+  if (items != SKETCH_HEADER_SIZE)
+    {
+      GSL_ERROR ("fread failed", GSL_EFAILED);
+    }
+
+  if (!(header[2] >= 0.0 && header[2] <= (double) w->max_centroids) ||
+      !(header[1] >= header[2]))
+    {
+      GSL_ERROR ("stored sketch does not fit in workspace", GSL_EBADLEN);
+    }
+
+  ncentroids = (size_t) header[2];
+
+  items = fread(w->mean, sizeof(double), ncentroids, stream);
+  if (items != ncentroids)
+    {
+      GSL_ERROR ("fread failed", GSL_EFAILED);
+    }
+
+  items = fread(w->weight, sizeof(double), ncentroids, stream);
+  if (items != ncentroids)
+    {
+      GSL_ERROR ("fread failed", GSL_EFAILED);
+    }
+
+  w->n = (size_t) header[1];
+  w->ncentroids = ncentroids;
+  w->nbuffer = 0;
+  w->min = header[3];
+  w->max = header[4];
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_sketch_fread() */
+
+/* merge the buffer into the centroids */
+static int
+sketch_compress(gsl_rstat_sketch_workspace *w)
+{
+  double *mean = w->work;
+  double *weight = w->work + w->max_centroids + w->buffer_size;
+  size_t i, j, n;
+
+  if (w->nbuffer == 0)
+    return GSL_SUCCESS;
+
+  /* merge the sorted buffer with the centroids */
+
+  gsl_sort(w->buffer, 1, w->nbuffer);
+
+  for (i = 0, j = 0, n = 0; i < w->ncentroids || j < w->nbuffer; ++n)
+    {
+      if (j == w->nbuffer || (i < w->ncentroids && w->mean[i] <= w->buffer[j]))
+        {
+          mean[n] = w->mean[i];
+          weight[n] = w->weight[i];
+          ++i;
+        }
+      else
+        {
+          mean[n] = w->buffer[j];
+          weight[n] = 1.0;
+          ++j;
+        }
+    }
+
+  w->nbuffer = 0;
+  w->ncentroids = sketch_merge_points(w, mean, weight, n, (double) w->n);
+
+  return GSL_SUCCESS;
+} /* sketch_compress() */
+
+static double
+sketch_k(const double q, const double delta)
+{
+  return delta / (2.0 * M_PI) * asin(2.0 * q - 1.0);
+}
+
+/* inverse of sketch_k(), for k in [-delta/4, delta/4] */
+static double
+sketch_q(const double k, const double delta)
+{
+  if (k >= 0.25 * delta)
+    return 1.0;
+
+  return 0.5 * (sin(2.0 * M_PI * k / delta) + 1.0);
+}
+
+/*
+sketch_merge_points()
+  Merge the n weighted points (mean, weight), sorted in increasing
+order of mean and with total weight 'total', into the centroids of w
+by combining neighbouring points subject to the size limit given by
+the scale function. Returns the number of centroids.
+*/
+
+static size_t
+sketch_merge_points(gsl_rstat_sketch_workspace *w, double *mean,
+                    double *weight, const size_t n, const double total)
+{
+  const double delta = w->compression;
+  double cur_mean, cur_weight, wsofar = 0.0, wlimit;
+  size_t i, m = 0;
+
+  if (n == 0)
+    return 0;
+
+  wlimit = total * sketch_q(sketch_k(0.0, delta) + 1.0, delta);
+  cur_mean = mean[0];
+  cur_weight = weight[0];
+
+  for (i = 1; i < n; ++i)
+    {
+      if (wsofar + cur_weight + weight[i] <= wlimit)
+        {
+          cur_weight += weight[i];
+          cur_mean += (mean[i] - cur_mean) * weight[i] / cur_weight;
+        }
+      else
+        {
+          w->mean[m] = cur_mean;
+          w->weight[m] = cur_weight;
+          ++m;
+
+          wsofar += cur_weight;
+          wlimit = total * sketch_q(sketch_k(wsofar / total, delta) + 1.0, delta);
+          cur_mean = mean[i];
+          cur_weight = weight[i];
+        }
+    }
+
+  w->mean[m] = cur_mean;
+  w->weight[m] = cur_weight;
+
+  return m + 1;
+} /* sketch_merge_points() */
@@ -22,8 +22,17 @@
 #include <math.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_statistics.h>
 #include <gsl/gsl_rstat.h>
 
+/* compression of the quantile sketch used for the median */
+#define RSTAT_COMPRESSION 200.0
+
+static void rstat_combine(gsl_rstat_workspace *w, const size_t n,
+                          const double min, const double max,
+                          const double mean, const double M2,
+                          const double M3, const double M4);
+
 gsl_rstat_workspace *
 gsl_rstat_alloc(void)
 {
@@ -36,11 +45,12 @@ gsl_rstat_alloc(void)
       GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
     }
 
-  w->median_workspace_p = gsl_rstat_quantile_alloc(0.5);
+  w->sketch_workspace_p = gsl_rstat_sketch_alloc(RSTAT_COMPRESSION);
 
-  if (w->median_workspace_p == 0)
+  if (w->sketch_workspace_p == 0)
     {
-      GSL_ERROR_NULL ("failed to allocate space for median workspace",
+      free(w);
+      GSL_ERROR_NULL ("failed to allocate space for quantile sketch",
                       GSL_ENOMEM);
     }
 
@@ -52,8 +62,8 @@ gsl_rstat_alloc(void)
 void
 gsl_rstat_free(gsl_rstat_workspace *w)
 {
-  if (w->median_workspace_p)
-    gsl_rstat_quantile_free(w->median_workspace_p);
+  if (w->sketch_workspace_p)
+    gsl_rstat_sketch_free(w->sketch_workspace_p);
 
   free(w);
 } /* gsl_rstat_free() */
@@ -97,11 +107,53 @@ gsl_rstat_add(const double x, gsl_rstat_workspace *w)
   w->M2 += term1;
 
   /* update median */
-  gsl_rstat_quantile_add(x, w->median_workspace_p);
+  gsl_rstat_sketch_add(x, w->sketch_workspace_p);
 
   return GSL_SUCCESS;
 } /* gsl_rstat_add() */
 
+/*
+gsl_rstat_add_array()
+  Add n data points with stride 'stride' to the running totals. The
+moments of the new data are computed in a single blocked pass by
+gsl_stats_summary and then combined with the running totals, which
+is faster than adding the points one at a time.
+*/
+
+int
+gsl_rstat_add_array(const double x[], const size_t stride, const size_t n,
+                    gsl_rstat_workspace *w)
+{
+  gsl_stats_summary_t s;
+  size_t i;
+
+  if (n == 0)
+    return GSL_SUCCESS;
+
+  gsl_stats_summary(&s, x, stride, n);
+  rstat_combine(w, s.n, s.min, s.max, s.mean, s.M2, s.M3, s.M4);
+
+  for (i = 0; i < n; ++i)
+    gsl_rstat_sketch_add(x[i * stride], w->sketch_workspace_p);
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_add_array() */
+
+/*
+gsl_rstat_merge()
+  Merge the running totals of src into w, so that w describes the
+data added to both workspaces
+*/
+
+int
+gsl_rstat_merge(gsl_rstat_workspace *w, const gsl_rstat_workspace *src)
+{
+  rstat_combine(w, src->n, src->min, src->max, src->mean,
+                src->M2, src->M3, src->M4);
+
+  return gsl_rstat_sketch_merge(w->sketch_workspace_p, src->sketch_workspace_p);
+} /* gsl_rstat_merge() */
+
 double
 gsl_rstat_min(const gsl_rstat_workspace *w)
 {
@@ -173,7 +225,7 @@ gsl_rstat_sd_mean(const gsl_rstat_workspace *w)
 double
 gsl_rstat_median(gsl_rstat_workspace *w)
 {
-  return gsl_rstat_quantile_get(w->median_workspace_p);
+  return gsl_rstat_sketch_quantile(0.5, w->sketch_workspace_p);
 }
 
 double
@@ -215,7 +267,65 @@ gsl_rstat_reset(gsl_rstat_workspace *w)
   w->M4 = 0.0;
   w->n = 0;
 
-  status = gsl_rstat_quantile_reset(w->median_workspace_p);
+  status = gsl_rstat_sketch_reset(w->sketch_workspace_p);
 
   return status;
 } /* gsl_rstat_reset() */
+
+/*
+rstat_combine()
+  Combine the totals of n data points with minimum min, maximum max,
+mean 'mean' and central moment sums M2, M3, M4 with the running totals,
+using the pairwise update formulas of
+
+[1] T. F. Chan, G. H. Golub and R. J. LeVeque, "Updating formulae and
+    a pairwise algorithm for computing sample variances", COMPSTAT 1982
+
+[2] P. Pebay, "Formulas for robust, one-pass parallel computation of
+    covariances and arbitrary-order statistical moments", Sandia
+    Report SAND2008-6212 (2008)
+*/
+
+static void
+rstat_combine(gsl_rstat_workspace *w, const size_t n,
+              const double min, const double max,
+              const double mean, const double M2,
+              const double M3, const double M4)
+{
+  double na, nb, nt, delta, delta_n;
+
+  if (n == 0)
+    return;
+
+  if (w->n == 0)
+    {
+      w->min = min;
+      w->max = max;
+      w->mean = mean;
+      w->M2 = M2;
+      w->M3 = M3;
+      w->M4 = M4;
+      w->n = n;
+      return;
+    }
+
+  if (min < w->min)
+    w->min = min;
+  if (max > w->max)
+    w->max = max;
+
+  na = (double) w->n;
+  nb = (double) n;
+  nt = na + nb;
+  delta = mean - w->mean;
+  delta_n = delta / nt;
+
+  w->M4 += M4 + delta * delta_n * delta_n * delta_n * na * nb * (na * na - na * nb + nb * nb)
+           + 6.0 * delta_n * delta_n * (na * na * M2 + nb * nb * w->M2)
+           + 4.0 * delta_n * (na * M3 - nb * w->M3);
+  w->M3 += M3 + delta * delta_n * delta_n * na * nb * (na - nb)
+           + 3.0 * delta_n * (na * M2 - nb * w->M2);
+  w->M2 += M2 + delta * delta_n * na * nb;
+  w->mean += delta_n * nb;
+  w->n += n;
+} /* rstat_combine() */
@@ -115,6 +115,172 @@ test_quantile(const double p, const double data[], const size_t n,
   gsl_rstat_quantile_free(w);
 }
 
+/* split the data into parts of unequal size, add them to separate
+   workspaces, singly or as arrays, and merge the workspaces */
+void
+test_merge(const size_t n, const double data[], const double tol)
+{
+  const size_t nparts = 5;
+  gsl_rstat_workspace *w[5];
+  double *sorted = malloc(n * sizeof(double));
+  size_t i, j, start = 0;
+
+  for (j = 0; j < nparts; ++j)
+    {
+      size_t end = (j == nparts - 1) ? n : start + (j + 1) * n / 15;
+
+      w[j] = gsl_rstat_alloc();
+
+      if (j % 2 == 0)
+        {
+          gsl_rstat_add_array(data + start, 1, end - start, w[j]);
+        }
+      else
+        {
+          for (i = start; i < end; ++i)
+            gsl_rstat_add(data[i], w[j]);
+        }
+
+      start = end;
+    }
+
+  /* merge into an empty workspace, then the rest */
+  gsl_rstat_reset(w[0]);
+  gsl_rstat_add_array(data, 1, n / 15, w[0]);
+
+  for (j = 1; j < nparts; ++j)
+    gsl_rstat_merge(w[0], w[j]);
+
+  memcpy(sorted, data, n * sizeof(double));
+  gsl_sort(sorted, 1, n);
+
+  gsl_test_int(gsl_rstat_n(w[0]), n, "merge n n=%zu", n);
+  gsl_test_rel(gsl_rstat_min(w[0]), sorted[0], tol, "merge min n=%zu", n);
+  gsl_test_rel(gsl_rstat_max(w[0]), sorted[n - 1], tol, "merge max n=%zu", n);
+  gsl_test_rel(gsl_rstat_mean(w[0]), gsl_stats_mean(data, 1, n), tol,
+               "merge mean n=%zu", n);
+  gsl_test_rel(gsl_rstat_variance(w[0]), gsl_stats_variance(data, 1, n), tol,
+               "merge variance n=%zu", n);
+  gsl_test_rel(gsl_rstat_skew(w[0]), gsl_stats_skew(data, 1, n), tol,
+               "merge skew n=%zu", n);
+  gsl_test_rel(gsl_rstat_kurtosis(w[0]), gsl_stats_kurtosis(data, 1, n), tol,
+               "merge kurtosis n=%zu", n);
+  gsl_test_abs(gsl_rstat_median(w[0]),
+               gsl_stats_median_from_sorted_data(sorted, 1, n), 1.0e-3,
+               "merge median n=%zu", n);
+
+  for (j = 0; j < nparts; ++j)
+    gsl_rstat_free(w[j]);
+
+  free(sorted);
+}
+
+/* the sketch is exact while every centroid holds a single value,
+   and otherwise has a small rank error, smallest in the tails */
+void
+test_sketch(const size_t n, const double data[], const double compression)
+{
+  const double p[] = { 0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0 };
+  const size_t np = sizeof(p) / sizeof(p[0]);
+  gsl_rstat_sketch_workspace *w = gsl_rstat_sketch_alloc(compression);
+  gsl_rstat_sketch_workspace *w2 = gsl_rstat_sketch_alloc(compression);
+  double *sorted = malloc(n * sizeof(double));
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      if (i < n / 3)
+        gsl_rstat_sketch_add(data[i], w2);
+      else
+        gsl_rstat_sketch_add(data[i], w);
+    }
+
+  gsl_rstat_sketch_merge(w, w2);
+
+  memcpy(sorted, data, n * sizeof(double));
+  gsl_sort(sorted, 1, n);
+
+  gsl_test_int(gsl_rstat_sketch_n(w), n, "sketch n n=%zu", n);
+
+  for (i = 0; i < np; ++i)
+    {
+      const double result = gsl_rstat_sketch_quantile(p[i], w);
+      const double expected = gsl_stats_quantile_from_sorted_data(sorted, 1, n, p[i]);
+
+      if (n < compression / 4)
+        {
+          gsl_test_rel(result, expected, 1.0e-12, "sketch exact n=%zu p=%g", n, p[i]);
+        }
+      else
+        {
+          /* rank of the estimate in the sorted data */
+          size_t lo = 0, hi = n;
+          double rank_err, tol = 0.25 / compression;
+
+          while (lo < hi)
+            {
+              size_t mid = lo + (hi - lo) / 2;
+              if (sorted[mid] < result)
+                lo = mid + 1;
+              else
+                hi = mid;
+            }
+
+          rank_err = fabs((double) lo / (double) n - p[i]);
+
+          if (p[i] <= 0.01 || p[i] >= 0.99)
+            tol = 0.1 / compression;
+
+          gsl_test(rank_err > tol,
+                   "sketch rank error n=%zu p=%g delta=%g (%g observed vs %g allowed)",
+                   n, p[i], compression, rank_err, tol);
+        }
+    }
+
+  /* the cdf inverts the quantile function */
+  for (i = 1; i < np - 1; ++i)
+    {
+      const double x = gsl_rstat_sketch_quantile(p[i], w);
+      const double cdf = gsl_rstat_sketch_cdf(x, w);
+
+      gsl_test_abs(cdf, p[i], 1.0e-10, "sketch cdf n=%zu p=%g delta=%g", n, p[i], compression);
+    }
+
+  gsl_test_abs(gsl_rstat_sketch_cdf(sorted[0] - 1.0, w), 0.0, 0.0, "sketch cdf below min n=%zu", n);
+  gsl_test_abs(gsl_rstat_sketch_cdf(sorted[n - 1], w), 1.0, 0.0, "sketch cdf at max n=%zu", n);
+
+  /* binary round trip, into a workspace which has items in its buffer */
+  {
+    gsl_rstat_sketch_workspace *w3 = gsl_rstat_sketch_alloc(compression);
+    FILE *f;
+
+    gsl_rstat_sketch_add(1.0, w3);
+
+    f = fopen("test.dat", "wb");
+    gsl_rstat_sketch_fwrite(f, w);
+    fclose(f);
+
+    f = fopen("test.dat", "rb");
+    gsl_rstat_sketch_fread(f, w3);
+    fclose(f);
+
+    gsl_test_int(gsl_rstat_sketch_n(w3), n, "sketch fread n n=%zu", n);
+
+    for (i = 0; i < np; ++i)
+      {
+        gsl_test_rel(gsl_rstat_sketch_quantile(p[i], w3),
+                     gsl_rstat_sketch_quantile(p[i], w), 0.0,
+                     "sketch fread n=%zu p=%g", n, p[i]);
+      }
+
+    gsl_rstat_sketch_free(w3);
+  }
+
+  gsl_rstat_sketch_free(w);
+  gsl_rstat_sketch_free(w2);
+  free(sorted);
+}
+
 int
 main()
 {
@@ -144,6 +310,9 @@ main()
 
     test_basic(5, data2, tol1);
 
+    test_merge(1000, data, tol1);
+    test_merge(100000, data, tol1);
+
     free(data);
   }
 
@@ -212,6 +381,22 @@ main()
     gsl_rstat_free(rstat_workspace_p);
   }
 
+  {
+    const size_t n = 1000000;
+    double *data = malloc(n * sizeof(double));
+    size_t i;
+
+    for (i = 0; i < n; ++i)
+      data[i] = gsl_ran_lognormal(r, 0.0, 1.0);
+
+    test_sketch(40, data, 200.0);
+    test_sketch(n, data, 100.0);
+    test_sketch(n, data, 200.0);
+    test_sketch(n, data, 1000.0);
+
+    free(data);
+  }
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
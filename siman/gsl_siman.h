@@ -77,6 +77,72 @@ gsl_siman_solve_many (const gsl_rng * r, void *x0_p, gsl_siman_Efunc_t Ef,
                       size_t element_size,
                       gsl_siman_params_t params);
 
+/* parallel tempering (replica exchange), with one chain for each
+   temperature of a ladder T[0] < T[1] < ... < T[n_chains-1] */
+
+typedef struct {
+  double T;                 /* temperature of the chain */
+  double E;                 /* energy of the current configuration */
+  double best_E;            /* lowest energy seen by the chain */
+  size_t n_accepts;         /* uphill steps accepted */
+  size_t n_rejects;         /* uphill steps rejected */
+  size_t n_eless;           /* downhill steps */
+  size_t n_swap_attempts;   /* exchanges tried with the next hotter chain */
+  size_t n_swaps;           /* exchanges accepted with the next hotter chain */
+} gsl_siman_chain_stats;
+
+typedef struct {
+  size_t n_chains;
+  size_t element_size;
+  size_t n_exchanges;       /* number of calls to gsl_siman_tempering_exchange */
+  gsl_siman_Efunc_t Ef;
+  gsl_siman_step_t take_step;
+  gsl_siman_copy_t copyfunc;
+  gsl_siman_copy_construct_t copy_constructor;
+  gsl_siman_destroy_t destructor;
+  void **x;                 /* current configuration of each chain */
+  void **new_x;             /* trial configuration of each chain */
+  void **best_x;            /* best configuration of each chain */
+  gsl_siman_chain_stats *stats;
+} gsl_siman_tempering_workspace;
+
+gsl_siman_tempering_workspace *
+gsl_siman_tempering_alloc (void *x0_p, gsl_siman_Efunc_t Ef,
+                           gsl_siman_step_t take_step,
+                           gsl_siman_copy_t copyfunc,
+                           gsl_siman_copy_construct_t copy_constructor,
+                           gsl_siman_destroy_t destructor,
+                           size_t element_size,
+                           size_t n_chains, const double T[]);
+
+void gsl_siman_tempering_free (gsl_siman_tempering_workspace * w);
+
+int gsl_siman_tempering_sweep (const gsl_rng * r,
+                               gsl_siman_tempering_workspace * w,
+                               size_t i, gsl_siman_params_t params);
+
+int gsl_siman_tempering_exchange (const gsl_rng * r,
+                                  gsl_siman_tempering_workspace * w,
+                                  gsl_siman_params_t params);
+
+double gsl_siman_tempering_best (const gsl_siman_tempering_workspace * w,
+                                 void *x_p);
+
+const gsl_siman_chain_stats *
+gsl_siman_tempering_stats (const gsl_siman_tempering_workspace * w, size_t i);
+
+int
+gsl_siman_solve_tempering (const gsl_rng * r, void *x0_p, gsl_siman_Efunc_t Ef,
+                           gsl_siman_step_t take_step,
+                           gsl_siman_print_t print_position,
+                           gsl_siman_copy_t copyfunc,
+                           gsl_siman_copy_construct_t copy_constructor,
+                           gsl_siman_destroy_t destructor,
+                           size_t element_size,
+                           size_t n_chains, const double T[], size_t n_rounds,
+                           gsl_siman_params_t params,
+                           gsl_siman_chain_stats stats[]);
+
 __END_DECLS
 
 #endif /* __GSL_SIMAN_H__ */
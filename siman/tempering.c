@@ -0,0 +1,415 @@
+/* siman/tempering.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Parallel tempering (replica exchange Monte Carlo).
+
+   A set of chains is run at the fixed temperatures of a ladder
+   T[0] < T[1] < ... < T[n-1]. Each sweep carries out iters_fixed_T
+   Metropolis steps on one chain, using only the state of that chain,
+   so the sweeps of different chains can be run concurrently by the
+   caller with one random number generator per chain. An exchange
+   step then proposes swapping the configurations of neighbouring
+   chains i and i+1, accepting the swap with probability
+
+     min(1, exp((1/(k T_i) - 1/(k T_{i+1})) (E_i - E_{i+1})))
+
+   Even and odd pairs are tried on alternate exchange steps. The hot
+   chains cross energy barriers easily and pass good configurations
+   down the ladder to the cold chains.
+
+   See: D. J. Earl and M. W. Deem, "Parallel tempering: Theory,
+   applications, and new perspectives", Phys. Chem. Chem. Phys. 7,
+   3910 (2005). */
+
+#include <config.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gsl/gsl_machine.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_siman.h>
+
+static inline void
+copy_state(void *src, void *dst, size_t size, gsl_siman_copy_t copyfunc)
+{
+  if (copyfunc) {
+    copyfunc(src, dst);
+  } else {
+    memcpy(dst, src, size);
+  }
+}
+
+static void *
+new_state (const gsl_siman_tempering_workspace * w, void *x0_p)
+{
+  void *x;
+
+  if (w->copyfunc)
+    return w->copy_constructor (x0_p);
+
+  x = malloc (w->element_size);
+
+  if (x != 0)
+    memcpy (x, x0_p, w->element_size);
+
+  return x;
+}
+
+static void
+free_state (const gsl_siman_tempering_workspace * w, void *x)
+{
+  if (x == 0)
+    return;
+
+  if (w->copyfunc)
+    w->destructor (x);
+  else
+    free (x);
+}
+
+gsl_siman_tempering_workspace *
+gsl_siman_tempering_alloc (void *x0_p, gsl_siman_Efunc_t Ef,
+                           gsl_siman_step_t take_step,
+                           gsl_siman_copy_t copyfunc,
+                           gsl_siman_copy_construct_t copy_constructor,
+                           gsl_siman_destroy_t destructor,
+                           size_t element_size,
+                           size_t n_chains, const double T[])
+{
+  gsl_siman_tempering_workspace *w;
+  double E;
+  size_t i;
+
+  if (n_chains == 0)
+    {
+      GSL_ERROR_NULL ("number of chains must be positive", GSL_EINVAL);
+    }
+
+  if (!((copyfunc != NULL && copy_constructor != NULL && destructor != NULL)
+        || (copyfunc == NULL && element_size != 0)))
+    {
+      GSL_ERROR_NULL ("either copy functions or element size must be given",
+                      GSL_EINVAL);
+    }
+
+  for (i = 0; i < n_chains; i++)
+    {
+      if (!(T[i] > 0.0))
+        {
+          GSL_ERROR_NULL ("temperatures must be positive", GSL_EINVAL);
+        }
+    }
+
+  w = (gsl_siman_tempering_workspace *) calloc (1, sizeof (gsl_siman_tempering_workspace));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->n_chains = n_chains;
+  w->element_size = element_size;
+  w->n_exchanges = 0;
+  w->Ef = Ef;
+  w->take_step = take_step;
+  w->copyfunc = copyfunc;
+  w->copy_constructor = copy_constructor;
+  w->destructor = destructor;
+
+  w->x = (void **) calloc (n_chains, sizeof (void *));
+  w->new_x = (void **) calloc (n_chains, sizeof (void *));
+  w->best_x = (void **) calloc (n_chains, sizeof (void *));
+  w->stats = (gsl_siman_chain_stats *) calloc (n_chains, sizeof (gsl_siman_chain_stats));
+
+  if (w->x == 0 || w->new_x == 0 || w->best_x == 0 || w->stats == 0)
+    {
+      gsl_siman_tempering_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for chains", GSL_ENOMEM);
+    }
+
+  E = Ef (x0_p);
+
+  for (i = 0; i < n_chains; i++)
+    {
+      w->x[i] = new_state (w, x0_p);
+      w->new_x[i] = new_state (w, x0_p);
+      w->best_x[i] = new_state (w, x0_p);
+
+      if (w->x[i] == 0 || w->new_x[i] == 0 || w->best_x[i] == 0)
+        {
+          gsl_siman_tempering_free (w);
+          GSL_ERROR_NULL ("failed to allocate space for configurations",
+                          GSL_ENOMEM);
+        }
+
+      w->stats[i].T = T[i];
+      w->stats[i].E = E;
+      w->stats[i].best_E = E;
+    }
+
+  return w;
+}
+
+void
+gsl_siman_tempering_free (gsl_siman_tempering_workspace * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < w->n_chains; i++)
+    {
+      if (w->x)
+        free_state (w, w->x[i]);
+      if (w->new_x)
+        free_state (w, w->new_x[i]);
+      if (w->best_x)
+        free_state (w, w->best_x[i]);
+    }
+
+  free (w->x);
+  free (w->new_x);
+  free (w->best_x);
+  free (w->stats);
+  free (w);
+}
+
+/* carry out params.iters_fixed_T Metropolis steps on chain i at its
+   own temperature */
+
+int
+gsl_siman_tempering_sweep (const gsl_rng * r,
+                           gsl_siman_tempering_workspace * w,
+                           size_t i, gsl_siman_params_t params)
+{
+  gsl_siman_chain_stats *s;
+  void *x, *new_x, *best_x;
+  int n;
+
+  if (i >= w->n_chains)
+    {
+      GSL_ERROR ("chain index out of range", GSL_EINVAL);
+    }
+
+  s = &w->stats[i];
+  x = w->x[i];
+  new_x = w->new_x[i];
+  best_x = w->best_x[i];
+
+  for (n = 0; n < params.iters_fixed_T; ++n)
+    {
+      double new_E;
+
+      copy_state (x, new_x, w->element_size, w->copyfunc);
+
+      w->take_step (r, new_x, params.step_size);
+      new_E = w->Ef (new_x);
+
+      if (new_E < s->best_E)
+        {
+          copy_state (new_x, best_x, w->element_size, w->copyfunc);
+          s->best_E = new_E;
+        }
+
+      if (new_E < s->E)
+        {
+          ++s->n_eless;
+        }
+      else
+        {
+          double a = -(new_E - s->E) / (params.k * s->T);
+
+          /* avoid underflow errors for large uphill steps */
+          if (a >= GSL_LOG_DBL_MIN && gsl_rng_uniform (r) < exp (a))
+            {
+              ++s->n_accepts;
+            }
+          else
+            {
+              ++s->n_rejects;
+              continue;
+            }
+        }
+
+      /* swap the trial and current configurations */
+      w->x[i] = new_x;
+      w->new_x[i] = x;
+      x = w->x[i];
+      new_x = w->new_x[i];
+      s->E = new_E;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* propose exchanges of configurations between neighbouring chains,
+   using the pairs (0,1), (2,3), ... and (1,2), (3,4), ... on
+   alternate calls */
+
+int
+gsl_siman_tempering_exchange (const gsl_rng * r,
+                              gsl_siman_tempering_workspace * w,
+                              gsl_siman_params_t params)
+{
+  size_t i = w->n_exchanges % 2;
+
+  for (; i + 1 < w->n_chains; i += 2)
+    {
+      gsl_siman_chain_stats *a = &w->stats[i];
+      gsl_siman_chain_stats *b = &w->stats[i + 1];
+      double delta = (1.0 / a->T - 1.0 / b->T) * (a->E - b->E) / params.k;
+
+      ++a->n_swap_attempts;
+
+      if (delta >= 0.0
+          || (delta >= GSL_LOG_DBL_MIN && gsl_rng_uniform (r) < exp (delta)))
+        {
+          void *tx = w->x[i];
+          double tE = a->E;
+
+          w->x[i] = w->x[i + 1];
+          w->x[i + 1] = tx;
+          a->E = b->E;
+          b->E = tE;
+
+          ++a->n_swaps;
+        }
+    }
+
+  w->n_exchanges++;
+
+  return GSL_SUCCESS;
+}
+
+/* return the lowest energy found by any chain, and copy the
+   corresponding configuration into x_p if it is not null */
+
+double
+gsl_siman_tempering_best (const gsl_siman_tempering_workspace * w, void *x_p)
+{
+  size_t i, imin = 0;
+
+  for (i = 1; i < w->n_chains; i++)
+    {
+      if (w->stats[i].best_E < w->stats[imin].best_E)
+        imin = i;
+    }
+
+  if (x_p)
+    copy_state (w->best_x[imin], x_p, w->element_size, w->copyfunc);
+
+  return w->stats[imin].best_E;
+}
+
+const gsl_siman_chain_stats *
+gsl_siman_tempering_stats (const gsl_siman_tempering_workspace * w, size_t i)
+{
+  if (i >= w->n_chains)
+    {
+      GSL_ERROR_NULL ("chain index out of range", GSL_EINVAL);
+    }
+
+  return &w->stats[i];
+}
+
+/* run n_rounds of sweeps over all chains followed by an exchange
+   step. If T is null a geometric ladder from params.t_min to
+   params.t_initial is used. */
+
+int
+gsl_siman_solve_tempering (const gsl_rng * r, void *x0_p, gsl_siman_Efunc_t Ef,
+                           gsl_siman_step_t take_step,
+                           gsl_siman_print_t print_position,
+                           gsl_siman_copy_t copyfunc,
+                           gsl_siman_copy_construct_t copy_constructor,
+                           gsl_siman_destroy_t destructor,
+                           size_t element_size,
+                           size_t n_chains, const double T[], size_t n_rounds,
+                           gsl_siman_params_t params,
+                           gsl_siman_chain_stats stats[])
+{
+  gsl_siman_tempering_workspace *w;
+  double *ladder = 0;
+  size_t i, n;
+
+  if (n_chains == 0)
+    {
+      GSL_ERROR ("number of chains must be positive", GSL_EINVAL);
+    }
+
+  if (T == NULL)
+    {
+      ladder = (double *) malloc (n_chains * sizeof (double));
+
+      if (ladder == 0)
+        {
+          GSL_ERROR ("failed to allocate space for ladder", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < n_chains; i++)
+        {
+          double f = (n_chains > 1) ? (double) i / (double) (n_chains - 1) : 0.0;
+          ladder[i] = params.t_min * pow (params.t_initial / params.t_min, f);
+        }
+
+      T = ladder;
+    }
+
+  w = gsl_siman_tempering_alloc (x0_p, Ef, take_step, copyfunc,
+                                 copy_constructor, destructor, element_size,
+                                 n_chains, T);
+  free (ladder);
+
+  if (w == 0)
+    {
+      GSL_ERROR ("failed to allocate tempering workspace", GSL_ENOMEM);
+    }
+
+  if (print_position) {
+    printf ("#-round   coldest-T     position   energy\n");
+  }
+
+  for (n = 0; n < n_rounds; n++)
+    {
+      for (i = 0; i < n_chains; i++)
+        gsl_siman_tempering_sweep (r, w, i, params);
+
+      gsl_siman_tempering_exchange (r, w, params);
+
+      if (print_position) {
+        printf ("%5d  %12g", (int) n, w->stats[0].T);
+        print_position (w->x[0]);
+        printf ("  %12g  %12g\n", w->stats[0].E,
+                gsl_siman_tempering_best (w, NULL));
+      }
+    }
+
+  gsl_siman_tempering_best (w, x0_p);
+
+  if (stats)
+    {
+      for (i = 0; i < n_chains; i++)
+        stats[i] = w->stats[i];
+    }
+
+  gsl_siman_tempering_free (w);
+
+  return GSL_SUCCESS;
+}
@@ -78,6 +78,145 @@ void P1(void *xp)
   printf(" %12g ", *((double *) xp));
 }
 
+/* a tilted double well, with the global minimum at x = -1.0355787
+   and a local minimum near x = +1 separated by a barrier of height 1 */
+
+double E2(void *xp);
+void test_tempering (void);
+
+double E2(void *xp)
+{
+  double x = * ((double *) xp);
+
+  return square(x * x - 1) + 0.3 * x;
+}
+
+#define N_CHAINS 6
+#define N_ROUNDS 400
+
+void
+test_tempering (void)
+{
+  const double x_min = -1.035578714088854;
+  const double T[N_CHAINS] = { 0.005, 0.02, 0.06, 0.15, 0.4, 1.0 };
+  gsl_siman_params_t tparams = {0, 100, 0.5, 1.0, 1.0, 1.0, 0.005};
+  gsl_siman_chain_stats stats[N_CHAINS];
+  gsl_siman_tempering_workspace *w1, *w2;
+  gsl_rng *r[N_CHAINS], *rx;
+  double x, y, E_x, E_y;
+  size_t i, n;
+  int status;
+
+  for (i = 0; i < N_CHAINS; i++)
+    {
+      r[i] = gsl_rng_alloc (gsl_rng_philox4x32);
+      gsl_rng_set_stream (r[i], 1, i);
+    }
+
+  rx = gsl_rng_alloc (gsl_rng_philox4x32);
+
+  /* start in the false minimum, which the coldest chain cannot leave
+     on its own */
+
+  x = 1.0;
+  status = gsl_siman_solve_tempering (rx, &x, E2, S1, NULL, NULL, NULL, NULL,
+                                      sizeof (double), N_CHAINS, T, N_ROUNDS,
+                                      tparams, stats);
+  gsl_test (status, "tempering, status");
+  gsl_test_rel (x, x_min, 1e-2, "tempering, double well, x0=1");
+
+  for (i = 0; i < N_CHAINS; i++)
+    {
+      size_t n_steps = stats[i].n_accepts + stats[i].n_rejects + stats[i].n_eless;
+      gsl_test_int ((int) n_steps, N_ROUNDS * 100, "tempering, chain %d steps", (int) i);
+      gsl_test_rel (stats[i].T, T[i], 1e-15, "tempering, chain %d temperature", (int) i);
+      gsl_test (stats[i].best_E > stats[i].E, "tempering, chain %d best_E <= E", (int) i);
+
+      if (i + 1 < N_CHAINS)
+        {
+          size_t expected = (i % 2 == 0) ? (N_ROUNDS + 1) / 2 : N_ROUNDS / 2;
+          gsl_test_int ((int) stats[i].n_swap_attempts, (int) expected,
+                        "tempering, chain %d swap attempts", (int) i);
+          gsl_test (stats[i].n_swaps == 0 || stats[i].n_swaps > stats[i].n_swap_attempts,
+                    "tempering, chain %d swaps accepted", (int) i);
+        }
+      else
+        {
+          gsl_test_int ((int) stats[i].n_swap_attempts, 0,
+                        "tempering, hottest chain swap attempts");
+        }
+    }
+
+  /* the default ladder runs from t_min to t_initial */
+
+  x = 1.0;
+  status = gsl_siman_solve_tempering (rx, &x, E2, S1, NULL, NULL, NULL, NULL,
+                                      sizeof (double), N_CHAINS, NULL, N_ROUNDS,
+                                      tparams, stats);
+  gsl_test (status, "tempering, default ladder status");
+  gsl_test_rel (stats[0].T, tparams.t_min, 1e-15, "tempering, default ladder T[0]");
+  gsl_test_rel (stats[N_CHAINS - 1].T, tparams.t_initial, 1e-15,
+                "tempering, default ladder T[n-1]");
+  gsl_test_rel (x, x_min, 1e-2, "tempering, default ladder, x0=1");
+
+  /* sweeps use only the state of their own chain, so with one
+     generator per chain the order of the sweeps does not matter */
+
+  x = 1.0;
+  w1 = gsl_siman_tempering_alloc (&x, E2, S1, NULL, NULL, NULL,
+                                  sizeof (double), N_CHAINS, T);
+  w2 = gsl_siman_tempering_alloc (&x, E2, S1, NULL, NULL, NULL,
+                                  sizeof (double), N_CHAINS, T);
+
+  for (i = 0; i < N_CHAINS; i++)
+    gsl_rng_set_stream (r[i], 2, i);
+
+  gsl_rng_set (rx, 3);
+
+  for (n = 0; n < 50; n++)
+    {
+      for (i = 0; i < N_CHAINS; i++)
+        gsl_siman_tempering_sweep (r[i], w1, i, tparams);
+
+      gsl_siman_tempering_exchange (rx, w1, tparams);
+    }
+
+  for (i = 0; i < N_CHAINS; i++)
+    gsl_rng_set_stream (r[i], 2, i);
+
+  gsl_rng_set (rx, 3);
+
+  for (n = 0; n < 50; n++)
+    {
+      for (i = N_CHAINS; i-- > 0;)
+        gsl_siman_tempering_sweep (r[i], w2, i, tparams);
+
+      gsl_siman_tempering_exchange (rx, w2, tparams);
+    }
+
+  E_x = gsl_siman_tempering_best (w1, &x);
+  E_y = gsl_siman_tempering_best (w2, &y);
+  gsl_test_rel (E_y, E_x, 0.0, "tempering, reordered sweeps, best energy");
+  gsl_test_rel (y, x, 0.0, "tempering, reordered sweeps, best position");
+
+  for (i = 0; i < N_CHAINS; i++)
+    {
+      const gsl_siman_chain_stats *s1 = gsl_siman_tempering_stats (w1, i);
+      const gsl_siman_chain_stats *s2 = gsl_siman_tempering_stats (w2, i);
+      gsl_test_rel (s2->E, s1->E, 0.0, "tempering, reordered sweeps, chain %d energy", (int) i);
+      gsl_test_int ((int) s2->n_swaps, (int) s1->n_swaps,
+                    "tempering, reordered sweeps, chain %d swaps", (int) i);
+    }
+
+  gsl_siman_tempering_free (w1);
+  gsl_siman_tempering_free (w2);
+
+  for (i = 0; i < N_CHAINS; i++)
+    gsl_rng_free (r[i]);
+
+  gsl_rng_free (rx);
+}
+
 int main(void)
 {
   double x_min = 1.36312999455315182 ;
@@ -118,6 +257,8 @@ int main(void)
                   sizeof(double), params);
   gsl_test_rel(x, x_min, 1e-3, "f(x)= exp(-(x-1)^2) sin(8x), x0=0.4") ;
 
+  test_tempering ();
+
   gsl_rng_free(r);
   exit (gsl_test_summary ());
 
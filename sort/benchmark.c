@@ -0,0 +1,243 @@
+/* sort/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Timing of gsl_sort for doubles and ints with unit stride (radix
+   sort) and stride 2 (introsort), compared with the generic heap sort
+   gsl_heapsort, over a range of sizes and input distributions.
+
+   The second table times the index sort, and the work of a parallel
+   sort split into T chunks which are sorted independently and then
+   merged pairwise with gsl_sort_merge in log2(T) rounds. The chunks
+   are processed one after another here; the estimated parallel time
+   is the slowest chunk plus the slowest merge of each round. */
+
+#include <config.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_heapsort.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_sort_int.h>
+
+#define NPAR 10000000
+
+#define NMAX 10000000
+
+enum { RANDOM, SORTED, REVERSED, FEW_UNIQUE, NDIST };
+
+static const char *dist_name[NDIST] = { "random", "sorted", "reversed", "few-unique" };
+
+static unsigned long int seed = 1;
+
+static double
+urand (void)
+{
+  seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+  return seed / 2147483648.0;
+}
+
+static void
+fill (double *x, size_t n, size_t stride, int dist)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      double v;
+
+      switch (dist)
+        {
+        case SORTED:
+          v = (double) i;
+          break;
+        case REVERSED:
+          v = (double) (n - i);
+          break;
+        case FEW_UNIQUE:
+          v = (double) (int) (16 * urand ());
+          break;
+        default:
+          v = 2 * urand () - 1;
+        }
+
+      x[i * stride] = v;
+    }
+}
+
+static int
+compare_doubles (const void *a, const void *b)
+{
+  const double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+/* returns the rate in million elements per second */
+
+static double
+time_sort (double *x, int *k, size_t n, size_t stride, int dist, int method)
+{
+  size_t i, count = 0;
+  clock_t start, end, elapsed = 0;
+
+  do
+    {
+      fill (x, n, stride, dist);
+
+      if (k)
+        {
+          for (i = 0; i < n; i++)
+            {
+              double v = x[i * stride];
+              k[i * stride] = (int) ((dist == RANDOM) ? v * 1e9 : v);
+            }
+        }
+
+      start = clock ();
+
+      if (method == 0 && k)
+        gsl_sort_int (k, stride, n);
+      else if (method == 0)
+        gsl_sort (x, stride, n);
+      else
+        gsl_heapsort (x, n, sizeof (double), compare_doubles);
+
+      end = clock ();
+      elapsed += end - start;
+      count += n;
+    }
+  while (elapsed < CLOCKS_PER_SEC / 5);
+
+  return count / (elapsed / (double) CLOCKS_PER_SEC) / 1e6;
+}
+
+static double
+seconds (clock_t start, clock_t end)
+{
+  return (end - start) / (double) CLOCKS_PER_SEC;
+}
+
+static void
+time_index (double *x, size_t *p, size_t n)
+{
+  clock_t start;
+  double t_merge, t_heap;
+
+  fill (x, n, 1, RANDOM);
+  start = clock ();
+  gsl_sort_index (p, x, 1, n);
+  t_merge = seconds (start, clock ());
+
+  start = clock ();
+  gsl_heapsort_index (p, x, n, sizeof (double), compare_doubles);
+  t_heap = seconds (start, clock ());
+
+  printf ("# index sort of %lu random doubles: gsl_sort_index %.3f s, "
+          "gsl_heapsort_index %.3f s\n", (unsigned long) n, t_merge, t_heap);
+}
+
+static void
+time_chunks (double *x, size_t n, size_t nchunk)
+{
+  const size_t len = (n + nchunk - 1) / nchunk;
+  double t_total = 0, t_max = 0, t_par;
+  size_t c, w;
+  clock_t start;
+
+  fill (x, n, 1, RANDOM);
+
+  for (c = 0; c < n; c += len)
+    {
+      double t;
+      start = clock ();
+      gsl_sort (x + c, 1, (c + len < n) ? len : n - c);
+      t = seconds (start, clock ());
+      t_total += t;
+      if (t > t_max)
+        t_max = t;
+    }
+
+  t_par = t_max;
+
+  for (w = len; w < n; w *= 2)
+    {
+      double t_round = 0;
+
+      for (c = 0; c + w < n; c += 2 * w)
+        {
+          double t;
+          start = clock ();
+          gsl_sort_merge (x + c, 1, w, (c + 2 * w < n) ? 2 * w : n - c);
+          t = seconds (start, clock ());
+          t_total += t;
+          if (t > t_round)
+            t_round = t;
+        }
+
+      t_par += t_round;
+    }
+
+  printf ("%10lu %12.3f %12.3f\n", (unsigned long) nchunk, t_total, t_par);
+}
+
+int
+main (void)
+{
+  double *x = (double *) malloc (2 * NMAX * sizeof (double));
+  int *k = (int *) malloc (2 * NMAX * sizeof (int));
+  size_t n;
+  int dist;
+
+  printf ("# rates in million elements/sec\n");
+  printf ("%10s %-10s %12s %12s %12s %12s %12s\n", "n", "input",
+          "double s=1", "double s=2", "int s=1", "int s=2", "gsl_heapsort");
+
+  for (n = 1000; n <= NMAX; n *= 10)
+    {
+      for (dist = 0; dist < NDIST; dist++)
+        {
+          printf ("%10lu %-10s %12.2f %12.2f %12.2f %12.2f %12.2f\n",
+                  (unsigned long) n, dist_name[dist],
+                  time_sort (x, 0, n, 1, dist, 0),
+                  time_sort (x, 0, n, 2, dist, 0),
+                  time_sort (x, k, n, 1, dist, 0),
+                  time_sort (x, k, n, 2, dist, 0),
+                  time_sort (x, 0, n, 1, dist, 1));
+          fflush (stdout);
+        }
+    }
+
+  free (x);
+  free (k);
+
+  x = (double *) malloc (NPAR * sizeof (double));
+
+  {
+    size_t *p = (size_t *) malloc (NPAR * sizeof (size_t));
+    time_index (x, p, NPAR);
+    free (p);
+  }
+
+  printf ("# sort of %d random doubles in chunks followed by merging\n", NPAR);
+  printf ("%10s %12s %12s\n", "chunks", "total (s)", "parallel (s)");
+
+  for (n = 1; n <= 64; n *= 2)
+    time_chunks (x, NPAR, n);
+
+  free (x);
+
+  return 0;
+}
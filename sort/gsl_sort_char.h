@@ -39,6 +39,11 @@ __BEGIN_DECLS
 void gsl_sort_char (char * data, const size_t stride, const size_t n);
 void gsl_sort2_char (char * data1, const size_t stride1, char * data2, const size_t stride2, const size_t n);
 void gsl_sort_char_index (size_t * p, const char * data, const size_t stride, const size_t n);
+int gsl_sort_char_index_stable (size_t * p, const char * data, const size_t stride, const size_t n);
+
+int gsl_sort_char_merge (char * data, const size_t stride, const size_t n1, const size_t n);
+int gsl_sort2_char_merge (char * data1, const size_t stride1, char * data2, const size_t stride2, const size_t n1, const size_t n);
+int gsl_sort_char_index_merge (size_t * p, const char * data, const size_t stride, const size_t n1, const size_t n);
 
 int gsl_sort_char_smallest (char * dest, const size_t k, const char * src, const size_t stride, const size_t n);
 int gsl_sort_char_smallest_index (size_t * p, const size_t k, const char * src, const size_t stride, const size_t n);
@@ -39,6 +39,11 @@ __BEGIN_DECLS
 void gsl_sort (double * data, const size_t stride, const size_t n);
 void gsl_sort2 (double * data1, const size_t stride1, double * data2, const size_t stride2, const size_t n);
 void gsl_sort_index (size_t * p, const double * data, const size_t stride, const size_t n);
+int gsl_sort_index_stable (size_t * p, const double * data, const size_t stride, const size_t n);
+
+int gsl_sort_merge (double * data, const size_t stride, const size_t n1, const size_t n);
+int gsl_sort2_merge (double * data1, const size_t stride1, double * data2, const size_t stride2, const size_t n1, const size_t n);
+int gsl_sort_index_merge (size_t * p, const double * data, const size_t stride, const size_t n1, const size_t n);
 
 int gsl_sort_smallest (double * dest, const size_t k, const double * src, const size_t stride, const size_t n);
 int gsl_sort_smallest_index (size_t * p, const size_t k, const double * src, const size_t stride, const size_t n);
@@ -39,6 +39,11 @@ __BEGIN_DECLS
 void gsl_sort_long_double (long double * data, const size_t stride, const size_t n);
 void gsl_sort2_long_double (long double * data1, const size_t stride1, long double * data2, const size_t stride2, const size_t n);
 void gsl_sort_long_double_index (size_t * p, const long double * data, const size_t stride, const size_t n);
+int gsl_sort_long_double_index_stable (size_t * p, const long double * data, const size_t stride, const size_t n);
+
+int gsl_sort_long_double_merge (long double * data, const size_t stride, const size_t n1, const size_t n);
+int gsl_sort2_long_double_merge (long double * data1, const size_t stride1, long double * data2, const size_t stride2, const size_t n1, const size_t n);
+int gsl_sort_long_double_index_merge (size_t * p, const long double * data, const size_t stride, const size_t n1, const size_t n);
 
 int gsl_sort_long_double_smallest (long double * dest, const size_t k, const long double * src, const size_t stride, const size_t n);
 int gsl_sort_long_double_smallest_index (size_t * p, const size_t k, const long double * src, const size_t stride, const size_t n);
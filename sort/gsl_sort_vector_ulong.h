@@ -40,6 +40,7 @@ __BEGIN_DECLS
 void gsl_sort_vector_ulong (gsl_vector_ulong * v);
 void gsl_sort_vector2_ulong (gsl_vector_ulong * v1, gsl_vector_ulong * v2);
 int gsl_sort_vector_ulong_index (gsl_permutation * p, const gsl_vector_ulong * v);
+int gsl_sort_vector_ulong_index_stable (gsl_permutation * p, const gsl_vector_ulong * v);
 
 int gsl_sort_vector_ulong_smallest (unsigned long * dest, const size_t k, const gsl_vector_ulong * v);
 int gsl_sort_vector_ulong_largest (unsigned long * dest, const size_t k, const gsl_vector_ulong * v);
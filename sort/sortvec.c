@@ -18,11 +18,79 @@
  */
 
 #include <config.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_sort_vector.h>
 
+/* sign bit of a floating point number, which distinguishes -0 from +0 */
+#ifdef signbit
+#define SORT_SIGNBIT(x) signbit (x)
+#else
+#define SORT_SIGNBIT(x) ((x) < 0 || 1 / (x) < 0)
+#endif
+
+/* ranges up to this size are sorted by insertion sort */
+#define SORT_INSERTION_MAX 16
+
+/* unit stride arrays of at least this size are radix sorted */
+#define SORT_RADIX_MIN 256
+
+/* introsort switches to heap sort after 2 floor(log2(n)) levels */
+
+static size_t
+sort_depth_limit (size_t n)
+{
+  size_t depth = 0;
+
+  while (n > 1)
+    {
+      n >>= 1;
+      depth += 2;
+    }
+
+  return depth;
+}
+
+/* offset of the k-th least significant byte in an object of the given
+   size, for the byte order of the machine */
+
+static size_t
+sort_byte_offset (const size_t k, const size_t size)
+{
+  const unsigned int one = 1;
+
+  if (*(const unsigned char *) &one == 1)
+    return k;                   /* little endian */
+  else
+    return size - 1 - k;
+}
+
+/* check that floating point numbers of the given size are IEEE with
+   the same byte order as the integers */
+
+static int
+sort_ieee_byte_order (const size_t size)
+{
+  if (size == sizeof (double) && size == 8)
+    {
+      const double x = -1.0;    /* 0xBFF0000000000000 */
+      const unsigned char *b = (const unsigned char *) &x;
+      return b[sort_byte_offset (7, 8)] == 0xBF && b[sort_byte_offset (6, 8)] == 0xF0;
+    }
+  else if (size == sizeof (float) && size == 4)
+    {
+      const float x = -1.0f;    /* 0xBF800000 */
+      const unsigned char *b = (const unsigned char *) &x;
+      return b[sort_byte_offset (3, 4)] == 0xBF && b[sort_byte_offset (2, 4)] == 0x80;
+    }
+
+  return 0;
+}
+
 #define BASE_LONG_DOUBLE
 #include "templates_on.h"
 #include "sortvec_source.c"
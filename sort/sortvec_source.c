@@ -2,6 +2,9 @@
  * Implement Heap sort -- direct and indirect sorting
  * Based on descriptions in Sedgewick "Algorithms in C"
  *
+ * Introsort and LSD radix sort added for the direct sorts; heap sort
+ * is kept as the fallback of introsort.
+ *
  * Copyright (C) 1999  Thomas Walter
  *
  * 18 February 2000: Modified for GSL by Brian Gough
@@ -17,6 +20,16 @@
  * for more details.
  */
 
+/* comparison of keys for all the sorting methods. For floating point
+   keys -0 is less than +0, which is the order of the radix sort. NaNs
+   are moved out of the way before sorting. */
+
+#if defined(FP)
+#define SORT_LESS(a,b) ((a) < (b) || ((a) == 0 && (b) == 0 && SORT_SIGNBIT (a) && !SORT_SIGNBIT (b)))
+#else
+#define SORT_LESS(a,b) ((a) < (b))
+#endif
+
 static inline void FUNCTION (my, downheap) (BASE * data, const size_t stride, const size_t N, size_t k);
 static inline void FUNCTION (my, downheap2) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t N, size_t k);
 
@@ -29,12 +42,12 @@ FUNCTION (my, downheap) (BASE * data, const size_t stride, const size_t N, size_
     {
       size_t j = 2 * k;
 
-      if (j < N && data[j * stride] < data[(j + 1) * stride])
+      if (j < N && SORT_LESS (data[j * stride], data[(j + 1) * stride]))
         {
           j++;
         }
 
-      if (!(v < data[j * stride]))  /* avoid infinite loop if nan */
+      if (!SORT_LESS (v, data[j * stride]))  /* avoid infinite loop if nan */
         {
           break;
         }
@@ -57,12 +70,12 @@ FUNCTION (my, downheap2) (BASE * data1, const size_t stride1, BASE * data2, cons
     {
       size_t j = 2 * k;
 
-      if (j < N && data1[j * stride1] < data1[(j + 1) * stride1])
+      if (j < N && SORT_LESS (data1[j * stride1], data1[(j + 1) * stride1]))
         {
           j++;
         }
 
-      if (!(v1 < data1[j * stride1]))  /* avoid infinite loop if nan */
+      if (!SORT_LESS (v1, data1[j * stride1]))  /* avoid infinite loop if nan */
         {
           break;
         }
@@ -77,8 +90,8 @@ FUNCTION (my, downheap2) (BASE * data1, const size_t stride1, BASE * data2, cons
   data2[k * stride2] = v2;
 }
 
-void
-TYPE (gsl_sort) (BASE * data, const size_t stride, const size_t n)
+static void
+FUNCTION (my, heapsort) (BASE * data, const size_t stride, const size_t n)
 {
   size_t N;
   size_t k;
@@ -116,14 +129,8 @@ TYPE (gsl_sort) (BASE * data, const size_t stride, const size_t n)
     }
 }
 
-void
-TYPE (gsl_sort_vector) (TYPE (gsl_vector) * v)
-{
-  TYPE (gsl_sort) (v->data, v->stride, v->size) ;
-}
-
-void
-TYPE (gsl_sort2) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n)
+static void
+FUNCTION (my, heapsort2) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n)
 {
   size_t N;
   size_t k;
@@ -167,8 +174,456 @@ TYPE (gsl_sort2) (BASE * data1, const size_t stride1, BASE * data2, const size_t
     }
 }
 
+static inline void
+FUNCTION (my, swap) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t i, const size_t j)
+{
+  BASE tmp = data1[i * stride1];
+  data1[i * stride1] = data1[j * stride1];
+  data1[j * stride1] = tmp;
+
+  if (data2)
+    {
+      tmp = data2[i * stride2];
+      data2[i * stride2] = data2[j * stride2];
+      data2[j * stride2] = tmp;
+    }
+}
+
+/* move any NaNs to the end of the array, returning the number of
+   other elements. NaNs compare false with everything, which would
+   break the sentinels of the partitioning loops below. */
+
+static size_t
+FUNCTION (my, nan_partition) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n)
+{
+#if defined(FP)
+  size_t i = 0, m = n;
+
+  while (i < m)
+    {
+      BASE x = data1[i * stride1];
+
+      if (x != x)
+        {
+          m--;
+          FUNCTION (my, swap) (data1, stride1, data2, stride2, i, m);
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  return m;
+#else
+  (void) data1; (void) stride1; (void) data2; (void) stride2;
+  return n;
+#endif
+}
+
+static void
+FUNCTION (my, insertion) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t lo, const size_t hi)
+{
+  size_t i;
+
+  for (i = lo + 1; i <= hi; i++)
+    {
+      BASE v1 = data1[i * stride1];
+      BASE v2 = data2 ? data2[i * stride2] : v1;
+      size_t j = i;
+
+      while (j > lo && SORT_LESS (v1, data1[(j - 1) * stride1]))
+        {
+          data1[j * stride1] = data1[(j - 1) * stride1];
+          if (data2)
+            data2[j * stride2] = data2[(j - 1) * stride2];
+          j--;
+        }
+
+      data1[j * stride1] = v1;
+      if (data2)
+        data2[j * stride2] = v2;
+    }
+}
+
+/* Introsort: quicksort with a median-of-three pivot, switching to
+   insertion sort for small ranges and to heap sort when the recursion
+   depth exceeds the limit, so the worst case remains O(n log n). The
+   smaller partition is sorted recursively and the larger one
+   iteratively, so the stack depth is O(log n). Based on D. R. Musser,
+   "Introspective sorting and selection algorithms", Software Practice
+   and Experience 27, 983 (1997). */
+
+static void
+FUNCTION (my, introsort) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, size_t lo, size_t hi, size_t depth)
+{
+  while (hi - lo >= SORT_INSERTION_MAX)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      size_t i = lo, j = hi;
+      BASE pivot;
+
+      if (depth == 0)
+        {
+          if (data2)
+            FUNCTION (my, heapsort2) (data1 + lo * stride1, stride1, data2 + lo * stride2, stride2, hi - lo + 1);
+          else
+            FUNCTION (my, heapsort) (data1 + lo * stride1, stride1, hi - lo + 1);
+          return;
+        }
+
+      depth--;
+
+      /* order data[lo] <= data[mid] <= data[hi], which act as
+         sentinels for the scans */
+
+      if (SORT_LESS (data1[mid * stride1], data1[lo * stride1]))
+        FUNCTION (my, swap) (data1, stride1, data2, stride2, lo, mid);
+      if (SORT_LESS (data1[hi * stride1], data1[mid * stride1]))
+        {
+          FUNCTION (my, swap) (data1, stride1, data2, stride2, mid, hi);
+          if (SORT_LESS (data1[mid * stride1], data1[lo * stride1]))
+            FUNCTION (my, swap) (data1, stride1, data2, stride2, lo, mid);
+        }
+
+      pivot = data1[mid * stride1];
+
+      while (i <= j)
+        {
+          while (SORT_LESS (data1[i * stride1], pivot))
+            i++;
+
+          while (SORT_LESS (pivot, data1[j * stride1]))
+            j--;
+
+          if (i <= j)
+            {
+              FUNCTION (my, swap) (data1, stride1, data2, stride2, i, j);
+              i++;
+              j--;
+            }
+        }
+
+      /* now data[lo..j] <= pivot <= data[i..hi], with lo <= j and i <= hi */
+
+      if (j - lo < hi - i)
+        {
+          FUNCTION (my, introsort) (data1, stride1, data2, stride2, lo, j, depth);
+          lo = i;
+        }
+      else
+        {
+          FUNCTION (my, introsort) (data1, stride1, data2, stride2, i, hi, depth);
+          hi = j;
+        }
+    }
+
+  FUNCTION (my, insertion) (data1, stride1, data2, stride2, lo, hi);
+}
+
+/* LSD radix sort for unit stride data, one byte per pass. The bytes
+   are mapped so that their unsigned order is the numerical order of
+   the keys: the sign bit of signed integers is flipped, and for IEEE
+   floating point numbers the sign bit is flipped for positive numbers
+   and all bits for negative numbers, which places -0 before +0.
+   Passes over bytes which are the same for all keys are skipped. The
+   sort is stable, so equal keys keep the order of the second array. */
+
+#if defined(FP) && defined(BASE_LONG_DOUBLE)
+#define RADIX_KEY 0             /* not a portable format */
+#elif defined(FP)
+#define RADIX_KEY 2
+#else
+#define RADIX_KEY 1
+#endif
+
+#if defined(UNSIGNED)
+#define RADIX_SIGNED 0
+#else
+#define RADIX_SIGNED 1          /* the top byte carries a sign bit */
+#endif
+
+#if RADIX_KEY > 0
+static inline unsigned int
+FUNCTION (my, radix_digit) (const BASE * x, const size_t k, const size_t * offset)
+{
+  const unsigned char *b = (const unsigned char *) x;
+#if RADIX_SIGNED
+  const size_t top = sizeof (BASE) - 1;
+  unsigned int d = b[offset[k]];
+
+#if RADIX_KEY == 2
+  if (b[offset[top]] & 0x80)
+    return d ^ 0xFF;
+#endif
+
+  return (k == top) ? d ^ 0x80 : d;
+#else
+  return b[offset[k]];
+#endif
+}
+#endif
+
+static int
+FUNCTION (my, radixsort) (BASE * data1, BASE * data2, const size_t n)
+{
+#if RADIX_KEY > 0
+  size_t count[sizeof (BASE)][256];
+  size_t offset[sizeof (BASE)];
+  BASE *buf1, *buf2 = 0, *src1, *src2, *dst1, *dst2;
+  size_t i, k;
+
+#if RADIX_KEY == 2
+  if (!sort_ieee_byte_order (sizeof (BASE)))
+    return GSL_EUNSUP;
+#endif
+
+  buf1 = (BASE *) malloc (n * sizeof (BASE));
+
+  if (data2)
+    buf2 = (BASE *) malloc (n * sizeof (BASE));
+
+  if (buf1 == 0 || (data2 && buf2 == 0))
+    {
+      free (buf1);
+      free (buf2);
+      return GSL_ENOMEM;
+    }
+
+  for (k = 0; k < sizeof (BASE); k++)
+    {
+      offset[k] = sort_byte_offset (k, sizeof (BASE));
+
+      for (i = 0; i < 256; i++)
+        count[k][i] = 0;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      for (k = 0; k < sizeof (BASE); k++)
+        count[k][FUNCTION (my, radix_digit) (&data1[i], k, offset)]++;
+    }
+
+  src1 = data1;
+  src2 = data2;
+  dst1 = buf1;
+  dst2 = buf2;
+
+  for (k = 0; k < sizeof (BASE); k++)
+    {
+      size_t *pos = count[k];
+      size_t sum = 0;
+
+      if (pos[FUNCTION (my, radix_digit) (&src1[0], k, offset)] == n)
+        continue;               /* all keys have the same byte */
+
+      for (i = 0; i < 256; i++)
+        {
+          size_t c = pos[i];
+          pos[i] = sum;
+          sum += c;
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          size_t d = pos[FUNCTION (my, radix_digit) (&src1[i], k, offset)]++;
+
+          dst1[d] = src1[i];
+
+          if (data2)
+            dst2[d] = src2[i];
+        }
+
+      {
+        BASE *tmp = src1; src1 = dst1; dst1 = tmp;
+        tmp = src2; src2 = dst2; dst2 = tmp;
+      }
+    }
+
+  if (src1 != data1)
+    {
+      memcpy (data1, src1, n * sizeof (BASE));
+
+      if (data2)
+        memcpy (data2, src2, n * sizeof (BASE));
+    }
+
+  free (buf1);
+  free (buf2);
+
+  return GSL_SUCCESS;
+#else
+  (void) data1; (void) data2; (void) n;
+  return GSL_EUNSUP;
+#endif
+}
+
+#undef RADIX_KEY
+#undef RADIX_SIGNED
+
+/* radix sort does not benefit from ordered input, so check for it
+   first */
+
+static int
+FUNCTION (my, is_sorted) (const BASE * data, const size_t n)
+{
+  size_t i;
+
+  for (i = 1; i < n; i++)
+    {
+      if (SORT_LESS (data[i], data[i - 1]))
+        return 0;
+    }
+
+  return 1;
+}
+
+void
+TYPE (gsl_sort) (BASE * data, const size_t stride, const size_t n)
+{
+  const size_t m = FUNCTION (my, nan_partition) (data, stride, NULL, 0, n);
+
+  if (m < 2)
+    {
+      return;                   /* Nothing to sort */
+    }
+
+  if (stride == 1 && m >= SORT_RADIX_MIN
+      && (FUNCTION (my, is_sorted) (data, m)
+          || FUNCTION (my, radixsort) (data, NULL, m) == GSL_SUCCESS))
+    {
+      return;
+    }
+
+  FUNCTION (my, introsort) (data, stride, NULL, 0, 0, m - 1, sort_depth_limit (m));
+}
+
+void
+TYPE (gsl_sort_vector) (TYPE (gsl_vector) * v)
+{
+  TYPE (gsl_sort) (v->data, v->stride, v->size) ;
+}
+
+void
+TYPE (gsl_sort2) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n)
+{
+  const size_t m = FUNCTION (my, nan_partition) (data1, stride1, data2, stride2, n);
+
+  if (m < 2)
+    {
+      return;                   /* Nothing to sort */
+    }
+
+  if (stride1 == 1 && stride2 == 1 && m >= SORT_RADIX_MIN
+      && (FUNCTION (my, is_sorted) (data1, m)
+          || FUNCTION (my, radixsort) (data1, data2, m) == GSL_SUCCESS))
+    {
+      return;
+    }
+
+  FUNCTION (my, introsort) (data1, stride1, data2, stride2, 0, m - 1, sort_depth_limit (m));
+}
+
 void
 TYPE (gsl_sort_vector2) (TYPE (gsl_vector) * v1, TYPE (gsl_vector) * v2)
 {
   TYPE (gsl_sort2) (v1->data, v1->stride, v2->data, v2->stride, v1->size) ;
 }
+
+/* merge the sorted runs data[0..n1) and data[n1..n) in place, using a
+   buffer for the first run. Equal elements are taken from the first
+   run first, and NaNs are kept at the end. */
+
+#if defined(FP)
+#define MERGE_LESS(a,b) (SORT_LESS (a, b) || ((b) != (b) && (a) == (a)))
+#else
+#define MERGE_LESS(a,b) SORT_LESS (a, b)
+#endif
+
+static int
+FUNCTION (my, merge) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n1, const size_t n)
+{
+  BASE *a1, *a2 = 0;
+  size_t i = 0, j = n1, k = 0;
+
+  if (n1 > n)
+    {
+      GSL_ERROR ("first run is longer than the array", GSL_EINVAL);
+    }
+
+  if (n1 == 0 || n1 == n
+      || !MERGE_LESS (data1[n1 * stride1], data1[(n1 - 1) * stride1]))
+    {
+      return GSL_SUCCESS;       /* already in order */
+    }
+
+  a1 = (BASE *) malloc (n1 * sizeof (BASE));
+
+  if (data2)
+    a2 = (BASE *) malloc (n1 * sizeof (BASE));
+
+  if (a1 == 0 || (data2 && a2 == 0))
+    {
+      free (a1);
+      free (a2);
+      GSL_ERROR ("failed to allocate space for merge buffer", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < n1; i++)
+    {
+      a1[i] = data1[i * stride1];
+      if (data2)
+        a2[i] = data2[i * stride2];
+    }
+
+  /* the output position k = i + (j - n1) never overtakes j */
+
+  i = 0;
+
+  while (i < n1 && j < n)
+    {
+      if (MERGE_LESS (data1[j * stride1], a1[i]))
+        {
+          data1[k * stride1] = data1[j * stride1];
+          if (data2)
+            data2[k * stride2] = data2[j * stride2];
+          j++;
+        }
+      else
+        {
+          data1[k * stride1] = a1[i];
+          if (data2)
+            data2[k * stride2] = a2[i];
+          i++;
+        }
+
+      k++;
+    }
+
+  for (; i < n1; i++, k++)
+    {
+      data1[k * stride1] = a1[i];
+      if (data2)
+        data2[k * stride2] = a2[i];
+    }
+
+  free (a1);
+  free (a2);
+
+  return GSL_SUCCESS;
+}
+
+#undef MERGE_LESS
+#undef SORT_LESS
+
+int
+FUNCTION (gsl_sort, merge) (BASE * data, const size_t stride, const size_t n1, const size_t n)
+{
+  return FUNCTION (my, merge) (data, stride, NULL, 0, n1, n);
+}
+
+int
+FUNCTION (gsl_sort2, merge) (BASE * data1, const size_t stride1, BASE * data2, const size_t stride2, const size_t n1, const size_t n)
+{
+  return FUNCTION (my, merge) (data1, stride1, data2, stride2, n1, n);
+}
@@ -18,11 +18,16 @@
  */
 
 #include <config.h>
+#include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_sort_vector.h>
 
+/* runs of this size are sorted by insertion before merging */
+#define INDEX_RUN 32
+
 #define BASE_LONG_DOUBLE
 #include "templates_on.h"
 #include "sortvecind_source.c"
@@ -46,8 +46,8 @@ FUNCTION (index, downheap) (size_t * p, const BASE * data, const size_t stride,
   p[k] = pki;
 }
 
-void
-FUNCTION (gsl_sort, index) (size_t * p, const BASE * data, const size_t stride, const size_t n)
+static void
+FUNCTION (index, heapsort) (size_t * p, const BASE * data, const size_t stride, const size_t n)
 {
   size_t N;
   size_t i, k;
@@ -92,6 +92,173 @@ FUNCTION (gsl_sort, index) (size_t * p, const BASE * data, const size_t stride,
     }
 }
 
+/* comparison which places NaNs after all other values */
+
+#if defined(FP)
+#define INDEX_LESS(a,b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+#else
+#define INDEX_LESS(a,b) ((a) < (b))
+#endif
+
+/* merge the sorted index runs a[0..na) and b[0..nb) into out, taking
+   elements from a first when the values are equal */
+
+static void
+FUNCTION (index, merge_runs) (const size_t * a, const size_t na, const size_t * b, const size_t nb, size_t * out, const BASE * data, const size_t stride)
+{
+  size_t i = 0, j = 0, k = 0;
+
+  while (i < na && j < nb)
+    {
+      if (INDEX_LESS (data[b[j] * stride], data[a[i] * stride]))
+        out[k++] = b[j++];
+      else
+        out[k++] = a[i++];
+    }
+
+  while (i < na)
+    out[k++] = a[i++];
+
+  while (j < nb)
+    out[k++] = b[j++];
+}
+
+/* Stable bottom-up merge sort of the index. Runs of INDEX_RUN elements
+   are first sorted by insertion. Returns GSL_ENOMEM without calling
+   the error handler if the merge buffer cannot be allocated. */
+
+static int
+FUNCTION (index, mergesort) (size_t * p, const BASE * data, const size_t stride, const size_t n)
+{
+  size_t *buf, *src, *dst;
+  size_t i, w;
+
+  for (i = 0 ; i < n ; i++)
+    {
+      p[i] = i ;
+    }
+
+  for (i = 0; i < n; i += INDEX_RUN)
+    {
+      const size_t hi = (i + INDEX_RUN < n) ? i + INDEX_RUN : n;
+      size_t k;
+
+      for (k = i + 1; k < hi; k++)
+        {
+          const size_t pk = p[k];
+          size_t j = k;
+
+          while (j > i && INDEX_LESS (data[pk * stride], data[p[j - 1] * stride]))
+            {
+              p[j] = p[j - 1];
+              j--;
+            }
+
+          p[j] = pk;
+        }
+    }
+
+  if (n <= INDEX_RUN)
+    {
+      return GSL_SUCCESS;
+    }
+
+  buf = (size_t *) malloc (n * sizeof (size_t));
+
+  if (buf == 0)
+    {
+      return GSL_ENOMEM;
+    }
+
+  src = p;
+  dst = buf;
+
+  for (w = INDEX_RUN; w < n; w *= 2)
+    {
+      size_t *tmp;
+
+      for (i = 0; i < n; i += 2 * w)
+        {
+          const size_t mid = (i + w < n) ? i + w : n;
+          const size_t hi = (mid + w < n) ? mid + w : n;
+
+          FUNCTION (index, merge_runs) (src + i, mid - i, src + mid, hi - mid, dst + i, data, stride);
+        }
+
+      tmp = src;
+      src = dst;
+      dst = tmp;
+    }
+
+  if (src != p)
+    {
+      memcpy (p, src, n * sizeof (size_t));
+    }
+
+  free (buf);
+
+  return GSL_SUCCESS;
+}
+
+void
+FUNCTION (gsl_sort, index) (size_t * p, const BASE * data, const size_t stride, const size_t n)
+{
+  /* use heap sort, which needs no extra memory, if the merge buffer
+     cannot be allocated */
+
+  if (FUNCTION (index, mergesort) (p, data, stride, n) != GSL_SUCCESS)
+    {
+      FUNCTION (index, heapsort) (p, data, stride, n);
+    }
+}
+
+int
+FUNCTION (gsl_sort, index_stable) (size_t * p, const BASE * data, const size_t stride, const size_t n)
+{
+  if (FUNCTION (index, mergesort) (p, data, stride, n) != GSL_SUCCESS)
+    {
+      GSL_ERROR ("failed to allocate space for merge buffer", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION (gsl_sort, index_merge) (size_t * p, const BASE * data, const size_t stride, const size_t n1, const size_t n)
+{
+  size_t *a;
+
+  if (n1 > n)
+    {
+      GSL_ERROR ("first run is longer than the array", GSL_EINVAL);
+    }
+
+  if (n1 == 0 || n1 == n
+      || !INDEX_LESS (data[p[n1] * stride], data[p[n1 - 1] * stride]))
+    {
+      return GSL_SUCCESS;       /* already in order */
+    }
+
+  a = (size_t *) malloc (n1 * sizeof (size_t));
+
+  if (a == 0)
+    {
+      GSL_ERROR ("failed to allocate space for merge buffer", GSL_ENOMEM);
+    }
+
+  memcpy (a, p, n1 * sizeof (size_t));
+
+  /* the output never overtakes the unread part of the second run */
+
+  FUNCTION (index, merge_runs) (a, n1, p + n1, n - n1, p, data, stride);
+
+  free (a);
+
+  return GSL_SUCCESS;
+}
+
+#undef INDEX_LESS
+
 int
 FUNCTION (gsl_sort_vector, index) (gsl_permutation * permutation, const TYPE (gsl_vector) * v)
 {
@@ -104,3 +271,14 @@ FUNCTION (gsl_sort_vector, index) (gsl_permutation * permutation, const TYPE (gs
   
   return GSL_SUCCESS ;
 }
+
+int
+FUNCTION (gsl_sort_vector, index_stable) (gsl_permutation * permutation, const TYPE (gsl_vector) * v)
+{
+  if (permutation->size != v->size)
+    {
+      GSL_ERROR ("permutation and vector lengths are not equal", GSL_EBADLEN);
+    }
+
+  return FUNCTION (gsl_sort, index_stable) (permutation->data, v->data, v->stride, v->size) ;
+}
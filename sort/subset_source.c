@@ -13,15 +13,57 @@
  * for more details.
  */
 
-/* find the k-th smallest elements of the vector data, in ascending order */
+/* The k smallest (or largest) elements are collected in a heap of
+   size k held in dest, whose root is the element which would come
+   last in the output. Each remaining element displaces the root if
+   it comes before it, and the heap is finally sorted in place. This
+   takes O(n log k) operations instead of O(n k) for insertion into a
+   sorted list, and needs no workspace since src is left unchanged.
+   NaNs are ordered after all other values, as in gsl_sort. */
+
+#if defined(FP)
+#define SUBSET_LESS(a,b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+#else
+#define SUBSET_LESS(a,b) ((a) < (b))
+#endif
+
+/* true if a comes after b in the output, which is in ascending order
+   for the smallest elements and descending order for the largest */
+
+static inline int
+FUNCTION (my, after) (const BASE a, const BASE b, const int largest)
+{
+  return largest ? SUBSET_LESS (a, b) : SUBSET_LESS (b, a);
+}
 
-int
-FUNCTION (gsl_sort, smallest) (BASE * dest, const size_t k,
-                               const BASE * src, const size_t stride,
-                               const size_t n)
+static void
+FUNCTION (my, siftdown) (BASE * dest, const size_t N, size_t k, const int largest)
+{
+  BASE v = dest[k];
+
+  while (2 * k + 1 < N)
+    {
+      size_t j = 2 * k + 1;
+
+      if (j + 1 < N && FUNCTION (my, after) (dest[j + 1], dest[j], largest))
+        j++;
+
+      if (!FUNCTION (my, after) (dest[j], v, largest))
+        break;
+
+      dest[k] = dest[j];
+      k = j;
+    }
+
+  dest[k] = v;
+}
+
+static int
+FUNCTION (my, subset) (BASE * dest, const size_t k,
+                       const BASE * src, const size_t stride,
+                       const size_t n, const int largest)
 {
-  size_t i, j;
-  BASE xbound;
+  size_t i;
 
   if (k > n)
     {
@@ -33,43 +75,44 @@ FUNCTION (gsl_sort, smallest) (BASE * dest, const size_t k,
       return GSL_SUCCESS;
     }
 
-  /* take the first element */
+  for (i = 0; i < k; i++)
+    dest[i] = src[i * stride];
 
-  j = 1;
-  xbound = src[0 * stride];
-  dest[0] = xbound;
+  for (i = k / 2; i > 0; i--)
+    FUNCTION (my, siftdown) (dest, k, i - 1, largest);
 
-  /* examine the remaining elements */
-
-  for (i = 1; i < n; i++)
+  for (i = k; i < n; i++)
     {
-      size_t i1;
-
       BASE xi = src[i * stride];
 
-      if (j < k)
+      if (FUNCTION (my, after) (dest[0], xi, largest))
         {
-          j++;
-        }
-      else if (xi >= xbound)
-        {
-          continue;
+          dest[0] = xi;
+          FUNCTION (my, siftdown) (dest, k, 0, largest);
         }
+    }
 
-      for (i1 = j - 1; i1 > 0 ; i1--)
-        {
-          if (xi > dest[i1 - 1])
-            break;
+  for (i = k - 1; i > 0; i--)
+    {
+      BASE tmp = dest[0];
+      dest[0] = dest[i];
+      dest[i] = tmp;
+      FUNCTION (my, siftdown) (dest, i, 0, largest);
+    }
 
-          dest[i1] = dest[i1 - 1];
-        }
+  return GSL_SUCCESS;
+}
 
-      dest[i1] = xi;
+#undef SUBSET_LESS
 
-      xbound = dest[j-1];
-    }
+/* find the k-th smallest elements of the vector data, in ascending order */
 
-  return GSL_SUCCESS;
+int
+FUNCTION (gsl_sort, smallest) (BASE * dest, const size_t k,
+                               const BASE * src, const size_t stride,
+                               const size_t n)
+{
+  return FUNCTION (my, subset) (dest, k, src, stride, n, 0);
 }
 
 
@@ -85,56 +128,7 @@ FUNCTION (gsl_sort, largest) (BASE * dest, const size_t k,
                               const BASE * src, const size_t stride,
                               const size_t n)
 {
-  size_t i, j;
-  BASE xbound;
-
-  if (k > n)
-    {
-      GSL_ERROR ("subset length k exceeds vector length n", GSL_EINVAL);
-    }
-
-  if (k == 0 || n == 0)
-    {
-      return GSL_SUCCESS;
-    }
-
-  /* take the first element */
-
-  j = 1;
-  xbound = src[0 * stride];
-  dest[0] = xbound;
-
-  /* examine the remaining elements */
-
-  for (i = 1; i < n; i++)
-    {
-      size_t i1;
-
-      BASE xi = src[i * stride];
-
-      if (j < k)
-        {
-          j++;
-        }
-      else if (xi <= xbound)
-        {
-          continue;
-        }
-
-      for (i1 = j - 1; i1 > 0 ; i1--)
-        {
-          if (xi < dest[i1 - 1])
-            break;
-
-          dest[i1] = dest[i1 - 1];
-        }
-
-      dest[i1] = xi;
-
-      xbound = dest[j-1];
-    }
-
-  return GSL_SUCCESS;
+  return FUNCTION (my, subset) (dest, k, src, stride, n, 1);
 }
 
 
@@ -13,80 +13,63 @@
  * for more details.
  */
 
-/* find the k-th smallest elements of the vector data, in ascending order */
+/* As in subset_source.c, the indices of the k smallest (or largest)
+   elements are collected in a heap of size k held in p. Equal
+   elements are taken in order of increasing index. */
 
-int
-FUNCTION (gsl_sort, smallest_index) (size_t * p, const size_t k,
-                                     const BASE * src, const size_t stride,
-                                     const size_t n)
-{
-  size_t i, j;
-  BASE xbound;
+#if defined(FP)
+#define SUBSET_LESS(a,b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+#else
+#define SUBSET_LESS(a,b) ((a) < (b))
+#endif
 
-  if (k > n)
-    {
-      GSL_ERROR ("subset length k exceeds vector length n", GSL_EINVAL);
-    }
+/* true if index a comes after index b in the output */
 
-  if (k == 0 || n == 0)
-    {
-      return GSL_SUCCESS;
-    }
-
-  /* take the first element */
-
-  j = 1;
-  xbound = src[0 * stride];
-  p[0] = 0;
+static inline int
+FUNCTION (my, after) (const BASE * src, const size_t stride,
+                      const size_t a, const size_t b, const int largest)
+{
+  const BASE xa = src[a * stride];
+  const BASE xb = src[b * stride];
 
-  /* examine the remaining elements */
+  if (largest ? SUBSET_LESS (xa, xb) : SUBSET_LESS (xb, xa))
+    return 1;
 
-  for (i = 1; i < n; i++)
-    {
-      size_t i1;
+  if (largest ? SUBSET_LESS (xb, xa) : SUBSET_LESS (xa, xb))
+    return 0;
 
-      BASE xi = src[i * stride];
+  return a > b;
+}
 
-      if (j < k)
-        {
-          j++;
-        }
-      else if (xi >= xbound)
-        {
-          continue;
-        }
+static void
+FUNCTION (my, siftdown) (size_t * p, const BASE * src, const size_t stride,
+                         const size_t N, size_t k, const int largest)
+{
+  size_t v = p[k];
 
-      for (i1 = j - 1; i1 > 0 ; i1--)
-        {
-          if (xi > src[p[i1 - 1] * stride])
-            break;
+  while (2 * k + 1 < N)
+    {
+      size_t j = 2 * k + 1;
 
-          p[i1] = p[i1 - 1];
-        }
+      if (j + 1 < N && FUNCTION (my, after) (src, stride, p[j + 1], p[j], largest))
+        j++;
 
-      p[i1] = i;
+      if (!FUNCTION (my, after) (src, stride, p[j], v, largest))
+        break;
 
-      xbound = src[p[j-1] * stride];
+      p[k] = p[j];
+      k = j;
     }
 
-  return GSL_SUCCESS;
+  p[k] = v;
 }
 
-
-int
-FUNCTION (gsl_sort_vector,smallest_index) (size_t * p, const size_t k, 
-                                           const TYPE (gsl_vector) * v)
+static int
+FUNCTION (my, subset_index) (size_t * p, const size_t k,
+                             const BASE * src, const size_t stride,
+                             const size_t n, const int largest)
 {
-  return FUNCTION (gsl_sort, smallest_index) (p, k, v->data, v->stride, v->size);
-}
-
-int
-FUNCTION (gsl_sort, largest_index) (size_t * p, const size_t k,
-                                    const BASE * src, const size_t stride,
-                                    const size_t n)
-{
-  size_t i, j;
-  BASE xbound;
+  size_t i;
 
   if (k > n)
     {
@@ -98,43 +81,58 @@ FUNCTION (gsl_sort, largest_index) (size_t * p, const size_t k,
       return GSL_SUCCESS;
     }
 
-  /* take the first element */
+  for (i = 0; i < k; i++)
+    p[i] = i;
 
-  j = 1;
-  xbound = src[0 * stride];
-  p[0] = 0;
+  for (i = k / 2; i > 0; i--)
+    FUNCTION (my, siftdown) (p, src, stride, k, i - 1, largest);
 
-  /* examine the remaining elements */
+  for (i = k; i < n; i++)
+    {
+      if (FUNCTION (my, after) (src, stride, p[0], i, largest))
+        {
+          p[0] = i;
+          FUNCTION (my, siftdown) (p, src, stride, k, 0, largest);
+        }
+    }
 
-  for (i = 1; i < n; i++)
+  for (i = k - 1; i > 0; i--)
     {
-      size_t i1;
+      size_t tmp = p[0];
+      p[0] = p[i];
+      p[i] = tmp;
+      FUNCTION (my, siftdown) (p, src, stride, i, 0, largest);
+    }
 
-      BASE xi = src[i * stride];
+  return GSL_SUCCESS;
+}
 
-      if (j < k)
-        {
-          j++;
-        }
-      else if (xi <= xbound)
-        {
-          continue;
-        }
+#undef SUBSET_LESS
 
-      for (i1 = j - 1; i1 > 0 ; i1--)
-        {
-          if (xi < src[stride * p[i1 - 1]])
-            break;
+/* find the k-th smallest elements of the vector data, in ascending order */
 
-          p[i1] = p[i1 - 1];
-        }
+int
+FUNCTION (gsl_sort, smallest_index) (size_t * p, const size_t k,
+                                     const BASE * src, const size_t stride,
+                                     const size_t n)
+{
+  return FUNCTION (my, subset_index) (p, k, src, stride, n, 0);
+}
 
-      p[i1] = i;
 
-      xbound = src[stride * p[j-1]];
-    }
+int
+FUNCTION (gsl_sort_vector,smallest_index) (size_t * p, const size_t k, 
+                                           const TYPE (gsl_vector) * v)
+{
+  return FUNCTION (gsl_sort, smallest_index) (p, k, v->data, v->stride, v->size);
+}
 
-  return GSL_SUCCESS;
+int
+FUNCTION (gsl_sort, largest_index) (size_t * p, const size_t k,
+                                    const BASE * src, const size_t stride,
+                                    const size_t n)
+{
+  return FUNCTION (my, subset_index) (p, k, src, stride, n, 1);
 }
 
 
@@ -29,6 +29,10 @@
 #include <gsl/gsl_ieee_utils.h>
 
 size_t urand (size_t);
+void test_sort_nan (size_t n, size_t stride);
+void test_sort2_order (size_t n);
+void test_sort_patterns (size_t n);
+void test_subset (size_t n, size_t k);
 
 #include "test_heapsort.c"
 
@@ -128,9 +132,236 @@ main (void)
         }
     }
 
+  for (i = 10; i <= 100000; i *= 10)
+    {
+      test_sort_mixed (i);
+      test_sort_mixed_float (i);
+      test_sort_mixed_long_double (i);
+      test_sort_mixed_ulong (i);
+      test_sort_mixed_long (i);
+      test_sort_mixed_uint (i);
+      test_sort_mixed_int (i);
+      test_sort_mixed_ushort (i);
+      test_sort_mixed_short (i);
+      test_sort_mixed_uchar (i);
+      test_sort_mixed_char (i);
+    }
+
+  for (i = 7; i < 10000; i *= 7)
+    {
+      test_sort_nan (i, 1);
+      test_sort_nan (i, 2);
+      test_sort_nan (i, 3);
+      test_sort2_order (i);
+    }
+
+  test_sort_patterns (100000);
+
+  test_subset (20000, 1);
+  test_subset (20000, 50);
+  test_subset (20000, 5000);
+  test_subset (20000, 20000);
+
   exit (gsl_test_summary ());
 }
 
+/* NaNs are placed at the end, and -0 before +0 whatever the stride
+   and length, whether the radix sort or introsort is used */
+
+void
+test_sort_nan (size_t n, size_t stride)
+{
+  double *x = (double *) malloc (n * stride * sizeof (double));
+  size_t i, n_nan = 0;
+  int status = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      double v;
+
+      switch (urand (8))
+        {
+        case 0:
+          v = GSL_NAN;
+          n_nan++;
+          break;
+        case 1:
+          v = -0.0;
+          break;
+        case 2:
+          v = 0.0;
+          break;
+        case 3:
+          v = (urand (2) == 0) ? GSL_POSINF : GSL_NEGINF;
+          break;
+        default:
+          v = ((double) urand (1000) - 500.0) / 7.0;
+        }
+
+      x[i * stride] = v;
+    }
+
+  gsl_sort (x, stride, n);
+
+  for (i = 0; i < n; i++)
+    {
+      double v = x[i * stride];
+
+      if (i < n - n_nan)
+        {
+          status |= gsl_isnan (v);
+
+          if (i > 0)
+            {
+              double u = x[(i - 1) * stride];
+              status |= (v < u);
+
+              if (u == 0.0 && v == 0.0)
+                status |= (1.0 / u > 0 && 1.0 / v < 0);  /* +0 before -0 */
+            }
+        }
+      else
+        {
+          status |= !gsl_isnan (v);
+        }
+    }
+
+  gsl_test (status, "sorting with NaNs, n = %u, stride = %u", n, stride);
+
+  /* the index sort also places NaNs at the end, in their original
+     order, and merging keeps them there */
+
+  {
+    size_t *p = (size_t *) malloc (n * sizeof (size_t));
+    size_t n1 = n / 3;
+
+    for (i = 0; i < n; i++)
+      x[i * stride] = (urand (4) == 0) ? GSL_NAN : (double) urand (10);
+
+    status = gsl_sort_index_stable (p, x, stride, n);
+
+    for (i = 1; i < n; i++)
+      {
+        double u = x[p[i - 1] * stride], v = x[p[i] * stride];
+
+        if (gsl_isnan (u))
+          status |= !gsl_isnan (v) || (p[i] < p[i - 1]);
+        else
+          status |= (v < u) || (v == u && p[i] < p[i - 1]);
+      }
+
+    gsl_test (status, "index sorting with NaNs, n = %u, stride = %u", n, stride);
+
+    gsl_sort (x, stride, n1);
+    gsl_sort (x + n1 * stride, stride, n - n1);
+    status = gsl_sort_merge (x, stride, n1, n);
+
+    for (i = 1; i < n; i++)
+      {
+        double u = x[(i - 1) * stride], v = x[i * stride];
+        status |= gsl_isnan (u) ? !gsl_isnan (v) : (v < u);
+      }
+
+    gsl_test (status, "merging with NaNs, n = %u, stride = %u", n, stride);
+
+    free (p);
+  }
+
+  free (x);
+}
+
+/* equal keys keep the order of the second array in the stable radix
+   sort, and the pairs stay together for both algorithms */
+
+void
+test_sort2_order (size_t n)
+{
+  double *x = (double *) malloc (n * sizeof (double));
+  double *y = (double *) malloc (n * sizeof (double));
+  double *u = (double *) malloc (2 * n * sizeof (double));
+  double *w = (double *) malloc (2 * n * sizeof (double));
+  double *orig = (double *) malloc (n * sizeof (double));
+  size_t i;
+  int status = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      orig[i] = (double) urand (n / 4 + 1) - (double) (n / 8);
+      x[i] = orig[i];
+      y[i] = (double) i;
+      u[2 * i] = orig[i];
+      w[2 * i] = (double) i;
+    }
+
+  gsl_sort2 (x, 1, y, 1, n);
+  gsl_sort2 (u, 2, w, 2, n);
+
+  for (i = 0; i < n; i++)
+    {
+      status |= (x[i] != orig[(size_t) y[i]]);
+      status |= (u[2 * i] != orig[(size_t) w[2 * i]]);
+      status |= (x[i] != u[2 * i]);
+
+      if (i > 0 && n >= 256 && x[i] == x[i - 1])
+        status |= (y[i] < y[i - 1]);
+    }
+
+  gsl_test (status, "sorting2, pairs and stability, n = %u", n);
+
+  free (x);
+  free (y);
+  free (u);
+  free (w);
+  free (orig);
+}
+
+/* inputs which are bad cases for simple quicksorts */
+
+void
+test_sort_patterns (size_t n)
+{
+  int *x = (int *) malloc (2 * n * sizeof (int));
+  size_t i, p;
+
+  for (p = 0; p < 4; p++)
+    {
+      int status = 0;
+
+      for (i = 0; i < n; i++)
+        {
+          switch (p)
+            {
+            case 0:             /* all equal */
+              x[2 * i] = 7;
+              break;
+            case 1:             /* organ pipe */
+              x[2 * i] = (i < n / 2) ? (int) i : (int) (n - i);
+              break;
+            case 2:             /* sawtooth */
+              x[2 * i] = (int) (i % 17);
+              break;
+            default:            /* reversed with a few exchanges */
+              x[2 * i] = (int) (n - i);
+              if (i % 1000 == 0 && i > 0)
+                {
+                  int t = x[2 * i];
+                  x[2 * i] = x[2 * (i - 1)];
+                  x[2 * (i - 1)] = t;
+                }
+            }
+        }
+
+      gsl_sort_int (x, 2, n);
+
+      for (i = 1; i < n; i++)
+        status |= (x[2 * i] < x[2 * (i - 1)]);
+
+      gsl_test (status, "sorting, int, n = %u, stride = 2, pattern %u", n, p);
+    }
+
+  free (x);
+}
+
 size_t 
 urand (size_t N)
 {
@@ -138,3 +369,73 @@ urand (size_t N)
   x = (1103515245 * x + 12345) & 0x7fffffffUL;
   return (size_t) ((x / 2147483648.0) * N);
 }
+
+/* the subset functions agree with the stable index sort, taking
+   equal elements in order of increasing index and NaNs as larger
+   than any other value */
+
+void
+test_subset (size_t n, size_t k)
+{
+  double *x = (double *) malloc (n * sizeof (double));
+  double *y = (double *) malloc (n * sizeof (double));
+  double *dest = (double *) malloc (k * sizeof (double));
+  size_t *p = (size_t *) malloc (n * sizeof (size_t));
+  size_t *r = (size_t *) malloc (n * sizeof (size_t));
+  size_t *q = (size_t *) malloc (k * sizeof (size_t));
+  size_t i, m = 0;
+  int status = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      x[i] = (urand (8) == 0) ? GSL_NAN : (double) urand (n / 8 + 1);
+      y[i] = -x[i];
+    }
+
+  gsl_sort_index_stable (p, x, 1, n);
+
+  status |= gsl_sort_smallest (dest, k, x, 1, n);
+  status |= gsl_sort_smallest_index (q, k, x, 1, n);
+
+  for (i = 0; i < k; i++)
+    {
+      double u = x[p[i]];
+      status |= (q[i] != p[i]);
+      status |= gsl_isnan (u) ? !gsl_isnan (dest[i]) : (dest[i] != u);
+    }
+
+  gsl_test (status, "smallest with ties and NaNs, n = %u, k = %u", n, k);
+
+  /* the largest elements are the NaNs followed by the other values
+     in descending order */
+
+  gsl_sort_index_stable (p, y, 1, n);
+
+  for (i = 0; i < n; i++)
+    {
+      if (gsl_isnan (y[p[i]]))
+        r[m++] = p[i];
+    }
+
+  for (i = 0; i < n - m; i++)
+    r[m + i] = p[i];
+
+  status = gsl_sort_largest (dest, k, x, 1, n);
+  status |= gsl_sort_largest_index (q, k, x, 1, n);
+
+  for (i = 0; i < k; i++)
+    {
+      double u = x[r[i]];
+      status |= (q[i] != r[i]);
+      status |= gsl_isnan (u) ? !gsl_isnan (dest[i]) : (dest[i] != u);
+    }
+
+  gsl_test (status, "largest with ties and NaNs, n = %u, k = %u", n, k);
+
+  free (x);
+  free (y);
+  free (dest);
+  free (p);
+  free (r);
+  free (q);
+}
@@ -18,6 +18,7 @@
  */
 
 void TYPE (test_sort_vector) (size_t N, size_t stride);
+void TYPE (test_sort_mixed) (size_t N);
 void FUNCTION (my, initialize) (TYPE (gsl_vector) * v);
 void FUNCTION (my, randomize) (TYPE (gsl_vector) * v);
 int FUNCTION (my, check) (TYPE (gsl_vector) * data, TYPE (gsl_vector) * orig);
@@ -174,6 +175,115 @@ TYPE (test_sort_vector) (size_t N, size_t stride)
   free (index);
 }
 
+/* data with duplicates and negative values, sorted with unit stride
+   (radix sort for large N) and with stride 2 (introsort), which must
+   give the same result */
+
+void
+TYPE (test_sort_mixed) (size_t N)
+{
+  BASE *x = (BASE *) malloc (N * sizeof (BASE));
+  BASE *y = (BASE *) malloc (2 * N * sizeof (BASE));
+  BASE *z = (BASE *) malloc (N * sizeof (BASE));
+  size_t i;
+  int status = 0;
+
+  for (i = 0; i < N; i++)
+    {
+      x[i] = (BASE) ((long) urand (200) - 100);
+      y[2 * i] = x[i];
+      y[2 * i + 1] = (BASE) 1;
+      z[i] = x[i];
+    }
+
+  TYPE (gsl_sort) (x, 1, N);
+  TYPE (gsl_sort) (y, 2, N);
+
+  for (i = 0; i < N; i++)
+    {
+      status |= (x[i] != y[2 * i]);
+      status |= (y[2 * i + 1] != (BASE) 1);
+
+      if (i > 0)
+        status |= (x[i] < x[i - 1]);
+    }
+
+  gsl_test (status, "sorting, " NAME (gsl_vector) ", n = %u, mixed signs and duplicates", N);
+
+  /* the second array follows the first */
+
+  for (i = 0; i < N; i++)
+    y[i] = z[i];
+
+  TYPE (gsl_sort2) (z, 1, y, 1, N);
+  status = 0;
+
+  for (i = 0; i < N; i++)
+    status |= (z[i] != x[i]) || (y[i] != x[i]);
+
+  gsl_test (status, "sorting2, " NAME (gsl_vector) ", n = %u, mixed signs and duplicates", N);
+
+  /* sorting chunks separately and merging them in a tree gives the
+     same result, and stable argsorts merge to the stable argsort of
+     the whole array */
+
+  {
+    const size_t nchunk = 5, len = (N + nchunk - 1) / nchunk;
+    size_t *p = (size_t *) malloc (N * sizeof (size_t));
+    size_t *q = (size_t *) malloc (N * sizeof (size_t));
+    size_t c, w;
+
+    for (i = 0; i < N; i++)
+      {
+        y[i] = (BASE) ((long) urand (200) - 100);
+        z[i] = y[i];
+        x[i] = y[i];
+      }
+
+    TYPE (gsl_sort) (x, 1, N);
+
+    status = FUNCTION (gsl_sort, index_stable) (q, y, 1, N);
+
+    for (c = 0; c < N; c += len)
+      {
+        const size_t m = (c + len < N) ? len : N - c;
+        TYPE (gsl_sort) (z + c, 1, m);
+        FUNCTION (gsl_sort, index) (p + c, y + c, 1, m);
+
+        for (i = c; i < c + m; i++)
+          p[i] += c;
+      }
+
+    for (w = len; w < N; w *= 2)
+      {
+        for (c = 0; c + w < N; c += 2 * w)
+          {
+            const size_t hi = (c + 2 * w < N) ? c + 2 * w : N;
+            status |= FUNCTION (gsl_sort, merge) (z + c, 1, w, hi - c);
+            status |= FUNCTION (gsl_sort, index_merge) (p + c, y, 1, w, hi - c);
+          }
+      }
+
+    for (i = 0; i < N; i++)
+      {
+        status |= (z[i] != x[i]);
+        status |= (p[i] != q[i]);
+        status |= (y[q[i]] != x[i]);
+
+        if (i > 0 && x[i] == x[i - 1])
+          status |= (q[i] < q[i - 1]);
+      }
+
+    gsl_test (status, "merging, " NAME (gsl_vector) ", n = %u, stable index and chunks", N);
+
+    free (p);
+    free (q);
+  }
+
+  free (x);
+  free (y);
+  free (z);
+}
 
 void
 FUNCTION (my, initialize) (TYPE (gsl_vector) * v)
@@ -0,0 +1,470 @@
+/* statistics/covmatrix.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Covariance and correlation matrices of the columns of an n-by-p
+   data matrix X.
+
+   The column means are found first. The rows are then processed in
+   blocks of COVMAT_BLOCK: each block B is copied with the means
+   subtracted, and B^T B is added to the lower triangle of the matrix
+   of sums of products with the level 3 BLAS routine dsyrk. This costs
+   n p^2 / 2 multiply-adds carried out at the speed of the BLAS
+   library, which may be multithreaded, instead of p^2 / 2 separate
+   passes over the data, and needs only COVMAT_BLOCK p extra elements.
+
+   The pairwise complete estimates for data with missing values (NaN)
+   use, for each pair of columns j, k, only the rows where both values
+   are present. With M the indicator matrix of the present values and
+   Z the centered data with zeros in place of the missing values, the
+   sums over these rows are
+
+     N = M^T M          N_jk = number of rows
+     S = Z^T M          S_jk = sum of z_j
+     P = Z^T Z          P_jk = sum of z_j z_k
+     Q = (Z o Z)^T M    Q_jk = sum of z_j^2
+
+   and the covariance is (P_jk - S_jk S_kj / N_jk) / (N_jk - 1). The
+   columns are centered about the means of all their present values,
+   so the correction S_jk S_kj / N_jk is small and the differences do
+   not lose precision. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics.h>
+#include <gsl/gsl_statistics_matrix.h>
+
+#define COVMAT_BLOCK 256
+
+static int covmat_check (const gsl_matrix * X, const gsl_matrix * C);
+static void covmat_symmetrize (gsl_matrix * A);
+static int covmat_products (const gsl_matrix * X, gsl_matrix * C);
+static int covmat_normalize (gsl_matrix * C);
+static int covmat_pairwise (const gsl_matrix * X, gsl_matrix * C, const int corr);
+
+int
+gsl_stats_covariance_matrix (const gsl_matrix * X, gsl_matrix * C)
+{
+  int status = covmat_check (X, C);
+  const double scale = 1.0 / (X->size1 - 1.0);
+  size_t j, k;
+
+  if (status)
+    return status;
+
+  status = covmat_products (X, C);
+  if (status)
+    return status;
+
+  for (j = 0; j < C->size1; ++j)
+    {
+      for (k = 0; k <= j; ++k)
+        gsl_matrix_set (C, j, k, scale * gsl_matrix_get (C, j, k));
+    }
+
+  covmat_symmetrize (C);
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_stats_correlation_matrix (const gsl_matrix * X, gsl_matrix * C)
+{
+  int status = covmat_check (X, C);
+
+  if (status)
+    return status;
+
+  status = covmat_products (X, C);
+  if (status)
+    return status;
+
+  return covmat_normalize (C);
+}
+
+/*
+gsl_stats_spearman_matrix()
+  Compute the Spearman rank correlation matrix, as the Pearson
+correlation matrix of the ranks of each column, with tied values
+given the mean of their ranks. Each column is ranked once. A column
+containing a NaN gives NaN correlations.
+*/
+
+int
+gsl_stats_spearman_matrix (const gsl_matrix * X, gsl_matrix * C)
+{
+  const size_t n = X->size1;
+  const size_t p = X->size2;
+  int status = covmat_check (X, C);
+  gsl_matrix *R;
+  double *col;
+  size_t *idx;
+  size_t i, j;
+
+  if (status)
+    return status;
+
+  R = gsl_matrix_alloc (n, p);
+  col = (double *) malloc (n * sizeof (double));
+  idx = (size_t *) malloc (n * sizeof (size_t));
+
+  if (R == 0 || col == 0 || idx == 0)
+    {
+      if (R)
+        gsl_matrix_free (R);
+      free (col);
+      free (idx);
+      GSL_ERROR ("failed to allocate space for ranks", GSL_ENOMEM);
+    }
+
+  for (j = 0; j < p; ++j)
+    {
+      double *rank = R->data + j;
+      const size_t tda = R->tda;
+
+      /* rank a contiguous copy of the column */
+      for (i = 0; i < n; ++i)
+        col[i] = gsl_matrix_get (X, i, j);
+
+      gsl_sort_index (idx, col, 1, n);
+
+      /* NaNs are sorted last */
+      if (gsl_isnan (col[idx[n - 1]]))
+        {
+          for (i = 0; i < n; ++i)
+            rank[i * tda] = GSL_NAN;
+
+          continue;
+        }
+
+      i = 0;
+
+      while (i < n)
+        {
+          const double v = col[idx[i]];
+          size_t k = i + 1, l;
+          double r;
+
+          while (k < n && col[idx[k]] == v)
+            ++k;
+
+          /* mean of the ranks i+1, ..., k */
+          r = 0.5 * (i + 1 + k);
+
+          for (l = i; l < k; ++l)
+            rank[idx[l] * tda] = r;
+
+          i = k;
+        }
+    }
+
+  status = covmat_products (R, C);
+
+  gsl_matrix_free (R);
+  free (col);
+  free (idx);
+
+  if (status)
+    return status;
+
+  return covmat_normalize (C);
+}
+
+int
+gsl_stats_covariance_matrix_pairwise (const gsl_matrix * X, gsl_matrix * C)
+{
+  int status = covmat_check (X, C);
+
+  if (status)
+    return status;
+
+  return covmat_pairwise (X, C, 0);
+}
+
+int
+gsl_stats_correlation_matrix_pairwise (const gsl_matrix * X, gsl_matrix * C)
+{
+  int status = covmat_check (X, C);
+
+  if (status)
+    return status;
+
+  return covmat_pairwise (X, C, 1);
+}
+
+static int
+covmat_check (const gsl_matrix * X, const gsl_matrix * C)
+{
+  if (C->size1 != X->size2 || C->size2 != X->size2)
+    {
+      GSL_ERROR ("C must be p-by-p for a data matrix with p columns",
+                 GSL_EBADLEN);
+    }
+
+  if (X->size1 < 2)
+    {
+      GSL_ERROR ("at least two observations are required", GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* copy the lower triangle of A to the upper triangle */
+
+static void
+covmat_symmetrize (gsl_matrix * A)
+{
+  size_t j, k;
+
+  for (j = 0; j < A->size1; ++j)
+    {
+      for (k = 0; k < j; ++k)
+        gsl_matrix_set (A, k, j, gsl_matrix_get (A, j, k));
+    }
+}
+
+/* store in the lower triangle of C the sums of products of the
+   deviations of the columns of X from their means */
+
+static int
+covmat_products (const gsl_matrix * X, gsl_matrix * C)
+{
+  const size_t n = X->size1;
+  const size_t p = X->size2;
+  const size_t nb = GSL_MIN (n, COVMAT_BLOCK);
+  double *mean = (double *) malloc (p * sizeof (double));
+  gsl_matrix *B = gsl_matrix_alloc (nb, p);
+  size_t i, j, r;
+
+  if (mean == 0 || B == 0)
+    {
+      free (mean);
+      if (B)
+        gsl_matrix_free (B);
+      GSL_ERROR ("failed to allocate space for block", GSL_ENOMEM);
+    }
+
+  for (j = 0; j < p; ++j)
+    mean[j] = gsl_stats_mean (X->data + j, X->tda, n);
+
+  gsl_matrix_set_zero (C);
+
+  for (r = 0; r < n; r += nb)
+    {
+      const size_t m = GSL_MIN (nb, n - r);
+      gsl_matrix_view Bm = gsl_matrix_submatrix (B, 0, 0, m, p);
+
+      for (i = 0; i < m; ++i)
+        {
+          const double *xi = X->data + (r + i) * X->tda;
+          double *bi = B->data + i * B->tda;
+
+          for (j = 0; j < p; ++j)
+            bi[j] = xi[j] - mean[j];
+        }
+
+      gsl_blas_dsyrk (CblasLower, CblasTrans, 1.0, &Bm.matrix, 1.0, C);
+    }
+
+  free (mean);
+  gsl_matrix_free (B);
+
+  return GSL_SUCCESS;
+}
+
+/* turn the sums of products in the lower triangle of C into
+   correlations, and fill the upper triangle */
+
+static int
+covmat_normalize (gsl_matrix * C)
+{
+  const size_t p = C->size1;
+  double *d = (double *) malloc (p * sizeof (double));
+  size_t j, k;
+
+  if (d == 0)
+    {
+      GSL_ERROR ("failed to allocate space for diagonal", GSL_ENOMEM);
+    }
+
+  for (j = 0; j < p; ++j)
+    d[j] = sqrt (gsl_matrix_get (C, j, j));
+
+  for (j = 0; j < p; ++j)
+    {
+      for (k = 0; k < j; ++k)
+        gsl_matrix_set (C, j, k, gsl_matrix_get (C, j, k) / (d[j] * d[k]));
+
+      gsl_matrix_set (C, j, j, (d[j] > 0.0) ? 1.0 : GSL_NAN);
+    }
+
+  covmat_symmetrize (C);
+
+  free (d);
+
+  return GSL_SUCCESS;
+}
+
+static int
+covmat_pairwise (const gsl_matrix * X, gsl_matrix * C, const int corr)
+{
+  const size_t n = X->size1;
+  const size_t p = X->size2;
+  const size_t nb = GSL_MIN (n, COVMAT_BLOCK);
+  double *mean = (double *) malloc (p * sizeof (double));
+  gsl_matrix *Z = gsl_matrix_alloc (nb, p);
+  gsl_matrix *M = gsl_matrix_alloc (nb, p);
+  gsl_matrix *Z2 = corr ? gsl_matrix_alloc (nb, p) : 0;
+  gsl_matrix *N = gsl_matrix_alloc (p, p);
+  gsl_matrix *S = gsl_matrix_alloc (p, p);
+  gsl_matrix *Q = corr ? gsl_matrix_alloc (p, p) : 0;
+  size_t i, j, k, r;
+
+  if (mean == 0 || Z == 0 || M == 0 || N == 0 || S == 0
+      || (corr && (Z2 == 0 || Q == 0)))
+    {
+      free (mean);
+      if (Z) gsl_matrix_free (Z);
+      if (M) gsl_matrix_free (M);
+      if (Z2) gsl_matrix_free (Z2);
+      if (N) gsl_matrix_free (N);
+      if (S) gsl_matrix_free (S);
+      if (Q) gsl_matrix_free (Q);
+      GSL_ERROR ("failed to allocate space for sums", GSL_ENOMEM);
+    }
+
+  /* means of the present values of each column */
+
+  for (j = 0; j < p; ++j)
+    {
+      double sum = 0.0;
+      size_t count = 0;
+
+      for (i = 0; i < n; ++i)
+        {
+          const double x = gsl_matrix_get (X, i, j);
+
+          if (!gsl_isnan (x))
+            {
+              sum += x;
+              ++count;
+            }
+        }
+
+      mean[j] = (count > 0) ? sum / count : 0.0;
+    }
+
+  /* the sums P are accumulated in C */
+
+  gsl_matrix_set_zero (C);
+  gsl_matrix_set_zero (N);
+  gsl_matrix_set_zero (S);
+  if (corr)
+    gsl_matrix_set_zero (Q);
+
+  for (r = 0; r < n; r += nb)
+    {
+      const size_t m = GSL_MIN (nb, n - r);
+      gsl_matrix_view Zm = gsl_matrix_submatrix (Z, 0, 0, m, p);
+      gsl_matrix_view Mm = gsl_matrix_submatrix (M, 0, 0, m, p);
+
+      for (i = 0; i < m; ++i)
+        {
+          const double *xi = X->data + (r + i) * X->tda;
+          double *zi = Z->data + i * Z->tda;
+          double *mi = M->data + i * M->tda;
+
+          for (j = 0; j < p; ++j)
+            {
+              const int present = !gsl_isnan (xi[j]);
+
+              zi[j] = present ? xi[j] - mean[j] : 0.0;
+              mi[j] = present ? 1.0 : 0.0;
+            }
+
+          if (corr)
+            {
+              double *z2i = Z2->data + i * Z2->tda;
+
+              for (j = 0; j < p; ++j)
+                z2i[j] = zi[j] * zi[j];
+            }
+        }
+
+      gsl_blas_dsyrk (CblasLower, CblasTrans, 1.0, &Mm.matrix, 1.0, N);
+      gsl_blas_dsyrk (CblasLower, CblasTrans, 1.0, &Zm.matrix, 1.0, C);
+      gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Zm.matrix, &Mm.matrix, 1.0, S);
+
+      if (corr)
+        {
+          gsl_matrix_view Z2m = gsl_matrix_submatrix (Z2, 0, 0, m, p);
+          gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Z2m.matrix, &Mm.matrix, 1.0, Q);
+        }
+    }
+
+  for (j = 0; j < p; ++j)
+    {
+      for (k = 0; k <= j; ++k)
+        {
+          const double njk = gsl_matrix_get (N, j, k);
+          const double sjk = gsl_matrix_get (S, j, k);
+          const double skj = gsl_matrix_get (S, k, j);
+          const double a = gsl_matrix_get (C, j, k) - sjk * skj / njk;
+          double c;
+
+          if (njk < 2.0)
+            {
+              c = GSL_NAN;
+            }
+          else if (corr)
+            {
+              const double vj = gsl_matrix_get (Q, j, k) - sjk * sjk / njk;
+              const double vk = gsl_matrix_get (Q, k, j) - skj * skj / njk;
+
+              if (j == k)
+                c = (vj > 0.0) ? 1.0 : GSL_NAN;
+              else
+                c = a / (sqrt (vj) * sqrt (vk));
+            }
+          else
+            {
+              c = a / (njk - 1.0);
+            }
+
+          gsl_matrix_set (C, j, k, c);
+        }
+    }
+
+  covmat_symmetrize (C);
+
+  free (mean);
+  gsl_matrix_free (Z);
+  gsl_matrix_free (M);
+  gsl_matrix_free (N);
+  gsl_matrix_free (S);
+  if (corr)
+    {
+      gsl_matrix_free (Z2);
+      gsl_matrix_free (Q);
+    }
+
+  return GSL_SUCCESS;
+}
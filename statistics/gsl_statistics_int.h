@@ -21,6 +21,7 @@
 #define __GSL_STATISTICS_INT_H__
 
 #include <stddef.h>
+#include <gsl/gsl_statistics_summary.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -72,9 +73,54 @@ size_t gsl_stats_int_max_index (const int data[], const size_t stride, const siz
 size_t gsl_stats_int_min_index (const int data[], const size_t stride, const size_t n);
 void gsl_stats_int_minmax_index (size_t * min_index, size_t * max_index, const int data[], const size_t stride, const size_t n);
 
+int gsl_stats_int_summary (gsl_stats_summary_t * s, const int data[], const size_t stride, const size_t n);
+
 double gsl_stats_int_median_from_sorted_data (const int sorted_data[], const size_t stride, const size_t n) ;
 double gsl_stats_int_quantile_from_sorted_data (const int sorted_data[], const size_t stride, const size_t n, const double f) ;
 
+int gsl_stats_int_select (int data[], const size_t stride, const size_t n, const size_t k);
+double gsl_stats_int_median (int data[], const size_t stride, const size_t n);
+double gsl_stats_int_quantile (int data[], const size_t stride, const size_t n, const double f);
+int gsl_stats_int_quantiles (int data[], const size_t stride, const size_t n, const double f[], const size_t nf, double q[]);
+
+typedef struct
+{
+  size_t size;          /* window length */
+  size_t n;             /* number of values in the window */
+  size_t count;         /* number of values pushed */
+  double f;             /* quantile tracked */
+  double mean;          /* mean of the window */
+  double M2;            /* sum of squared deviations from the mean */
+  int *x;               /* ring buffer of values */
+  size_t *minq;         /* deque of positions for the minimum */
+  size_t *maxq;         /* deque of positions for the maximum */
+  int *minv;            /* values in the minimum deque */
+  int *maxv;            /* values in the maximum deque */
+  size_t min_head, min_len, max_head, max_len;
+  size_t *lo;           /* max-heap of the lower values */
+  size_t *hi;           /* min-heap of the upper values */
+  size_t *pos;          /* position of each slot in the heaps */
+  size_t nlo, nhi;
+} gsl_stats_int_window;
+
+gsl_stats_int_window * gsl_stats_int_window_alloc (const size_t size, const double f);
+void gsl_stats_int_window_free (gsl_stats_int_window * w);
+int gsl_stats_int_window_reset (gsl_stats_int_window * w);
+int gsl_stats_int_window_push (const int x, gsl_stats_int_window * w);
+size_t gsl_stats_int_window_n (const gsl_stats_int_window * w);
+double gsl_stats_int_window_mean (const gsl_stats_int_window * w);
+double gsl_stats_int_window_variance (const gsl_stats_int_window * w);
+double gsl_stats_int_window_sd (const gsl_stats_int_window * w);
+int gsl_stats_int_window_min (const gsl_stats_int_window * w);
+int gsl_stats_int_window_max (const gsl_stats_int_window * w);
+double gsl_stats_int_window_quantile (const gsl_stats_int_window * w);
+
+int gsl_stats_int_moving_mean (const int data[], const size_t stride, const size_t n, const size_t window, double mean[]);
+int gsl_stats_int_moving_variance (const int data[], const size_t stride, const size_t n, const size_t window, double variance[]);
+int gsl_stats_int_moving_minmax (const int data[], const size_t stride, const size_t n, const size_t window, int min[], int max[]);
+int gsl_stats_int_moving_median (const int data[], const size_t stride, const size_t n, const size_t window, double median[]);
+int gsl_stats_int_moving_quantile (const int data[], const size_t stride, const size_t n, const size_t window, const double f, double q[]);
+
 __END_DECLS
 
 #endif /* __GSL_STATISTICS_INT_H__ */
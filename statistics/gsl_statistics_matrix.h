@@ -0,0 +1,47 @@
+/* statistics/gsl_statistics_matrix.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_STATISTICS_MATRIX_H__
+#define __GSL_STATISTICS_MATRIX_H__
+
+#include <gsl/gsl_matrix.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* statistics between the columns of an n-by-p data matrix, with one
+   observation in each row */
+
+int gsl_stats_covariance_matrix (const gsl_matrix * X, gsl_matrix * C);
+int gsl_stats_correlation_matrix (const gsl_matrix * X, gsl_matrix * C);
+int gsl_stats_spearman_matrix (const gsl_matrix * X, gsl_matrix * C);
+
+int gsl_stats_covariance_matrix_pairwise (const gsl_matrix * X, gsl_matrix * C);
+int gsl_stats_correlation_matrix_pairwise (const gsl_matrix * X, gsl_matrix * C);
+
+__END_DECLS
+
+#endif /* __GSL_STATISTICS_MATRIX_H__ */
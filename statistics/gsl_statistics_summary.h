@@ -0,0 +1,54 @@
+/* statistics/gsl_statistics_summary.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_STATISTICS_SUMMARY_H__
+#define __GSL_STATISTICS_SUMMARY_H__
+
+#include <stddef.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t n;         /* number of data */
+  double min;       /* minimum value */
+  double max;       /* maximum value */
+  double mean;      /* arithmetic mean */
+  double variance;  /* estimated variance, with a factor 1/(n-1) */
+  double sd;        /* estimated standard deviation */
+  double skew;      /* skewness */
+  double kurtosis;  /* excess kurtosis */
+  double M2;        /* M_k = sum_{i=1..n} [ x_i - mean ]^k */
+  double M3;
+  double M4;
+} gsl_stats_summary_t;
+
+int gsl_stats_summary_merge (gsl_stats_summary_t * s, const gsl_stats_summary_t * t);
+
+__END_DECLS
+
+#endif /* __GSL_STATISTICS_SUMMARY_H__ */
@@ -0,0 +1,359 @@
+/* statistics/select_source.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Selection of order statistics in linear time, rearranging the data
+   in place. The range containing the k-th element is repeatedly
+   partitioned (Hoare's FIND, or quickselect) about the median of its
+   first, middle and last elements. If the range has not shrunk after
+   2 log2(n) steps the pivot is taken as the median of the medians of
+   groups of five (Blum, Floyd, Pratt, Rivest and Tarjan), which
+   guarantees O(n) operations in the worst case (introselect,
+   D. R. Musser, Software Practice and Experience 27, 983 (1997)).
+
+   On return the k-th smallest element is at position k, with no
+   larger element before it and no smaller element after it. NaNs are
+   ordered after all other values, as in gsl_sort. */
+
+static inline void
+FUNCTION (my, swap) (BASE data[], const size_t stride, const size_t i, const size_t j)
+{
+  BASE tmp = data[i * stride];
+  data[i * stride] = data[j * stride];
+  data[j * stride] = tmp;
+}
+
+/* move any NaNs to the end of the data and return the number of
+   other elements */
+
+static size_t
+FUNCTION (my, nan_partition) (BASE data[], const size_t stride, const size_t n)
+{
+#if defined(FP)
+  size_t i, m = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      if (data[i * stride] == data[i * stride])
+        {
+          if (i != m)
+            FUNCTION (my, swap) (data, stride, i, m);
+          m++;
+        }
+    }
+
+  return m;
+#else
+  return n;
+#endif
+}
+
+static void
+FUNCTION (my, insertion) (BASE data[], const size_t stride, const size_t lo, const size_t hi)
+{
+  size_t i;
+
+  for (i = lo + 1; i <= hi; i++)
+    {
+      BASE v = data[i * stride];
+      size_t j = i;
+
+      while (j > lo && v < data[(j - 1) * stride])
+        {
+          data[j * stride] = data[(j - 1) * stride];
+          j--;
+        }
+
+      data[j * stride] = v;
+    }
+}
+
+/* Hoare partition of data[lo..hi] about the pivot in data[lo]. On
+   return data[lo..j] <= pivot <= data[j+1..hi] with lo <= j < hi */
+
+static size_t
+FUNCTION (my, partition) (BASE data[], const size_t stride, const size_t lo, const size_t hi)
+{
+  const BASE pivot = data[lo * stride];
+  size_t i = lo, j = hi;
+
+  for (;;)
+    {
+      while (data[i * stride] < pivot)
+        i++;
+
+      while (pivot < data[j * stride])
+        j--;
+
+      if (i >= j)
+        return j;
+
+      FUNCTION (my, swap) (data, stride, i, j);
+      i++;
+      j--;
+    }
+}
+
+static void FUNCTION (my, select_range) (BASE data[], const size_t stride, size_t lo, size_t hi, const size_t k);
+
+/* move the median of the medians of groups of five elements of
+   data[lo..hi] to data[lo] */
+
+static void
+FUNCTION (my, median_of_medians) (BASE data[], const size_t stride, const size_t lo, const size_t hi)
+{
+  size_t g, ng = 0;
+
+  for (g = lo; g + 4 <= hi; g += 5)
+    {
+      FUNCTION (my, insertion) (data, stride, g, g + 4);
+      FUNCTION (my, swap) (data, stride, lo + ng, g + 2);
+      ng++;
+    }
+
+  FUNCTION (my, select_range) (data, stride, lo, lo + ng - 1, lo + ng / 2);
+  FUNCTION (my, swap) (data, stride, lo, lo + ng / 2);
+}
+
+/* rearrange data[lo..hi] so that the element of rank k is in place,
+   for lo <= k <= hi */
+
+static void
+FUNCTION (my, select_range) (BASE data[], const size_t stride, size_t lo, size_t hi, const size_t k)
+{
+  size_t limit = select_depth_limit (hi - lo + 1);
+
+  while (hi - lo >= SELECT_INSERTION_MAX)
+    {
+      size_t j;
+
+      if (limit > 0)
+        {
+          const size_t mid = lo + (hi - lo) / 2;
+
+          if (data[mid * stride] < data[lo * stride])
+            FUNCTION (my, swap) (data, stride, lo, mid);
+          if (data[hi * stride] < data[mid * stride])
+            FUNCTION (my, swap) (data, stride, mid, hi);
+          if (data[mid * stride] < data[lo * stride])
+            FUNCTION (my, swap) (data, stride, lo, mid);
+
+          FUNCTION (my, swap) (data, stride, lo, mid);
+          limit--;
+        }
+      else
+        {
+          FUNCTION (my, median_of_medians) (data, stride, lo, hi);
+        }
+
+      j = FUNCTION (my, partition) (data, stride, lo, hi);
+
+      if (k <= j)
+        hi = j;
+      else
+        lo = j + 1;
+    }
+
+  FUNCTION (my, insertion) (data, stride, lo, hi);
+}
+
+/* smallest element of data[lo..hi] */
+
+static BASE
+FUNCTION (my, min_range) (const BASE data[], const size_t stride, const size_t lo, const size_t hi)
+{
+  BASE min = data[lo * stride];
+  size_t i;
+
+  for (i = lo + 1; i <= hi; i++)
+    {
+      if (data[i * stride] < min)
+        min = data[i * stride];
+    }
+
+  return min;
+}
+
+BASE
+FUNCTION (gsl_stats, select) (BASE data[], const size_t stride, const size_t n, const size_t k)
+{
+  size_t m;
+
+  if (n == 0)
+    {
+      GSL_ERROR_VAL ("n must be positive", GSL_EBADLEN, 0);
+    }
+
+  if (k >= n)
+    {
+      GSL_ERROR_VAL ("k must be less than n", GSL_EINVAL, 0);
+    }
+
+  m = FUNCTION (my, nan_partition) (data, stride, n);
+
+  if (k < m)
+    FUNCTION (my, select_range) (data, stride, 0, m - 1, k);
+
+  return data[k * stride];
+}
+
+double
+FUNCTION (gsl_stats, median) (BASE data[], const size_t stride, const size_t n)
+{
+  const size_t lhs = (n - 1) / 2;
+  const size_t rhs = n / 2;
+
+  if (n == 0)
+    return 0.0;
+
+  if (FUNCTION (my, nan_partition) (data, stride, n) < n)
+    return GSL_NAN;
+
+  FUNCTION (my, select_range) (data, stride, 0, n - 1, lhs);
+
+  if (lhs == rhs)
+    {
+      return data[lhs * stride];
+    }
+  else
+    {
+      const BASE upper = FUNCTION (my, min_range) (data, stride, rhs, n - 1);
+      return (data[lhs * stride] + upper) / 2.0;
+    }
+}
+
+double
+FUNCTION (gsl_stats, quantile) (BASE data[], const size_t stride, const size_t n, const double f)
+{
+  double index, delta;
+  size_t lhs;
+
+  if (!(f >= 0.0 && f <= 1.0))
+    {
+      GSL_ERROR_VAL ("f must lie in [0,1]", GSL_EDOM, GSL_NAN);
+    }
+
+  if (n == 0)
+    return 0.0;
+
+  if (FUNCTION (my, nan_partition) (data, stride, n) < n)
+    return GSL_NAN;
+
+  index = f * (n - 1);
+  lhs = (size_t) index;
+  delta = index - lhs;
+
+  FUNCTION (my, select_range) (data, stride, 0, n - 1, lhs);
+
+  if (lhs == n - 1)
+    {
+      return data[lhs * stride];
+    }
+  else
+    {
+      const BASE upper = FUNCTION (my, min_range) (data, stride, lhs + 1, n - 1);
+      return (1 - delta) * data[lhs * stride] + delta * upper;
+    }
+}
+
+/* Place every order statistic needed by the quantiles f[] which falls
+   in data[lo..hi] in its sorted position. The rank nearest the middle
+   of the range is selected first, splitting it for the remaining
+   ranks on either side. */
+
+static void
+FUNCTION (my, multiselect) (BASE data[], const size_t stride, const size_t n,
+                            const double f[], const size_t nf,
+                            size_t lo, const size_t hi)
+{
+  for (;;)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      size_t i, r = 0, best = n;
+
+      for (i = 0; i < 2 * nf; i++)
+        {
+          size_t ri = (size_t) (f[i / 2] * (n - 1)) + i % 2;
+          size_t dist = (ri > mid) ? ri - mid : mid - ri;
+
+          if (ri >= lo && ri <= hi && ri < n && dist < best)
+            {
+              r = ri;
+              best = dist;
+            }
+        }
+
+      if (best == n)
+        return;
+
+      FUNCTION (my, select_range) (data, stride, lo, hi, r);
+
+      if (r > lo)
+        FUNCTION (my, multiselect) (data, stride, n, f, nf, lo, r - 1);
+
+      if (r == hi)
+        return;
+
+      lo = r + 1;
+    }
+}
+
+int
+FUNCTION (gsl_stats, quantiles) (BASE data[], const size_t stride, const size_t n,
+                                 const double f[], const size_t nf, double q[])
+{
+  size_t i;
+
+  for (i = 0; i < nf; i++)
+    {
+      if (!(f[i] >= 0.0 && f[i] <= 1.0))
+        {
+          GSL_ERROR ("f must lie in [0,1]", GSL_EDOM);
+        }
+    }
+
+  if (n == 0)
+    {
+      for (i = 0; i < nf; i++)
+        q[i] = 0.0;
+
+      return GSL_SUCCESS;
+    }
+
+  if (FUNCTION (my, nan_partition) (data, stride, n) < n)
+    {
+      for (i = 0; i < nf; i++)
+        q[i] = GSL_NAN;
+
+      return GSL_SUCCESS;
+    }
+
+  FUNCTION (my, multiselect) (data, stride, n, f, nf, 0, n - 1);
+
+  for (i = 0; i < nf; i++)
+    {
+      const double index = f[i] * (n - 1);
+      const size_t lhs = (size_t) index;
+      const double delta = index - lhs;
+
+      if (lhs == n - 1)
+        q[i] = data[lhs * stride];
+      else
+        q[i] = (1 - delta) * data[lhs * stride] + delta * data[(lhs + 1) * stride];
+    }
+
+  return GSL_SUCCESS;
+}
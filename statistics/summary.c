@@ -0,0 +1,199 @@
+/* statistics/summary.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Descriptive statistics in a single pass over the data.
+
+   The data are processed in blocks small enough to stay in cache. The
+   mean, extrema and central moment sums of each block are found with
+   two short loops over the block, which have no dependence between
+   iterations other than the sums and can be vectorized by the
+   compiler. The block totals are then combined with the running
+   totals using the pairwise update formulas of
+
+     T. F. Chan, G. H. Golub and R. J. LeVeque, "Updating formulae and
+     a pairwise algorithm for computing sample variances", COMPSTAT
+     1982, and P. Pebay, "Formulas for robust, one-pass parallel
+     computation of covariances and arbitrary-order statistical
+     moments", Sandia Report SAND2008-6212 (2008).
+
+   The same update merges the summaries of separate parts of a
+   dataset, for example parts processed by different threads. */
+
+#include <config.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_statistics.h>
+
+#define SUMMARY_BLOCK 256
+
+static int
+summary_isnan (const double x)
+{
+  return x != x;
+}
+
+/* combine the moment sums of t with those of s */
+
+static void
+summary_combine (gsl_stats_summary_t * s, const gsl_stats_summary_t * t)
+{
+  double na, nb, n, delta, delta_n, M2, M3, M4;
+
+  if (t->n == 0)
+    return;
+
+  if (s->n == 0)
+    {
+      *s = *t;
+      return;
+    }
+
+  if (!summary_isnan (s->min) && (t->min < s->min || summary_isnan (t->min)))
+    s->min = t->min;
+
+  if (!summary_isnan (s->max) && (t->max > s->max || summary_isnan (t->max)))
+    s->max = t->max;
+
+  na = (double) s->n;
+  nb = (double) t->n;
+  n = na + nb;
+  delta = t->mean - s->mean;
+  delta_n = delta / n;
+
+  M2 = s->M2 + t->M2 + delta * delta_n * na * nb;
+  M3 = s->M3 + t->M3 + delta * delta_n * delta_n * na * nb * (na - nb)
+    + 3.0 * delta_n * (na * t->M2 - nb * s->M2);
+  M4 = s->M4 + t->M4
+    + delta * delta_n * delta_n * delta_n * na * nb * (na * na - na * nb + nb * nb)
+    + 6.0 * delta_n * delta_n * (na * na * t->M2 + nb * nb * s->M2)
+    + 4.0 * delta_n * (na * t->M3 - nb * s->M3);
+
+  s->n += t->n;
+  s->mean += delta_n * nb;
+  s->M2 = M2;
+  s->M3 = M3;
+  s->M4 = M4;
+}
+
+/* compute the derived statistics from the moment sums, with the same
+   definitions as gsl_stats_variance, gsl_stats_skew and
+   gsl_stats_kurtosis */
+
+static void
+summary_finish (gsl_stats_summary_t * s)
+{
+  const double n = (double) s->n;
+
+  if (s->n == 0)
+    {
+      s->variance = 0.0;
+      s->sd = 0.0;
+      s->skew = 0.0;
+      s->kurtosis = 0.0;
+      return;
+    }
+
+  s->variance = (s->n > 1) ? s->M2 / (n - 1.0) : 0.0;
+  s->sd = sqrt (s->variance);
+
+  if (s->sd > 0.0)
+    {
+      s->skew = s->M3 / (n * s->variance * s->sd);
+      s->kurtosis = s->M4 / (n * s->variance * s->variance) - 3.0;
+    }
+  else
+    {
+      s->skew = GSL_NAN;
+      s->kurtosis = GSL_NAN;
+    }
+}
+
+int
+gsl_stats_summary_merge (gsl_stats_summary_t * s, const gsl_stats_summary_t * t)
+{
+  summary_combine (s, t);
+  summary_finish (s);
+
+  return GSL_SUCCESS;
+}
+
+#define BASE_LONG_DOUBLE
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_LONG_DOUBLE
+
+#define BASE_DOUBLE
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_DOUBLE
+
+#define BASE_FLOAT
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_FLOAT
+
+#define BASE_ULONG
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_ULONG
+
+#define BASE_LONG
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_LONG
+
+#define BASE_UINT
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_UINT
+
+#define BASE_INT
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_INT
+
+#define BASE_USHORT
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_USHORT
+
+#define BASE_SHORT
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_SHORT
+
+#define BASE_UCHAR
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_UCHAR
+
+#define BASE_CHAR
+#include "templates_on.h"
+#include "summary_source.c"
+#include "templates_off.h"
+#undef  BASE_CHAR
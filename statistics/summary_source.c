@@ -0,0 +1,107 @@
+/* statistics/summary_source.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+int
+FUNCTION (gsl_stats, summary) (gsl_stats_summary_t * s, const BASE data[],
+                               const size_t stride, const size_t n)
+{
+  double shift = 0.0;
+  size_t i;
+
+  s->n = 0;
+  s->min = 0.0;
+  s->max = 0.0;
+  s->mean = 0.0;
+  s->M2 = 0.0;
+  s->M3 = 0.0;
+  s->M4 = 0.0;
+
+  /* the moments are accumulated for the data less the first value,
+     so that a large common offset does not limit the precision of the
+     block means */
+
+  if (n > 0)
+    shift = data[0];
+
+#ifdef FP
+  if (!gsl_finite (shift))
+    shift = 0.0;
+#endif
+
+  for (i = 0; i < n; i += SUMMARY_BLOCK)
+    {
+      const BASE *x = data + i * stride;
+      const size_t m = (n - i < SUMMARY_BLOCK) ? n - i : SUMMARY_BLOCK;
+      gsl_stats_summary_t b;
+      BASE min = x[0], max = x[0];
+      double sum = 0.0, M2 = 0.0, M3 = 0.0, M4 = 0.0, mean;
+      size_t j;
+
+      for (j = 0; j < m; j++)
+        {
+          const BASE xj = x[j * stride];
+          sum += xj - shift;
+          min = (xj < min) ? xj : min;
+          max = (xj > max) ? xj : max;
+        }
+
+      mean = sum / m;
+
+      for (j = 0; j < m; j++)
+        {
+          const double d = (x[j * stride] - shift) - mean;
+          const double d2 = d * d;
+          M2 += d2;
+          M3 += d2 * d;
+          M4 += d2 * d2;
+        }
+
+#ifdef FP
+      /* the comparisons above skip NaNs, check for them only if the
+         sum shows that something is wrong */
+
+      if (summary_isnan (sum))
+        {
+          for (j = 0; j < m; j++)
+            {
+              if (isnan (x[j * stride]))
+                {
+                  min = x[j * stride];
+                  max = min;
+                  break;
+                }
+            }
+        }
+#endif
+
+      b.n = m;
+      b.min = min;
+      b.max = max;
+      b.mean = mean;
+      b.M2 = M2;
+      b.M3 = M3;
+      b.M4 = M4;
+
+      summary_combine (s, &b);
+    }
+
+  s->mean += shift;
+
+  summary_finish (s);
+
+  return GSL_SUCCESS;
+}
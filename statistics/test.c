@@ -27,6 +27,7 @@
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_sort_vector.h>
 #include <gsl/gsl_statistics.h>
+#include <gsl/gsl_statistics_matrix.h>
 #include <gsl/gsl_ieee_utils.h>
 
 int test_nist (void);
@@ -100,6 +101,397 @@ int test_nist (void);
 #undef  BASE_CHAR
 
 
+/* compare selection with sorting for larger inputs of various shapes */
+
+static void
+test_select (const size_t n)
+{
+  const double f[7] = { 0.99, 0.01, 0.5, 0.5, 0.25, 1.0, 0.0 };
+  double *data = (double *) malloc (n * sizeof (double));
+  double *sorted = (double *) malloc (n * sizeof (double));
+  double *work = (double *) malloc (n * sizeof (double));
+  unsigned long int seed = 1;
+  double q[7];
+  int pattern;
+
+  for (pattern = 0; pattern < 6; pattern++)
+    {
+      int status = 0;
+      size_t i, k;
+
+      for (i = 0; i < n; i++)
+        {
+          seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+
+          switch (pattern)
+            {
+            case 0:             /* random */
+              data[i] = seed / 2147483648.0;
+              break;
+            case 1:             /* sorted */
+              data[i] = i;
+              break;
+            case 2:             /* reversed */
+              data[i] = n - i;
+              break;
+            case 3:             /* organ pipe */
+              data[i] = (i < n / 2) ? i : n - i;
+              break;
+            case 4:             /* few unique values */
+              data[i] = seed % 4;
+              break;
+            default:            /* sawtooth */
+              data[i] = i % 17;
+            }
+        }
+
+      memcpy (sorted, data, n * sizeof (double));
+      gsl_sort (sorted, 1, n);
+
+      for (k = 0; k < n; k += 1 + n / 50)
+        {
+          double x;
+
+          memcpy (work, data, n * sizeof (double));
+          x = gsl_stats_select (work, 1, n, k);
+          status |= (x != sorted[k]);
+
+          for (i = 0; i < n; i++)
+            status |= (i < k) ? (work[i] > x) : (i > k) ? (work[i] < x) : 0;
+        }
+
+      gsl_test (status, "gsl_stats_select, n = %u, pattern %d", n, pattern);
+
+      memcpy (work, data, n * sizeof (double));
+      gsl_test_rel (gsl_stats_median (work, 1, n),
+                    gsl_stats_median_from_sorted_data (sorted, 1, n), 1e-15,
+                    "gsl_stats_median, n = %u, pattern %d", n, pattern);
+
+      memcpy (work, data, n * sizeof (double));
+      gsl_stats_quantiles (work, 1, n, f, 7, q);
+
+      for (k = 0; k < 7; k++)
+        {
+          gsl_test_rel (q[k], gsl_stats_quantile_from_sorted_data (sorted, 1, n, f[k]),
+                        1e-15, "gsl_stats_quantiles, n = %u, pattern %d, f = %g",
+                        n, pattern, f[k]);
+        }
+    }
+
+  free (data);
+  free (sorted);
+  free (work);
+}
+
+/* accuracy of the summary for data with a large offset, computed in
+   one pass and by merging the summaries of unequal chunks */
+
+static void
+test_summary (const size_t n)
+{
+  double *data = (double *) malloc (n * sizeof (double));
+  unsigned long int seed = 1;
+  long double mean = 0, M2 = 0, M3 = 0, M4 = 0;
+  gsl_stats_summary_t s, t;
+  size_t i, c;
+  int pass;
+
+  for (i = 0; i < n; i++)
+    {
+      double u;
+      seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+      u = seed / 2147483648.0;
+      data[i] = 1e9 + u * u;
+    }
+
+  for (i = 0; i < n; i++)
+    mean += data[i];
+
+  mean /= n;
+
+  for (i = 0; i < n; i++)
+    {
+      const long double d = data[i] - mean;
+      M2 += d * d;
+      M3 += d * d * d;
+      M4 += d * d * d * d;
+    }
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      const char *desc = (pass == 0) ? "" : " (merged)";
+      const double var = M2 / (n - 1);
+
+      if (pass == 0)
+        {
+          gsl_stats_summary (&s, data, 1, n);
+        }
+      else
+        {
+          gsl_stats_summary (&s, data, 1, 0);
+
+          for (i = 0, c = 1; i < n; i += c, c = 3 * c + 1)
+            {
+              gsl_stats_summary (&t, data + i, 1, (i + c < n) ? c : n - i);
+              gsl_stats_summary_merge (&s, &t);
+            }
+        }
+
+      gsl_test_rel (s.mean, mean, 1e-15, "gsl_stats_summary mean, n = %u%s", n, desc);
+      gsl_test_rel (s.variance, var, 1e-9, "gsl_stats_summary variance, n = %u%s", n, desc);
+      gsl_test_rel (s.skew, M3 / (n * var * sqrt (var)), 1e-6,
+                    "gsl_stats_summary skew, n = %u%s", n, desc);
+      gsl_test_rel (s.kurtosis, M4 / (n * var * var) - 3.0, 1e-6,
+                    "gsl_stats_summary kurtosis, n = %u%s", n, desc);
+    }
+
+  data[n / 2] = GSL_NAN;
+  gsl_stats_summary (&s, data, 1, n);
+  gsl_test (!gsl_isnan (s.mean) || !gsl_isnan (s.min) || !gsl_isnan (s.max),
+            "gsl_stats_summary NaN, n = %u", n);
+
+  free (data);
+}
+
+/* compare the moving window statistics, computed online and in
+   batch, with the statistics of each window found from scratch */
+
+static void
+test_window (const size_t n, const size_t window)
+{
+  double *data = (double *) malloc (n * sizeof (double));
+  double *work = (double *) malloc (window * sizeof (double));
+  double *mean = (double *) malloc (n * sizeof (double));
+  double *var = (double *) malloc (n * sizeof (double));
+  double *min = (double *) malloc (n * sizeof (double));
+  double *max = (double *) malloc (n * sizeof (double));
+  double *median = (double *) malloc (n * sizeof (double));
+  gsl_stats_window *w = gsl_stats_window_alloc (window, 0.9);
+  unsigned long int seed = 1;
+  int pattern;
+
+  for (pattern = 0; pattern < 6; pattern++)
+    {
+      int status = 0;
+      size_t i;
+
+      for (i = 0; i < n; i++)
+        {
+          seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+
+          switch (pattern)
+            {
+            case 0:             /* random */
+              data[i] = seed / 2147483648.0;
+              break;
+            case 1:             /* sorted */
+              data[i] = i;
+              break;
+            case 2:             /* reversed */
+              data[i] = n - i;
+              break;
+            case 3:             /* few unique values */
+              data[i] = seed % 4;
+              break;
+            case 4:             /* sawtooth */
+              data[i] = i % 17;
+              break;
+            default:            /* random walk with a large offset */
+              data[i] = (i == 0) ? 1e6 : data[i - 1] + seed / 2147483648.0 - 0.5;
+            }
+        }
+
+      gsl_stats_moving_mean (data, 1, n, window, mean);
+      gsl_stats_moving_variance (data, 1, n, window, var);
+      gsl_stats_moving_minmax (data, 1, n, window, min, max);
+      gsl_stats_moving_median (data, 1, n, window, median);
+      gsl_stats_window_reset (w);
+
+      for (i = 0; i < n; i++)
+        {
+          const size_t m = (i + 1 < window) ? i + 1 : window;
+          const double *x = data + i + 1 - m;
+          double emean, evar, emin, emax;
+
+          gsl_stats_window_push (data[i], w);
+
+          memcpy (work, x, m * sizeof (double));
+          gsl_sort (work, 1, m);
+
+          emean = gsl_stats_mean (x, 1, m);
+          evar = (m > 1) ? gsl_stats_variance (x, 1, m) : 0.0;
+          gsl_stats_minmax (&emin, &emax, x, 1, m);
+
+          status |= (gsl_stats_window_n (w) != m);
+          status |= (fabs (mean[i] - emean) > 1e-12 * fabs (emean));
+          status |= (fabs (var[i] - evar) > 1e-7 * evar + 1e-12);
+          status |= (min[i] != emin || max[i] != emax);
+          status |= (median[i] != gsl_stats_median_from_sorted_data (work, 1, m));
+
+          status |= (gsl_stats_window_mean (w) != mean[i]);
+          status |= (gsl_stats_window_variance (w) != var[i]);
+          status |= (gsl_stats_window_min (w) != emin);
+          status |= (gsl_stats_window_max (w) != emax);
+          status |= (gsl_stats_window_quantile (w) != gsl_stats_quantile_from_sorted_data (work, 1, m, 0.9));
+        }
+
+      gsl_test (status, "gsl_stats_window, n = %u, window = %u, pattern %d",
+                n, window, pattern);
+    }
+
+  gsl_stats_window_free (w);
+  free (data);
+  free (work);
+  free (mean);
+  free (var);
+  free (min);
+  free (max);
+  free (median);
+}
+
+/* compare the covariance and correlation matrices with the functions
+   for one pair of columns, with and without missing values */
+
+static void
+test_covmatrix (const size_t n, const size_t p)
+{
+  gsl_matrix *X = gsl_matrix_alloc (n, p);
+  gsl_matrix *C = gsl_matrix_alloc (p, p);
+  double *x = (double *) malloc (n * sizeof (double));
+  double *y = (double *) malloc (n * sizeof (double));
+  double *work = (double *) malloc (2 * n * sizeof (double));
+  unsigned long int seed = 1;
+  size_t i, j, k;
+  int status;
+
+  /* correlated columns with different offsets and scales, and ties
+     in the last column */
+
+  for (i = 0; i < n; i++)
+    {
+      double common;
+
+      seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+      common = seed / 2147483648.0;
+
+      for (j = 0; j < p; j++)
+        {
+          double u;
+
+          seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+          u = seed / 2147483648.0;
+
+          if (j == p - 1)
+            gsl_matrix_set (X, i, j, floor (4.0 * u));
+          else
+            gsl_matrix_set (X, i, j, 1e3 * j + (j + 1.0) * (u + j * common / p));
+        }
+    }
+
+  gsl_stats_covariance_matrix (X, C);
+  status = 0;
+  for (j = 0; j < p; j++)
+    for (k = 0; k < p; k++)
+      status |= (fabs (gsl_matrix_get (C, j, k)
+                       - gsl_stats_covariance (X->data + j, p, X->data + k, p, n))
+                 > 1e-10 * sqrt (gsl_matrix_get (C, j, j) * gsl_matrix_get (C, k, k)));
+  gsl_test (status, "gsl_stats_covariance_matrix, n = %u, p = %u", n, p);
+
+  gsl_stats_correlation_matrix (X, C);
+  status = 0;
+  for (j = 0; j < p; j++)
+    for (k = 0; k < p; k++)
+      status |= (fabs (gsl_matrix_get (C, j, k)
+                       - gsl_stats_correlation (X->data + j, p, X->data + k, p, n)) > 1e-10);
+  gsl_test (status, "gsl_stats_correlation_matrix, n = %u, p = %u", n, p);
+
+  gsl_stats_spearman_matrix (X, C);
+  status = 0;
+  for (j = 0; j < p; j++)
+    for (k = 0; k < p; k++)
+      status |= (fabs (gsl_matrix_get (C, j, k)
+                       - gsl_stats_spearman (X->data + j, p, X->data + k, p, n, work)) > 1e-10);
+  gsl_test (status, "gsl_stats_spearman_matrix, n = %u, p = %u", n, p);
+
+  /* without missing values the pairwise estimates are the same */
+
+  gsl_stats_correlation_matrix_pairwise (X, C);
+  status = 0;
+  for (j = 0; j < p; j++)
+    for (k = 0; k < p; k++)
+      status |= (fabs (gsl_matrix_get (C, j, k)
+                       - gsl_stats_correlation (X->data + j, p, X->data + k, p, n)) > 1e-10);
+  gsl_test (status, "gsl_stats_correlation_matrix_pairwise, n = %u, p = %u, complete", n, p);
+
+  /* remove about a tenth of the values */
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < p; j++)
+        {
+          seed = (1103515245 * seed + 12345) & 0x7fffffffUL;
+          if (seed % 10 == 0)
+            gsl_matrix_set (X, i, j, GSL_NAN);
+        }
+    }
+
+  for (k = 0; k < 2; k++)
+    {
+      const char *name = (k == 0) ? "covariance" : "correlation";
+      size_t a, b;
+
+      if (k == 0)
+        gsl_stats_covariance_matrix_pairwise (X, C);
+      else
+        gsl_stats_correlation_matrix_pairwise (X, C);
+
+      status = 0;
+
+      for (a = 0; a < p; a++)
+        {
+          for (b = 0; b < p; b++)
+            {
+              size_t m = 0;
+              double expected, tol;
+
+              for (i = 0; i < n; i++)
+                {
+                  const double xa = gsl_matrix_get (X, i, a);
+                  const double xb = gsl_matrix_get (X, i, b);
+
+                  if (!gsl_isnan (xa) && !gsl_isnan (xb))
+                    {
+                      x[m] = xa;
+                      y[m] = xb;
+                      m++;
+                    }
+                }
+
+              if (k == 0)
+                {
+                  expected = gsl_stats_covariance (x, 1, y, 1, m);
+                  tol = 1e-10 * gsl_stats_sd (x, 1, m) * gsl_stats_sd (y, 1, m);
+                }
+              else
+                {
+                  expected = (a == b) ? 1.0 : gsl_stats_correlation (x, 1, y, 1, m);
+                  tol = 1e-10;
+                }
+
+              status |= (fabs (gsl_matrix_get (C, a, b) - expected) > tol);
+            }
+        }
+
+      gsl_test (status, "gsl_stats_%s_matrix_pairwise, n = %u, p = %u", name, n, p);
+    }
+
+  gsl_matrix_free (X);
+  gsl_matrix_free (C);
+  free (x);
+  free (y);
+  free (work);
+}
+
 int
 main (void)
 {
@@ -125,6 +517,21 @@ main (void)
       test_char_func (s1,s2);
     }
 
+  test_select (1000);
+  test_select (20001);
+
+  test_summary (1000);
+  test_summary (100000);
+
+  test_window (2000, 1);
+  test_window (2000, 2);
+  test_window (2000, 37);
+  test_window (3000, 256);
+  test_window (100, 1000);
+
+  test_covmatrix (10, 3);
+  test_covmatrix (1000, 17);
+
   test_nist();
 
   exit (gsl_test_summary ());
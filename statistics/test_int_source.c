@@ -17,6 +17,117 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+void FUNCTION (test, summary_func) (const BASE data[], const size_t stride, const size_t n, const double rel);
+
+/* compare the single pass summary, and the merged summaries of two
+   parts of the data, with the individual statistics functions */
+
+void
+FUNCTION (test, summary_func) (const BASE data[], const size_t stride, const size_t n, const double rel)
+{
+  gsl_stats_summary_t s, t;
+  int pass;
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      const char *desc = (pass == 0) ? "" : " (merged)";
+
+      if (pass == 0)
+        {
+          FUNCTION(gsl_stats,summary) (&s, data, stride, n);
+        }
+      else
+        {
+          FUNCTION(gsl_stats,summary) (&s, data, stride, n / 3);
+          FUNCTION(gsl_stats,summary) (&t, data + (n / 3) * stride, stride, n - n / 3);
+          gsl_stats_summary_merge (&s, &t);
+        }
+
+      gsl_test (s.n != n, NAME(gsl_stats) "_summary n%s", desc);
+      gsl_test_rel (s.mean, FUNCTION(gsl_stats,mean) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary mean%s", desc);
+      gsl_test_rel (s.variance, FUNCTION(gsl_stats,variance) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary variance%s", desc);
+      gsl_test_rel (s.sd, FUNCTION(gsl_stats,sd) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary sd%s", desc);
+      gsl_test_rel (s.skew, FUNCTION(gsl_stats,skew) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary skew%s", desc);
+      gsl_test_rel (s.kurtosis, FUNCTION(gsl_stats,kurtosis) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary kurtosis%s", desc);
+      gsl_test_rel (s.min, FUNCTION(gsl_stats,min) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary min%s", desc);
+      gsl_test_rel (s.max, FUNCTION(gsl_stats,max) (data, stride, n), rel,
+                    NAME(gsl_stats) "_summary max%s", desc);
+    }
+}
+
+void FUNCTION (test, window_func) (const BASE data[], const size_t stride, const size_t n, const size_t window, const double rel);
+
+/* compare the moving window statistics, computed online and in batch,
+   with the statistics of each window */
+
+void
+FUNCTION (test, window_func) (const BASE data[], const size_t stride, const size_t n, const size_t window, const double rel)
+{
+  double *mean = (double *) malloc (n * sizeof (double));
+  double *var = (double *) malloc (n * sizeof (double));
+  double *median = (double *) malloc (n * sizeof (double));
+  BASE *min = (BASE *) malloc (n * sizeof (BASE));
+  BASE *max = (BASE *) malloc (n * sizeof (BASE));
+  BASE *sorted = (BASE *) malloc (window * sizeof (BASE));
+  FUNCTION (gsl_stats, window) *w = FUNCTION (gsl_stats, window_alloc) (window, 0.5);
+  size_t i, j;
+
+  FUNCTION (gsl_stats, moving_mean) (data, stride, n, window, mean);
+  FUNCTION (gsl_stats, moving_variance) (data, stride, n, window, var);
+  FUNCTION (gsl_stats, moving_minmax) (data, stride, n, window, min, max);
+  FUNCTION (gsl_stats, moving_median) (data, stride, n, window, median);
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t m = (i + 1 < window) ? i + 1 : window;
+      const BASE *x = data + (i + 1 - m) * stride;
+      BASE emin, emax;
+      double emedian;
+
+      FUNCTION (gsl_stats, window_push) (data[i * stride], w);
+
+      for (j = 0; j < m; j++)
+        sorted[j] = x[j * stride];
+
+      TYPE (gsl_sort) (sorted, 1, m);
+      emedian = FUNCTION (gsl_stats, median_from_sorted_data) (sorted, 1, m);
+      FUNCTION (gsl_stats, minmax) (&emin, &emax, x, stride, m);
+
+      gsl_test_rel (mean[i], FUNCTION (gsl_stats, mean) (x, stride, m), rel,
+                    NAME (gsl_stats) "_moving_mean i=%u", i);
+      gsl_test_rel (var[i], (m > 1) ? FUNCTION (gsl_stats, variance) (x, stride, m) : 0.0, rel,
+                    NAME (gsl_stats) "_moving_variance i=%u", i);
+      gsl_test (min[i] != emin || max[i] != emax,
+                NAME (gsl_stats) "_moving_minmax i=%u", i);
+      gsl_test_rel (median[i], emedian, rel,
+                    NAME (gsl_stats) "_moving_median i=%u", i);
+
+      gsl_test_rel (FUNCTION (gsl_stats, window_mean) (w), mean[i], rel,
+                    NAME (gsl_stats) "_window_mean i=%u", i);
+      gsl_test_rel (FUNCTION (gsl_stats, window_sd) (w), sqrt (var[i]), rel,
+                    NAME (gsl_stats) "_window_sd i=%u", i);
+      gsl_test (FUNCTION (gsl_stats, window_min) (w) != emin
+                || FUNCTION (gsl_stats, window_max) (w) != emax,
+                NAME (gsl_stats) "_window_min/max i=%u", i);
+      gsl_test_rel (FUNCTION (gsl_stats, window_quantile) (w), emedian, rel,
+                    NAME (gsl_stats) "_window_quantile i=%u", i);
+    }
+
+  FUNCTION (gsl_stats, window_free) (w);
+  free (mean);
+  free (var);
+  free (median);
+  free (min);
+  free (max);
+  free (sorted);
+}
+
 void FUNCTION (test, func) (const size_t stridea, const size_t strideb);
 
 void
@@ -208,6 +319,9 @@ FUNCTION (test, func) (const size_t stridea, const size_t strideb)
   }
 
 
+  FUNCTION (test, summary_func) (igroupa, stridea, ina, rel);
+  FUNCTION (test, window_func) (igroupa, stridea, ina, 4, rel);
+
   sorted = (BASE *) malloc(stridea * ina * sizeof(BASE)) ;
 
   for (i = 0 ; i < ina ; i++)
@@ -259,6 +373,75 @@ FUNCTION (test, func) (const size_t stridea, const size_t strideb)
                   NAME(gsl_stats) "_quantile_from_sorted_data (50, odd)");
   }
 
+  {
+    /* in-place selection on unsorted copies of the data */
+    BASE * work = (BASE *) malloc(stridea * ina * sizeof(BASE));
+    const double f[6] = { 0.9, 0.0, 0.5, 0.25, 1.0, 0.5 };
+    double q[6];
+    int status = 0;
+    size_t k;
+
+    for (k = 0 ; k < ina ; k++)
+      {
+        BASE x;
+
+        for (i = 0 ; i < ina ; i++)
+          work[stridea * i] = igroupa[stridea * i] ;
+
+        x = FUNCTION(gsl_stats,select)(work, stridea, ina, k) ;
+        status |= (x != sorted[stridea * k]) ;
+
+        for (i = 0 ; i < k ; i++)
+          status |= (work[stridea * i] > x) ;
+
+        for (i = k + 1 ; i < ina ; i++)
+          status |= (work[stridea * i] < x) ;
+      }
+
+    gsl_test (status, NAME(gsl_stats) "_select");
+
+    for (i = 0 ; i < ina ; i++)
+      work[stridea * i] = igroupa[stridea * i] ;
+
+    {
+      double median = FUNCTION(gsl_stats,median)(work, stridea, ina) ;
+      double expected = FUNCTION(gsl_stats,median_from_sorted_data)(sorted, stridea, ina) ;
+      gsl_test_rel (median, expected, rel, NAME(gsl_stats) "_median (even)");
+    }
+
+    for (i = 0 ; i < ina ; i++)
+      work[stridea * i] = igroupa[stridea * i] ;
+
+    {
+      double median = FUNCTION(gsl_stats,median)(work, stridea, ina - 1) ;
+      double expected = 18;
+      gsl_test_rel (median, expected, rel, NAME(gsl_stats) "_median (odd)");
+    }
+
+    for (i = 0 ; i < ina ; i++)
+      work[stridea * i] = igroupa[stridea * i] ;
+
+    {
+      double quantile = FUNCTION(gsl_stats,quantile)(work, stridea, ina, 0.25) ;
+      double expected = FUNCTION(gsl_stats,quantile_from_sorted_data)(sorted, stridea, ina, 0.25) ;
+      gsl_test_rel (quantile, expected, rel, NAME(gsl_stats) "_quantile (25)");
+    }
+
+    for (i = 0 ; i < ina ; i++)
+      work[stridea * i] = igroupa[stridea * i] ;
+
+    FUNCTION(gsl_stats,quantiles)(work, stridea, ina, f, 6, q) ;
+
+    for (k = 0 ; k < 6 ; k++)
+      {
+        double expected = FUNCTION(gsl_stats,quantile_from_sorted_data)(sorted, stridea, ina, f[k]) ;
+        gsl_test_rel (q[k], expected, rel,
+                      NAME(gsl_stats) "_quantiles (%g)", f[k]);
+      }
+
+    free (work);
+  }
+
   free (sorted);
   free (igroupa);
   free (igroupb);
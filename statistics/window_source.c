@@ -0,0 +1,611 @@
+/* statistics/window_source.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Statistics of the last 'size' values of a stream.
+
+   The values are kept in a ring buffer, the value at position t of
+   the stream being stored in slot t % size. When the window is full
+   each new value replaces the oldest one in its slot.
+
+   The mean and the sum of squared deviations M2 are updated in O(1)
+   operations, and recomputed from the buffer in two passes once
+   every 'size' values, which costs O(1) per value on average and
+   keeps rounding errors from accumulating.
+
+   The minimum and maximum are the first entries of two monotonic
+   deques of (position, value) pairs, with increasing values for the
+   minimum and decreasing values for the maximum, so each value enters
+   and leaves each deque once.
+
+   The order statistic of rank lhs = floor(f (n - 1)) and the one
+   above it are found from two heaps of slots dividing the window, a
+   max-heap 'lo' holding the lhs + 1 smallest values and a min-heap
+   'hi' holding the others. pos[slot] records the place of each slot
+   in the heaps, so that the oldest value can be replaced in place and
+   sifted to its new position in O(log size) operations. */
+
+#define WINDOW_T FUNCTION (gsl_stats, window)
+
+static void
+FUNCTION (my, moments_add) (double *mean, double *M2, const size_t m, const double x)
+{
+  const double delta = x - *mean;
+
+  *mean += delta / m;
+  *M2 += delta * (x - *mean);
+}
+
+/* replace the value x_old by x in a window of m values */
+
+static void
+FUNCTION (my, moments_replace) (double *mean, double *M2, const size_t m,
+                                const double x, const double x_old)
+{
+  const double mean_old = *mean;
+  const double delta = x - x_old;
+
+  *mean += delta / m;
+  *M2 += delta * ((x - *mean) + (x_old - mean_old));
+}
+
+static void
+FUNCTION (my, moments_exact) (double *mean, double *M2, const BASE data[],
+                              const size_t stride, const size_t m)
+{
+  double sum = 0.0, sum2 = 0.0;
+  size_t i;
+
+  for (i = 0; i < m; i++)
+    sum += data[i * stride];
+
+  *mean = sum / m;
+
+  for (i = 0; i < m; i++)
+    {
+      const double delta = data[i * stride] - *mean;
+      sum2 += delta * delta;
+    }
+
+  *M2 = sum2;
+}
+
+static double
+FUNCTION (my, moments_variance) (const double M2, const size_t m)
+{
+  if (m < 2 || M2 < 0.0)
+    return 0.0;
+
+  return M2 / (m - 1);
+}
+
+/* add the value x at position t to a monotonic deque of capacity
+   'window', stored circularly as positions q[] and values qv[], after
+   dropping the position t - window which leaves the window. For
+   sign > 0 the deque holds decreasing values (maximum first),
+   otherwise increasing values (minimum first). */
+
+static void
+FUNCTION (my, deque_push) (size_t q[], BASE qv[], size_t * head, size_t * len,
+                           const size_t window, const BASE x, const size_t t,
+                           const int sign)
+{
+  size_t back;
+
+  if (*len > 0 && q[*head] + window <= t)
+    {
+      if (++(*head) == window)
+        *head = 0;
+      (*len)--;
+    }
+
+  back = *head + *len;
+  if (back >= window)
+    back -= window;
+
+  while (*len > 0)
+    {
+      const size_t prev = (back == 0) ? window - 1 : back - 1;
+      const BASE y = qv[prev];
+
+      if ((sign > 0) ? (y <= x) : (x <= y))
+        {
+          back = prev;
+          (*len)--;
+        }
+      else
+        break;
+    }
+
+  q[back] = t;
+  qv[back] = x;
+  (*len)++;
+}
+
+/* nonzero if slot a belongs above slot b in the max-heap (max != 0)
+   or the min-heap */
+
+static inline int
+FUNCTION (my, heap_before) (const WINDOW_T * w, const int max, const size_t a, const size_t b)
+{
+  return max ? (w->x[b] < w->x[a]) : (w->x[a] < w->x[b]);
+}
+
+static void
+FUNCTION (my, heap_fix) (WINDOW_T * w, const int max, size_t i)
+{
+  size_t *h = max ? w->lo : w->hi;
+  const size_t m = max ? w->nlo : w->nhi;
+  const size_t off = max ? 0 : w->size;
+
+  while (i > 0)
+    {
+      const size_t p = (i - 1) / 2;
+
+      if (!FUNCTION (my, heap_before) (w, max, h[i], h[p]))
+        break;
+
+      {
+        size_t tmp = h[i];
+        h[i] = h[p];
+        h[p] = tmp;
+        w->pos[h[i]] = off + i;
+        w->pos[h[p]] = off + p;
+      }
+
+      i = p;
+    }
+
+  for (;;)
+    {
+      const size_t c = 2 * i + 1;
+      size_t best = i;
+
+      if (c < m && FUNCTION (my, heap_before) (w, max, h[c], h[best]))
+        best = c;
+      if (c + 1 < m && FUNCTION (my, heap_before) (w, max, h[c + 1], h[best]))
+        best = c + 1;
+
+      if (best == i)
+        break;
+
+      {
+        size_t tmp = h[i];
+        h[i] = h[best];
+        h[best] = tmp;
+        w->pos[h[i]] = off + i;
+        w->pos[h[best]] = off + best;
+      }
+
+      i = best;
+    }
+}
+
+static void
+FUNCTION (my, heap_insert) (WINDOW_T * w, const int max, const size_t slot)
+{
+  if (max)
+    {
+      w->lo[w->nlo] = slot;
+      w->pos[slot] = w->nlo;
+      w->nlo++;
+      FUNCTION (my, heap_fix) (w, 1, w->nlo - 1);
+    }
+  else
+    {
+      w->hi[w->nhi] = slot;
+      w->pos[slot] = w->size + w->nhi;
+      w->nhi++;
+      FUNCTION (my, heap_fix) (w, 0, w->nhi - 1);
+    }
+}
+
+static size_t
+FUNCTION (my, heap_pop) (WINDOW_T * w, const int max)
+{
+  size_t *h = max ? w->lo : w->hi;
+  size_t *m = max ? &w->nlo : &w->nhi;
+  const size_t top = h[0];
+
+  (*m)--;
+
+  if (*m > 0)
+    {
+      h[0] = h[*m];
+      w->pos[h[0]] = max ? 0 : w->size;
+      FUNCTION (my, heap_fix) (w, max, 0);
+    }
+
+  return top;
+}
+
+/* restore the order between the heaps after the value of one slot
+   has changed, by exchanging their tops if needed */
+
+static void
+FUNCTION (my, heap_order) (WINDOW_T * w)
+{
+  if (w->nlo > 0 && w->nhi > 0 && w->x[w->hi[0]] < w->x[w->lo[0]])
+    {
+      const size_t a = w->lo[0], b = w->hi[0];
+
+      w->lo[0] = b;
+      w->pos[b] = 0;
+      w->hi[0] = a;
+      w->pos[a] = w->size;
+
+      FUNCTION (my, heap_fix) (w, 1, 0);
+      FUNCTION (my, heap_fix) (w, 0, 0);
+    }
+}
+
+/* move tops between the heaps until lo holds floor(f (n - 1)) + 1
+   values */
+
+static void
+FUNCTION (my, heap_balance) (WINDOW_T * w)
+{
+  const size_t target = (size_t) (w->f * (w->n - 1)) + 1;
+
+  while (w->nlo > target)
+    FUNCTION (my, heap_insert) (w, 0, FUNCTION (my, heap_pop) (w, 1));
+
+  while (w->nlo < target)
+    FUNCTION (my, heap_insert) (w, 1, FUNCTION (my, heap_pop) (w, 0));
+}
+
+WINDOW_T *
+FUNCTION (gsl_stats, window_alloc) (const size_t size, const double f)
+{
+  WINDOW_T *w;
+
+  if (size == 0)
+    {
+      GSL_ERROR_NULL ("window size must be positive", GSL_EINVAL);
+    }
+
+  if (!(f >= 0.0 && f <= 1.0))
+    {
+      GSL_ERROR_NULL ("f must lie in [0,1]", GSL_EDOM);
+    }
+
+  w = (WINDOW_T *) calloc (1, sizeof (WINDOW_T));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for window struct", GSL_ENOMEM);
+    }
+
+  w->size = size;
+  w->f = f;
+  w->x = (BASE *) malloc (size * sizeof (BASE));
+  w->minq = (size_t *) malloc (size * sizeof (size_t));
+  w->maxq = (size_t *) malloc (size * sizeof (size_t));
+  w->minv = (BASE *) malloc (size * sizeof (BASE));
+  w->maxv = (BASE *) malloc (size * sizeof (BASE));
+  w->lo = (size_t *) malloc (size * sizeof (size_t));
+  w->hi = (size_t *) malloc (size * sizeof (size_t));
+  w->pos = (size_t *) malloc (size * sizeof (size_t));
+
+  if (w->x == 0 || w->minq == 0 || w->maxq == 0 || w->minv == 0
+      || w->maxv == 0 || w->lo == 0 || w->hi == 0 || w->pos == 0)
+    {
+      FUNCTION (gsl_stats, window_free) (w);
+      GSL_ERROR_NULL ("failed to allocate space for window", GSL_ENOMEM);
+    }
+
+  FUNCTION (gsl_stats, window_reset) (w);
+
+  return w;
+}
+
+void
+FUNCTION (gsl_stats, window_free) (WINDOW_T * w)
+{
+  RETURN_IF_NULL (w);
+  free (w->x);
+  free (w->minq);
+  free (w->maxq);
+  free (w->minv);
+  free (w->maxv);
+  free (w->lo);
+  free (w->hi);
+  free (w->pos);
+  free (w);
+}
+
+int
+FUNCTION (gsl_stats, window_reset) (WINDOW_T * w)
+{
+  w->n = 0;
+  w->count = 0;
+  w->mean = 0.0;
+  w->M2 = 0.0;
+  w->min_head = 0;
+  w->min_len = 0;
+  w->max_head = 0;
+  w->max_len = 0;
+  w->nlo = 0;
+  w->nhi = 0;
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION (gsl_stats, window_push) (const BASE x, WINDOW_T * w)
+{
+  const size_t size = w->size;
+  const size_t t = w->count;
+  const size_t slot = t % size;
+
+  if (w->n < size)
+    {
+      w->x[slot] = x;
+      w->n++;
+      FUNCTION (my, moments_add) (&w->mean, &w->M2, w->n, x);
+
+      if (w->nlo > 0 && x < w->x[w->lo[0]])
+        FUNCTION (my, heap_insert) (w, 1, slot);
+      else
+        FUNCTION (my, heap_insert) (w, 0, slot);
+
+      FUNCTION (my, heap_balance) (w);
+    }
+  else
+    {
+      const BASE x_old = w->x[slot];
+      const size_t p = w->pos[slot];
+
+      w->x[slot] = x;
+
+      if ((t + 1) % size == 0)
+        FUNCTION (my, moments_exact) (&w->mean, &w->M2, w->x, 1, size);
+      else
+        FUNCTION (my, moments_replace) (&w->mean, &w->M2, size, x, x_old);
+
+      if (p < size)
+        FUNCTION (my, heap_fix) (w, 1, p);
+      else
+        FUNCTION (my, heap_fix) (w, 0, p - size);
+
+      FUNCTION (my, heap_order) (w);
+    }
+
+  FUNCTION (my, deque_push) (w->minq, w->minv, &w->min_head, &w->min_len,
+                             size, x, t, -1);
+  FUNCTION (my, deque_push) (w->maxq, w->maxv, &w->max_head, &w->max_len,
+                             size, x, t, 1);
+
+  w->count++;
+
+  return GSL_SUCCESS;
+}
+
+size_t
+FUNCTION (gsl_stats, window_n) (const WINDOW_T * w)
+{
+  return w->n;
+}
+
+double
+FUNCTION (gsl_stats, window_mean) (const WINDOW_T * w)
+{
+  return w->mean;
+}
+
+double
+FUNCTION (gsl_stats, window_variance) (const WINDOW_T * w)
+{
+  return FUNCTION (my, moments_variance) (w->M2, w->n);
+}
+
+double
+FUNCTION (gsl_stats, window_sd) (const WINDOW_T * w)
+{
+  return sqrt (FUNCTION (my, moments_variance) (w->M2, w->n));
+}
+
+BASE
+FUNCTION (gsl_stats, window_min) (const WINDOW_T * w)
+{
+  if (w->n == 0)
+    return 0;
+
+  return w->minv[w->min_head];
+}
+
+BASE
+FUNCTION (gsl_stats, window_max) (const WINDOW_T * w)
+{
+  if (w->n == 0)
+    return 0;
+
+  return w->maxv[w->max_head];
+}
+
+/* the f-quantile of the window, interpolated between the order
+   statistics as in gsl_stats_quantile_from_sorted_data */
+
+double
+FUNCTION (gsl_stats, window_quantile) (const WINDOW_T * w)
+{
+  double index, delta;
+
+  if (w->n == 0)
+    return 0.0;
+
+  index = w->f * (w->n - 1);
+  delta = index - (size_t) index;
+
+  if (w->nhi == 0)
+    return w->x[w->lo[0]];
+
+  return (1 - delta) * w->x[w->lo[0]] + delta * w->x[w->hi[0]];
+}
+
+/* batch versions, with result[i] the statistic of the window
+   data[i - window + 1], ..., data[i], shortened at the start */
+
+static int
+FUNCTION (my, moving_moments) (const BASE data[], const size_t stride,
+                               const size_t n, const size_t window,
+                               double mean[], double variance[])
+{
+  double m = 0.0, M2 = 0.0;
+  size_t i;
+
+  if (window == 0)
+    {
+      GSL_ERROR ("window size must be positive", GSL_EINVAL);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      const double x = data[i * stride];
+
+      if (i < window)
+        FUNCTION (my, moments_add) (&m, &M2, i + 1, x);
+      else if ((i + 1) % window == 0)
+        FUNCTION (my, moments_exact) (&m, &M2, data + (i + 1 - window) * stride, stride, window);
+      else
+        FUNCTION (my, moments_replace) (&m, &M2, window, x, data[(i - window) * stride]);
+
+      if (mean)
+        mean[i] = m;
+
+      if (variance)
+        variance[i] = FUNCTION (my, moments_variance) (M2, (i < window) ? i + 1 : window);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION (gsl_stats, moving_mean) (const BASE data[], const size_t stride,
+                                   const size_t n, const size_t window,
+                                   double mean[])
+{
+  return FUNCTION (my, moving_moments) (data, stride, n, window, mean, NULL);
+}
+
+int
+FUNCTION (gsl_stats, moving_variance) (const BASE data[], const size_t stride,
+                                       const size_t n, const size_t window,
+                                       double variance[])
+{
+  return FUNCTION (my, moving_moments) (data, stride, n, window, NULL, variance);
+}
+
+int
+FUNCTION (gsl_stats, moving_minmax) (const BASE data[], const size_t stride,
+                                     const size_t n, const size_t window,
+                                     BASE min[], BASE max[])
+{
+  const size_t cap = (window < n) ? window : n;
+  size_t *q, min_head = 0, min_len = 0, max_head = 0, max_len = 0;
+  BASE *qv;
+  size_t i;
+
+  if (window == 0)
+    {
+      GSL_ERROR ("window size must be positive", GSL_EINVAL);
+    }
+
+  if (n == 0)
+    return GSL_SUCCESS;
+
+  q = (size_t *) malloc (2 * cap * sizeof (size_t));
+  qv = (BASE *) malloc (2 * cap * sizeof (BASE));
+
+  if (q == 0 || qv == 0)
+    {
+      free (q);
+      free (qv);
+      GSL_ERROR ("failed to allocate space for deques", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      const BASE x = data[i * stride];
+
+      if (min)
+        {
+          FUNCTION (my, deque_push) (q, qv, &min_head, &min_len, cap, x, i, -1);
+          min[i] = qv[min_head];
+        }
+
+      if (max)
+        {
+          FUNCTION (my, deque_push) (q + cap, qv + cap, &max_head, &max_len,
+                                     cap, x, i, 1);
+          max[i] = qv[cap + max_head];
+        }
+    }
+
+  free (q);
+  free (qv);
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION (gsl_stats, moving_quantile) (const BASE data[], const size_t stride,
+                                       const size_t n, const size_t window,
+                                       const double f, double q[])
+{
+  WINDOW_T *w;
+  size_t i;
+
+  if (window == 0)
+    {
+      GSL_ERROR ("window size must be positive", GSL_EINVAL);
+    }
+
+  if (!(f >= 0.0 && f <= 1.0))
+    {
+      GSL_ERROR ("f must lie in [0,1]", GSL_EDOM);
+    }
+
+  if (n == 0)
+    return GSL_SUCCESS;
+
+  w = FUNCTION (gsl_stats, window_alloc) ((window < n) ? window : n, f);
+
+  if (w == 0)
+    {
+      GSL_ERROR ("failed to allocate window", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      FUNCTION (gsl_stats, window_push) (data[i * stride], w);
+      q[i] = FUNCTION (gsl_stats, window_quantile) (w);
+    }
+
+  FUNCTION (gsl_stats, window_free) (w);
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION (gsl_stats, moving_median) (const BASE data[], const size_t stride,
+                                     const size_t n, const size_t window,
+                                     double median[])
+{
+  return FUNCTION (gsl_stats, moving_quantile) (data, stride, n, window, 0.5, median);
+}
+
+#undef WINDOW_T